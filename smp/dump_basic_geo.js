@@ -10,6 +10,12 @@ function json_to_hgeo(json) {
 	let numPoints = json.npnt;
 	let numPolygons = json.npol;
 	let numTriangles = json.ntri;
+	/* ntri counts triangles after triangulation, ntriPrims counts triangle primitives;
+	   polygons come from triIdx only when pols[] is empty (all-triangle mesh or -sections without pols) */
+	let allTris = json.pols.length == 0;
+	if (allTris) {
+		numPolygons = numTriangles;
+	}
 	console.log("NPoints " + numPoints + " NPrims " + numPolygons);
 	console.log("NPointGroups " + 0 + " NPrimGroups " + 0);
 	console.log("NPointAttrib " + 0 + " NVertexAttrib " + 0 + " NPrimAttrib " + 0 + " NAttrib " + 0);
@@ -25,7 +31,7 @@ function json_to_hgeo(json) {
 
 	if (numPolygons > 0) {
 		console.log("Run " + numPolygons + " Poly");
-		if (numPolygons == numTriangles) {
+		if (allTris) {
 			/*
 				triangulated geo
 				to save space all triangles are stores in json.triIdx[] 
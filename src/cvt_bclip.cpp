@@ -2,17 +2,16 @@
 #include "hbin.h"
 #include "hbin2json.hpp"
 
-void write_bclip_json(HBIN_BCLIP bclip, FILE* pOut) {
-	if (!bclipValid(bclip)) return;
+void write_bclip_json(const HBIN_CLIP* pClip, FILE* pOut) {
+	if (!pClip || !pClip->pTracks) return;
 	if (pOut == nullptr) pOut = stdout;
-	float fps = bclipSampleRate(bclip);
-	int32_t start = bclipStartIndex(bclip);
-	int32_t frames = bclipTrackLength(bclip);
-	int32_t tracks = bclipNumTracks(bclip);
+	float fps = (float)pClip->rate;
+	int32_t start = (int32_t)pClip->start;
+	int32_t frames = pClip->nsmp;
+	int32_t tracks = pClip->ntrk;
 	int nsmps = tracks * frames;
-	float* pSmps = (float*)nxCore::mem_alloc(nsmps * sizeof(float), "bclip:samples");
-	HBIN_STRING* pNames = (HBIN_STRING*)nxCore::mem_alloc(tracks * sizeof(HBIN_STRING), "bclip:names");
-	if (!(pSmps && pNames)) {
+	float* pSmps = (float*)nxCore::mem_alloc(nxCalc::max(nsmps, 1) * sizeof(float), "bclip:samples");
+	if (!pSmps) {
 		return;
 	}
 	bool smpU8 = false;
@@ -22,7 +21,9 @@ void write_bclip_json(HBIN_BCLIP bclip, FILE* pOut) {
 			smpU8 = true;
 		}
 	}
-	bclipAllTracks(bclip, pSmps, pNames);
+	for (int i = 0; i < tracks; ++i) {
+		bclipReadTrack(pClip, i, pSmps + (i * frames));
+	}
 	::fprintf(pOut, "{\n");
 	::fprintf(pOut, "  \"dataType\" : \"clip\",\n");
 	::fprintf(pOut, "  \"fps\" : %f,\n", fps);
@@ -33,7 +34,7 @@ void write_bclip_json(HBIN_BCLIP bclip, FILE* pOut) {
 		::fprintf(pOut, "  \"names\" : [");
 		for (int i = 0; i < tracks; ++i) {
 			::fprintf(pOut, "\"");
-			hbin_str_out(pOut, pNames[i]);
+			hbin_str_out(pOut, pClip->pTracks[i].name);
 			::fprintf(pOut, "\"");
 			if (i < tracks - 1) {
 				::fprintf(pOut, ", ");
@@ -63,6 +64,7 @@ void write_bclip_json(HBIN_BCLIP bclip, FILE* pOut) {
 	::fprintf(pOut, "],\n");
 	::fprintf(pOut, "  \"_EOF_\" : true\n");
 	::fprintf(pOut, "}\n");
+	nxCore::mem_free(pSmps);
 }
 
 
@@ -73,17 +75,36 @@ void cvt_bclip(const char* pBclipPath, const char* pOutPath) {
 	if (!pBin) {
 		return;
 	}
+	if (nxApp::get_bool_opt("normalize", true)) {
+		bclipNormalize(pBin, bclipSize);
+	}
+	/* header first for the track count, then the track directory */
+	HBIN_CLIP clip;
+	HBIN_CLIP_TRACK* pTracks = nullptr;
+	bool opened = bclipOpen(&clip, pBin, bclipSize, nullptr) != 0;
+	if (opened) {
+		pTracks = (HBIN_CLIP_TRACK*)nxCore::mem_alloc(nxCalc::max(clip.ntrk, 1) * sizeof(HBIN_CLIP_TRACK), "bclip:tracks");
+		opened = pTracks && bclipOpen(&clip, pBin, bclipSize, pTracks);
+	}
+	if (!opened) {
+		nxCore::dbg_msg("%s: invalid or truncated bclip\n", pBclipPath);
+		nxCore::mem_free(pTracks);
+		nxCore::bin_unload(pBin);
+		return;
+	}
 	FILE* pOut = nullptr;
 	if (pOutPath) {
 		pOut = nxSys::fopen_w_txt(pOutPath);
 		if (!pOut) {
+			nxCore::mem_free(pTracks);
 			return;
 		}
 	}
-	write_bclip_json((HBIN_BCLIP)pBin, pOut);
+	write_bclip_json(&clip, pOut);
 	if (pOutPath) {
 		::fclose(pOut);
 	}
+	nxCore::mem_free(pTracks);
 }
 
 
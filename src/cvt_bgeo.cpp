@@ -1,145 +1,1204 @@
 #include "crosscore.hpp"
-#include "hbin.h"
+#include "hbin.hpp"
 #include "hbin2json.hpp"
 
-struct BgeoContext {
-	HBIN_BGEO bgeo;
-	size_t aryCnt;
-	int num;
-	FILE* pOut;
+struct BgeoTris {
+	int ntri;
+	uint32_t* pIdx;
+	int32_t* pMtlIds;
+
+	void clear() {
+		ntri = 0;
+		pIdx = nullptr;
+		pMtlIds = nullptr;
+	}
+
+	void init(HBIN_BGEO bgeo, bool triangulate, const uint32_t* pPrimSel = nullptr) {
+		clear();
+		ntri = triangulate ? bgeoCountPolyTrianglesInGroup(bgeo, pPrimSel) : bgeoCountTrianglesInGroup(bgeo, pPrimSel);
+		if (ntri > 0) {
+			pIdx = (uint32_t*)nxCore::mem_alloc(ntri * 3 * sizeof(uint32_t), "bgeo:triIdx");
+			pMtlIds = (int32_t*)nxCore::mem_alloc(ntri * sizeof(int32_t), "bgeo:triMtlIds");
+			int wkSize = triangulate ? bgeoPolyTrianglesWorkSize(bgeo) : 0;
+			int32_t* pWk = wkSize > 0 ? (int32_t*)nxCore::mem_alloc(wkSize * sizeof(int32_t), "bgeo:earClipWk") : nullptr;
+			if (pIdx && pMtlIds && (pWk || wkSize <= 0)) {
+				if (triangulate) {
+					bgeoGetPolyTrianglesInGroup(bgeo, pPrimSel, nullptr, pIdx, pMtlIds, pWk);
+				} else {
+					bgeoGetTrianglesInGroup(bgeo, pPrimSel, nullptr, pIdx, pMtlIds);
+				}
+			} else {
+				reset();
+			}
+			nxCore::mem_free(pWk);
+		}
+	}
+
+	bool optimize(HBIN_BGEO bgeo, int cacheSize, float overdraw, HBIN_VCACHE_STATS* pStatsIn, HBIN_VCACHE_STATS* pStatsOut) {
+		bool res = false;
+		int npnt = bgeoNumPoints(bgeo);
+		if (ntri <= 0 || npnt <= 0) return res;
+		int wkSize = nxCalc::max(hbinVertexCacheWorkSize(ntri, npnt), hbinOverdrawWorkSize(ntri, npnt));
+		int32_t* pWk = (int32_t*)nxCore::mem_alloc(wkSize * sizeof(int32_t), "bgeo:vcacheWk");
+		int32_t* pOrder = (int32_t*)nxCore::mem_alloc(ntri * sizeof(int32_t), "bgeo:triOrder");
+		int32_t* pClusters = (int32_t*)nxCore::mem_alloc((ntri + 1) * sizeof(int32_t), "bgeo:triClusters");
+		uint32_t* pNewIdx = (uint32_t*)nxCore::mem_alloc(ntri * 3 * sizeof(uint32_t), "bgeo:triIdx");
+		int32_t* pNewMtlIds = (int32_t*)nxCore::mem_alloc(ntri * sizeof(int32_t), "bgeo:triMtlIds");
+		HBIN_FLOAT3* pPos = overdraw > 0.0f ? (HBIN_FLOAT3*)nxCore::mem_alloc(npnt * sizeof(HBIN_FLOAT3), "bgeo:pos") : nullptr;
+		if (pWk && pOrder && pClusters && pNewIdx && pNewMtlIds && (pPos || overdraw <= 0.0f)) {
+			if (pStatsIn) {
+				*pStatsIn = hbinVertexCacheStats(pIdx, ntri, npnt, cacheSize, pWk);
+			}
+			int nclusters = hbinOptimizeVertexCache(pOrder, pClusters, pIdx, ntri, npnt, cacheSize, pWk);
+			if (nclusters > 0) {
+				if (pPos) {
+					bgeoGetPointPositions(bgeo, pPos);
+					hbinOptimizeOverdraw(pOrder, pClusters, nclusters, pIdx, ntri, pPos, npnt, cacheSize, overdraw, pWk);
+				}
+				hbinReorderTriangles(pNewIdx, pIdx, pOrder, ntri);
+				for (int i = 0; i < ntri; ++i) {
+					pNewMtlIds[i] = pMtlIds[pOrder[i]];
+				}
+				nxCore::mem_free(pIdx);
+				nxCore::mem_free(pMtlIds);
+				pIdx = pNewIdx;
+				pMtlIds = pNewMtlIds;
+				pNewIdx = nullptr;
+				pNewMtlIds = nullptr;
+				res = true;
+			}
+			if (pStatsOut) {
+				*pStatsOut = hbinVertexCacheStats(pIdx, ntri, npnt, cacheSize, pWk);
+			}
+		}
+		nxCore::mem_free(pPos);
+		nxCore::mem_free(pNewMtlIds);
+		nxCore::mem_free(pNewIdx);
+		nxCore::mem_free(pClusters);
+		nxCore::mem_free(pOrder);
+		nxCore::mem_free(pWk);
+		return res;
+	}
+
+	/* pRanges: [nmtl + 1] */
+	bool sort_by_material(int nmtl, HBIN_MTL_RANGE* pRanges) {
+		bool res = false;
+		if (ntri <= 0 || !pRanges) return res;
+		int32_t* pWk = (int32_t*)nxCore::mem_alloc((nmtl + 1) * sizeof(int32_t), "bgeo:mtlSortWk");
+		uint32_t* pNewIdx = (uint32_t*)nxCore::mem_alloc(ntri * 3 * sizeof(uint32_t), "bgeo:triIdx");
+		int32_t* pNewMtlIds = (int32_t*)nxCore::mem_alloc(ntri * sizeof(int32_t), "bgeo:triMtlIds");
+		if (pWk && pNewIdx && pNewMtlIds) {
+			hbinSortTrianglesByMaterial(pNewIdx, pNewMtlIds, pRanges, pIdx, pMtlIds, ntri, nmtl, pWk);
+			nxCore::mem_free(pIdx);
+			nxCore::mem_free(pMtlIds);
+			pIdx = pNewIdx;
+			pMtlIds = pNewMtlIds;
+			pNewIdx = nullptr;
+			pNewMtlIds = nullptr;
+			res = true;
+		}
+		nxCore::mem_free(pNewMtlIds);
+		nxCore::mem_free(pNewIdx);
+		nxCore::mem_free(pWk);
+		return res;
+	}
+
+	void reset() {
+		nxCore::mem_free(pMtlIds);
+		nxCore::mem_free(pIdx);
+		pMtlIds = nullptr;
+		pIdx = nullptr;
+		ntri = 0;
+	}
+};
+
+/* -cleanup[:tol] welds points within tol that have identical attributes, then drops degenerate (-cleanarea:<min area>) and duplicate triangles */
+struct BgeoCleanup {
+	int32_t* pWeld; /* source point -> welded source point */
+	int nwelded;
+	float tol;
+	HBIN_TRI_CLEANUP stats;
+
+	void init() {
+		pWeld = nullptr;
+		nwelded = 0;
+		tol = 0.0f;
+		stats.degenerate = 0;
+		stats.duplicate = 0;
+	}
+
+	bool exec(HBIN_BGEO bgeo, BgeoTris& tris, float weldTol, float minArea) {
+		bool res = false;
+		int npnt = bgeoNumPoints(bgeo);
+		if (tris.ntri <= 0 || npnt <= 0) return res;
+		tol = weldTol;
+		HBIN_ATTR_DATA pntData;
+		bgeoPointAttrData(bgeo, "P", &pntData);
+		int wkSize = nxCalc::max(hbinWeldPositionsWorkSize(npnt), hbinCleanTrianglesWorkSize(tris.ntri));
+		int32_t* pWk = (int32_t*)nxCore::mem_alloc(wkSize * sizeof(int32_t), "bgeo:cleanWk");
+		HBIN_FLOAT3* pPos = (HBIN_FLOAT3*)nxCore::mem_alloc(npnt * sizeof(HBIN_FLOAT3), "bgeo:cleanPos");
+		pWeld = (int32_t*)nxCore::mem_alloc(npnt * sizeof(int32_t), "bgeo:cleanWeld");
+		if (pWk && pPos && pWeld && pntData.pRecs) {
+			bgeoGetPointPositions(bgeo, pPos);
+			/* attributes follow the 4 position floats of each point record; compared as stored */
+			const uint8_t* pAttrs = pntData.pRecs + (4 * 4);
+			int attrSize = pntData.stride - (4 * 4);
+			nwelded = hbinWeldPositions(pWeld, pPos, npnt, tol, attrSize > 0 ? pAttrs : nullptr, pntData.stride, attrSize, pWk);
+			tris.ntri = hbinCleanTriangles(tris.pIdx, tris.pMtlIds, tris.ntri, pWeld, pPos, minArea, &stats, pWk);
+			nxCore::dbg_msg("cleanup: %d points welded, %d degenerate and %d duplicate triangles removed\n", nwelded, stats.degenerate, stats.duplicate);
+			res = true;
+		} else {
+			nxCore::mem_free(pWeld);
+			pWeld = nullptr;
+		}
+		nxCore::mem_free(pPos);
+		nxCore::mem_free(pWk);
+		return res;
+	}
+
+	void reset() {
+		nxCore::mem_free(pWeld);
+		pWeld = nullptr;
+	}
+};
+
+struct BgeoPntMap {
+	int npnt;
+	int nsrc;
+	int32_t* pRemap; /* source -> output, -1 for dropped points */
+	int32_t* pSrcIds; /* output -> source */
+	const int32_t* pWeld; /* source -> welded source, see BgeoCleanup */
+
+	void init(HBIN_BGEO bgeo) {
+		npnt = bgeoNumPoints(bgeo);
+		nsrc = npnt;
+		pRemap = nullptr;
+		pSrcIds = nullptr;
+		pWeld = nullptr;
+	}
+
+	static int add_pol_pnts_cb(const HBIN_PRIM prim, void* pMem) {
+		BgeoPntMap* pMap = (BgeoPntMap*)pMem;
+		if (bgeoPrimIsPoly(prim)) {
+			int32_t nvtx = bgeoPrimNumVertices(prim);
+			for (int32_t i = 0; i < nvtx; ++i) {
+				int32_t pid = pMap->weld(bgeoPrimVertexPntId(prim, i));
+				if ((uint32_t)pid < (uint32_t)pMap->nsrc && pMap->pRemap[pid] < 0) {
+					pMap->pRemap[pid] = pMap->npnt++;
+				}
+			}
+		}
+		return 1;
+	}
+
+	bool compact(HBIN_BGEO bgeo, const BgeoTris& tris, const uint32_t* pPrimSel = nullptr) {
+		nsrc = bgeoNumPoints(bgeo);
+		if (nsrc <= 0) return false;
+		pRemap = (int32_t*)nxCore::mem_alloc(nsrc * sizeof(int32_t), "bgeo:pntRemap");
+		pSrcIds = (int32_t*)nxCore::mem_alloc(nsrc * sizeof(int32_t), "bgeo:pntSrcIds");
+		if (!pRemap || !pSrcIds) {
+			reset();
+			npnt = nsrc;
+			return false;
+		}
+		npnt = hbinVertexFetchRemap(pRemap, tris.pIdx, tris.ntri * 3, nsrc);
+		/* keep points of polygons that didn't make it into the triangle list */
+		bgeoForEachPrimInGroup(bgeo, pPrimSel, add_pol_pnts_cb, this);
+		for (int i = 0; i < nsrc; ++i) {
+			if (pRemap[i] >= 0) {
+				pSrcIds[pRemap[i]] = i;
+			}
+		}
+		return true;
+	}
+
+	int src(int i) const { return pSrcIds ? pSrcIds[i] : i; }
+	/* out-of-range ids map to themselves / -1 */
+	int weld(int pid) const { return pWeld && (uint32_t)pid < (uint32_t)nsrc ? pWeld[pid] : pid; }
+	int dst(int pid) const {
+		int wid = weld(pid);
+		if (!pRemap) return wid;
+		return (uint32_t)wid < (uint32_t)nsrc ? pRemap[wid] : -1;
+	}
+
+	void reset() {
+		nxCore::mem_free(pSrcIds);
+		nxCore::mem_free(pRemap);
+		pSrcIds = nullptr;
+		pRemap = nullptr;
+	}
 };
 
 
-static int countPolVtxCB(const HBIN_PRIM prim, void* pCtxMem) {
-	BgeoContext* pCtx = (BgeoContext*)pCtxMem;
-	if (!pCtx) return 0;
-	if (!pCtx->pOut) return 0;
-	if (bgeoPrimIsPoly(prim)) {
-		pCtx->num += bgeoPrimNumVertices(prim);
+static void int_ary_out(FILE* pOut, const char* pName, const int32_t* pVals, size_t n) {
+	::fprintf(pOut, "  \"%s\" : [", pName);
+	for (size_t i = 0; i < n; ++i) {
+		::fprintf(pOut, "%d", pVals[i]);
+		if (i < n - 1) {
+			::fprintf(pOut, ", ");
+		}
 	}
-	return 1;
+	::fprintf(pOut, "],\n");
 }
 
-static int triIdxPrimCB(const HBIN_PRIM prim, void* pCtxMem) {
-	BgeoContext* pCtx = (BgeoContext*)pCtxMem;
-	if (!pCtx) return 0;
-	if (!pCtx->pOut) return 0;
-	if (bgeoPrimIsPoly(prim)) {
-		int32_t nvtx = bgeoPrimNumVertices(prim);
-		if (nvtx == 3) {
-			for (int j = 0; j < 3; ++j) {
-				int32_t pid = bgeoPrimVertexPntId(prim, j);
-				::fprintf(pCtx->pOut, "%d", pid);
-				if (j < 2) {
-					::fprintf(pCtx->pOut, ", ");
+static void flt_ary_out(FILE* pOut, const char* pName, const float* pVals, size_t n) {
+	::fprintf(pOut, "  \"%s\" : [", pName);
+	for (size_t i = 0; i < n; ++i) {
+		::fprintf(pOut, "%f", pVals[i]);
+		if (i < n - 1) {
+			::fprintf(pOut, ", ");
+		}
+	}
+	::fprintf(pOut, "],\n");
+}
+
+static void write_skin_batches(HBIN_BGEO bgeo, FILE* pOut, const BgeoTris& tris, const BgeoPntMap& pntMap, int palSize) {
+	int ntri = tris.ntri;
+	int maxCapts = bgeoMaxCapturesPerPoint(bgeo);
+	if (ntri <= 0 || maxCapts <= 0 || palSize <= 0) return;
+	const uint32_t* pTriIdx = tris.pIdx;
+	int32_t* pWk = (int32_t*)nxCore::mem_alloc(bgeoSkinBatchesWorkSize(bgeo) * sizeof(int32_t), "bgeo:skinWk");
+	uint32_t* pBatchIdx = (uint32_t*)nxCore::mem_alloc(ntri * 3 * sizeof(uint32_t), "bgeo:skinIdx");
+	if (pWk && pBatchIdx) {
+		int nbatch = bgeoSkinBatches(bgeo, pTriIdx, ntri, palSize, maxCapts, nullptr, nullptr, nullptr, nullptr, nullptr, pWk);
+		if (nbatch > 0) {
+			HBIN_SKIN_BATCH* pBatches = (HBIN_SKIN_BATCH*)nxCore::mem_alloc(nbatch * sizeof(HBIN_SKIN_BATCH), "bgeo:skinBatches");
+			if (pBatches) {
+				bgeoSkinBatches(bgeo, pTriIdx, ntri, palSize, maxCapts, pBatches, nullptr, nullptr, nullptr, nullptr, pWk);
+				HBIN_SKIN_BATCH* pLast = &pBatches[nbatch - 1];
+				int nvtx = pLast->vtxOrg + pLast->vtxCount;
+				int npal = pLast->palOrg + pLast->palCount;
+				int32_t* pBatchPnts = (int32_t*)nxCore::mem_alloc(nvtx * sizeof(int32_t), "bgeo:skinPnts");
+				int32_t* pPalNodes = (int32_t*)nxCore::mem_alloc(npal * sizeof(int32_t), "bgeo:skinPals");
+				int32_t* pLocNodes = (int32_t*)nxCore::mem_alloc(nvtx * maxCapts * sizeof(int32_t), "bgeo:skinNodes");
+				if (pBatchPnts && pPalNodes && pLocNodes) {
+					bgeoSkinBatches(bgeo, pTriIdx, ntri, palSize, maxCapts, pBatches, pBatchIdx, pBatchPnts, pPalNodes, pLocNodes, pWk);
+					for (int i = 0; i < nvtx; ++i) {
+						pBatchPnts[i] = pntMap.dst(pBatchPnts[i]);
+					}
+					::fprintf(pOut, "  \"skinPalSize\" : %d,\n", palSize);
+					::fprintf(pOut, "  \"nskinBatches\" : %d,\n", nbatch);
+					int_ary_out(pOut, "skinBatches", (const int32_t*)pBatches, nbatch * 6);
+					int_ary_out(pOut, "skinBatchIdx", (const int32_t*)pBatchIdx, ntri * 3);
+					int_ary_out(pOut, "skinBatchPnts", pBatchPnts, nvtx);
+					int_ary_out(pOut, "skinBatchPals", pPalNodes, npal);
+					int_ary_out(pOut, "skinBatchCaptNodes", pLocNodes, nvtx * maxCapts);
 				}
+				nxCore::mem_free(pLocNodes);
+				nxCore::mem_free(pPalNodes);
+				nxCore::mem_free(pBatchPnts);
+				nxCore::mem_free(pBatches);
 			}
-			--pCtx->aryCnt;
-			if (pCtx->aryCnt > 0) {
-				::fprintf(pCtx->pOut, ", ");
+		} else if (nbatch < 0) {
+			nxCore::dbg_msg("skin batches: palette size %d is too small\n", palSize);
+		}
+	}
+	nxCore::mem_free(pBatchIdx);
+	nxCore::mem_free(pWk);
+}
+
+static void write_idx16_chunks(HBIN_BGEO bgeo, FILE* pOut, const BgeoTris& tris, const BgeoPntMap& pntMap, int maxVtx) {
+	int npnt = bgeoNumPoints(bgeo);
+	int ntri = tris.ntri;
+	if (ntri <= 0 || npnt <= 0) return;
+	const uint32_t* pTriIdx = tris.pIdx;
+	int32_t* pWk = (int32_t*)nxCore::mem_alloc(npnt * 2 * sizeof(int32_t), "bgeo:chunkWk");
+	uint16_t* pChunkIdx = (uint16_t*)nxCore::mem_alloc(ntri * 3 * sizeof(uint16_t), "bgeo:chunkIdx");
+	if (pWk && pChunkIdx) {
+		int nchunk = hbinSplitIndices16(pTriIdx, ntri, npnt, maxVtx, nullptr, nullptr, nullptr, pWk);
+		HBIN_MESH_CHUNK* pChunks = nchunk > 0 ? (HBIN_MESH_CHUNK*)nxCore::mem_alloc(nchunk * sizeof(HBIN_MESH_CHUNK), "bgeo:chunks") : nullptr;
+		if (pChunks) {
+			hbinSplitIndices16(pTriIdx, ntri, npnt, maxVtx, pChunks, nullptr, nullptr, pWk);
+			int nvtx = pChunks[nchunk - 1].vtxOrg + pChunks[nchunk - 1].vtxCount;
+			int32_t* pChunkVtx = (int32_t*)nxCore::mem_alloc(nvtx * sizeof(int32_t), "bgeo:chunkVtx");
+			if (pChunkVtx) {
+				hbinSplitIndices16(pTriIdx, ntri, npnt, maxVtx, pChunks, pChunkIdx, pChunkVtx, pWk);
+				for (int i = 0; i < nvtx; ++i) {
+					pChunkVtx[i] = pntMap.dst(pChunkVtx[i]);
+				}
+				::fprintf(pOut, "  \"nidx16Chunks\" : %d,\n", nchunk);
+				int_ary_out(pOut, "idx16Chunks", (const int32_t*)pChunks, nchunk * 4);
+				::fprintf(pOut, "  \"idx16ChunkIdx\" : [");
+				for (int i = 0; i < ntri * 3; ++i) {
+					::fprintf(pOut, "%d", pChunkIdx[i]);
+					if (i < ntri * 3 - 1) {
+						::fprintf(pOut, ", ");
+					}
+				}
+				::fprintf(pOut, "],\n");
+				int_ary_out(pOut, "idx16ChunkPnts", pChunkVtx, nvtx);
 			}
+			nxCore::mem_free(pChunkVtx);
+			nxCore::mem_free(pChunks);
 		}
 	}
-	return 1;
+	nxCore::mem_free(pChunkIdx);
+	nxCore::mem_free(pWk);
 }
 
-static int polIdxPrimCB(const HBIN_PRIM prim, void* pCtxMem) {
-	BgeoContext* pCtx = (BgeoContext*)pCtxMem;
-	if (!pCtx) return 0;
-	if (!pCtx->pOut) return 0;
-	if (bgeoPrimIsPoly(prim)) {
-		int32_t nvtx = bgeoPrimNumVertices(prim);
-		for (int32_t j = 0; j < nvtx; ++j) {
-			int32_t pid = bgeoPrimVertexPntId(prim, j);
-			::fprintf(pCtx->pOut, "%d", pid);
-			if (j < nvtx - 1) {
-				::fprintf(pCtx->pOut, ", ");
+static void write_meshlets(HBIN_BGEO bgeo, FILE* pOut, const BgeoTris& tris, const BgeoPntMap& pntMap, int maxVtx, int maxTris) {
+	int npnt = bgeoNumPoints(bgeo);
+	int ntri = tris.ntri;
+	if (ntri <= 0 || npnt <= 0) return;
+	const uint32_t* pTriIdx = tris.pIdx;
+	int32_t* pWk = (int32_t*)nxCore::mem_alloc(npnt * 2 * sizeof(int32_t), "bgeo:meshletWk");
+	uint32_t* pMeshletVtx = (uint32_t*)nxCore::mem_alloc(ntri * 3 * sizeof(uint32_t), "bgeo:meshletVtx");
+	uint8_t* pMeshletTris = (uint8_t*)nxCore::mem_alloc(ntri * 3, "bgeo:meshletTris");
+	HBIN_FLOAT3* pPos = (HBIN_FLOAT3*)nxCore::mem_alloc(npnt * sizeof(HBIN_FLOAT3), "bgeo:meshletPos");
+	if (pWk && pMeshletVtx && pMeshletTris && pPos) {
+		int nmeshlet = hbinBuildMeshlets(nullptr, nullptr, nullptr, pTriIdx, ntri, npnt, maxVtx, maxTris, pWk);
+		HBIN_MESHLET* pMeshlets = nmeshlet > 0 ? (HBIN_MESHLET*)nxCore::mem_alloc(nmeshlet * sizeof(HBIN_MESHLET), "bgeo:meshlets") : nullptr;
+		float* pBounds = nmeshlet > 0 ? (float*)nxCore::mem_alloc(nmeshlet * 11 * sizeof(float), "bgeo:meshletBounds") : nullptr;
+		if (pMeshlets && pBounds) {
+			hbinBuildMeshlets(pMeshlets, pMeshletVtx, pMeshletTris, pTriIdx, ntri, npnt, maxVtx, maxTris, pWk);
+			bgeoGetPointPositions(bgeo, pPos);
+			for (int i = 0; i < nmeshlet; ++i) {
+				HBIN_MESHLET_BOUNDS bounds = hbinMeshletBounds(&pMeshlets[i], pMeshletVtx, pMeshletTris, pPos, npnt);
+				float* pDst = &pBounds[i * 11];
+				for (int j = 0; j < 3; ++j) {
+					pDst[j] = bounds.center[j];
+					pDst[4 + j] = bounds.coneApex[j];
+					pDst[7 + j] = bounds.coneAxis[j];
+				}
+				pDst[3] = bounds.radius;
+				pDst[10] = bounds.coneCutoff;
+			}
+			int nvtx = pMeshlets[nmeshlet - 1].vtxOrg + pMeshlets[nmeshlet - 1].vtxCount;
+			for (int i = 0; i < nvtx; ++i) {
+				pMeshletVtx[i] = (uint32_t)pntMap.dst((int)pMeshletVtx[i]);
+			}
+			::fprintf(pOut, "  \"meshletMaxVtx\" : %d,\n", maxVtx);
+			::fprintf(pOut, "  \"meshletMaxTris\" : %d,\n", maxTris);
+			::fprintf(pOut, "  \"nmeshlets\" : %d,\n", nmeshlet);
+			int_ary_out(pOut, "meshlets", (const int32_t*)pMeshlets, nmeshlet * 4);
+			int_ary_out(pOut, "meshletPnts", (const int32_t*)pMeshletVtx, nvtx);
+			::fprintf(pOut, "  \"meshletTris\" : [");
+			for (int i = 0; i < ntri * 3; ++i) {
+				::fprintf(pOut, "%d", pMeshletTris[i]);
+				if (i < ntri * 3 - 1) {
+					::fprintf(pOut, ", ");
+				}
+			}
+			::fprintf(pOut, "],\n");
+			flt_ary_out(pOut, "meshletBounds", pBounds, nmeshlet * 11);
+		}
+		nxCore::mem_free(pBounds);
+		nxCore::mem_free(pMeshlets);
+	}
+	nxCore::mem_free(pPos);
+	nxCore::mem_free(pMeshletTris);
+	nxCore::mem_free(pMeshletVtx);
+	nxCore::mem_free(pWk);
+}
+
+static void write_submeshes(HBIN_BGEO bgeo, FILE* pOut, const BgeoTris& tris, const BgeoPntMap& pntMap, const HBIN_FLOAT3* pGenNrm) {
+	int npnt = bgeoNumPoints(bgeo);
+	int ntri = tris.ntri;
+	if (ntri <= 0 || npnt <= 0) return;
+	int32_t* pWk = (int32_t*)nxCore::mem_alloc(npnt * 2 * sizeof(int32_t), "bgeo:submeshWk");
+	HBIN_FLOAT3* pPos = (HBIN_FLOAT3*)nxCore::mem_alloc(npnt * sizeof(HBIN_FLOAT3), "bgeo:submeshPos");
+	uint32_t* pSubIdx = (uint32_t*)nxCore::mem_alloc(ntri * 3 * sizeof(uint32_t), "bgeo:submeshIdx");
+	int32_t* pSubPnts = (int32_t*)nxCore::mem_alloc(ntri * 3 * sizeof(int32_t), "bgeo:submeshPnts");
+	if (pWk && pPos && pSubIdx && pSubPnts) {
+		bgeoGetPointPositions(bgeo, pPos);
+		int nsub = hbinSplitSubmeshes(tris.pIdx, tris.pMtlIds, ntri, pPos, npnt, nullptr, nullptr, nullptr, pWk);
+		HBIN_SUBMESH* pSubs = nsub > 0 ? (HBIN_SUBMESH*)nxCore::mem_alloc(nsub * sizeof(HBIN_SUBMESH), "bgeo:submeshes") : nullptr;
+		if (pSubs) {
+			hbinSplitSubmeshes(tris.pIdx, tris.pMtlIds, ntri, pPos, npnt, pSubs, pSubIdx, pSubPnts, pWk);
+			int nvtx = pSubs[nsub - 1].vtxOrg + pSubs[nsub - 1].vtxCount;
+			/* interleaved P, N, Cd, uv per submesh vertex, gathered from source points */
+			const int vtxStride = 11;
+			float* pSubVtx = (float*)nxCore::mem_alloc(nvtx * vtxStride * sizeof(float), "bgeo:submeshVtx");
+			if (pSubVtx) {
+				for (int i = 0; i < nsub; ++i) {
+					bgeoGatherVertexBuffer(bgeo, pSubPnts + pSubs[i].vtxOrg, pSubs[i].vtxCount,
+						pSubVtx + (pSubs[i].vtxOrg * vtxStride), vtxStride * sizeof(float),
+						0, 3 * sizeof(float), 6 * sizeof(float), 9 * sizeof(float), -1, -1, 0, pGenNrm);
+				}
+			}
+			for (int i = 0; i < nvtx; ++i) {
+				pSubPnts[i] = pntMap.dst(pSubPnts[i]);
+			}
+			::fprintf(pOut, "  \"nsubmeshes\" : %d,\n", nsub);
+			::fprintf(pOut, "  \"submeshes\" : [");
+			for (int i = 0; i < nsub; ++i) {
+				::fprintf(pOut, "%d, %d, %d, %d, %d", pSubs[i].mtlId, pSubs[i].triOrg, pSubs[i].triCount, pSubs[i].vtxOrg, pSubs[i].vtxCount);
+				if (i < nsub - 1) {
+					::fprintf(pOut, ", ");
+				}
+			}
+			::fprintf(pOut, "],\n");
+			::fprintf(pOut, "  \"submeshBounds\" : [");
+			for (int i = 0; i < nsub; ++i) {
+				const float* pMin = pSubs[i].bboxMin;
+				const float* pMax = pSubs[i].bboxMax;
+				::fprintf(pOut, "%f, %f, %f, %f, %f, %f", pMin[0], pMin[1], pMin[2], pMax[0], pMax[1], pMax[2]);
+				if (i < nsub - 1) {
+					::fprintf(pOut, ", ");
+				}
+			}
+			::fprintf(pOut, "],\n");
+			int_ary_out(pOut, "submeshIdx", (const int32_t*)pSubIdx, ntri * 3);
+			int_ary_out(pOut, "submeshPnts", pSubPnts, nvtx);
+			if (pSubVtx) {
+				::fprintf(pOut, "  \"submeshVtxFormat\" : [\"P\", \"N\", \"Cd\", \"uv\"],\n");
+				::fprintf(pOut, "  \"submeshVtxStride\" : %d,\n", vtxStride);
+				flt_ary_out(pOut, "submeshVtx", pSubVtx, nvtx * vtxStride);
+			}
+			nxCore::mem_free(pSubVtx);
+		}
+		nxCore::mem_free(pSubs);
+	}
+	nxCore::mem_free(pSubPnts);
+	nxCore::mem_free(pSubIdx);
+	nxCore::mem_free(pPos);
+	nxCore::mem_free(pWk);
+}
+
+static void base64_out(FILE* pOut, const char* pName, const uint8_t* pData, size_t size) {
+	static const char* pTbl = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	::fprintf(pOut, "  \"%s\" : \"", pName);
+	for (size_t i = 0; i < size; i += 3) {
+		uint32_t bits = (uint32_t)pData[i] << 16;
+		if (i + 1 < size) bits |= (uint32_t)pData[i + 1] << 8;
+		if (i + 2 < size) bits |= (uint32_t)pData[i + 2];
+		char chr[4];
+		chr[0] = pTbl[(bits >> 18) & 0x3F];
+		chr[1] = pTbl[(bits >> 12) & 0x3F];
+		chr[2] = i + 1 < size ? pTbl[(bits >> 6) & 0x3F] : '=';
+		chr[3] = i + 2 < size ? pTbl[bits & 0x3F] : '=';
+		::fwrite(chr, 1, 4, pOut);
+	}
+	::fprintf(pOut, "\",\n");
+}
+
+static void write_packed(HBIN_BGEO bgeo, FILE* pOut, const BgeoTris& tris, const BgeoPntMap& pntMap) {
+	int npnt = pntMap.npnt;
+	int nidx = tris.ntri * 3;
+	if (nidx <= 0 || npnt <= 0) return;
+	int idxBound = hbinEncodeIndexBound(nidx);
+	int pntBound = hbinEncodeVertexBound(npnt, 3);
+	uint32_t* pIdx = (uint32_t*)nxCore::mem_alloc(nidx * sizeof(uint32_t), "bgeo:packIdxSrc");
+	HBIN_FLOAT3* pPnts = (HBIN_FLOAT3*)nxCore::mem_alloc(npnt * sizeof(HBIN_FLOAT3), "bgeo:packPntsSrc");
+	uint32_t* pIdxChk = (uint32_t*)nxCore::mem_alloc(nidx * sizeof(uint32_t), "bgeo:packIdxChk");
+	HBIN_FLOAT3* pPntsChk = (HBIN_FLOAT3*)nxCore::mem_alloc(npnt * sizeof(HBIN_FLOAT3), "bgeo:packPntsChk");
+	uint8_t* pPackedIdx = (uint8_t*)nxCore::mem_alloc(idxBound, "bgeo:packIdx");
+	uint8_t* pPackedPnts = (uint8_t*)nxCore::mem_alloc(pntBound, "bgeo:packPnts");
+	if (pIdx && pPnts && pIdxChk && pPntsChk && pPackedIdx && pPackedPnts) {
+		for (int i = 0; i < nidx; ++i) {
+			pIdx[i] = (uint32_t)pntMap.dst(tris.pIdx[i]);
+		}
+		for (int i = 0; i < npnt; ++i) {
+			bgeoPointPos(pPnts[i], bgeo, pntMap.src(i));
+		}
+		int idxSize = hbinEncodeIndices(pPackedIdx, idxBound, pIdx, nidx);
+		int pntSize = hbinEncodeVertices(pPackedPnts, pntBound, pPnts, npnt, 3);
+		if (idxSize > 0 && pntSize > 0) {
+			const int nreps = 4;
+			bool ok = true;
+			double t0 = nxSys::time_micros();
+			for (int i = 0; i < nreps; ++i) {
+				ok = ok && hbinDecodeIndices(pIdxChk, nidx, pPackedIdx, idxSize) == idxSize;
+				ok = ok && hbinDecodeVertices(pPntsChk, npnt, 3, pPackedPnts, pntSize) == pntSize;
+			}
+			double t = (nxSys::time_micros() - t0) / nreps;
+			for (int i = 0; ok && i < nidx; ++i) {
+				ok = pIdx[i] == pIdxChk[i];
+			}
+			for (int i = 0; ok && i < npnt; ++i) {
+				for (int j = 0; j < 3; ++j) {
+					ok = ok && pPnts[i][j] == pPntsChk[i][j];
+				}
+			}
+			if (ok) {
+				size_t rawSize = nidx * sizeof(uint32_t) + npnt * sizeof(HBIN_FLOAT3);
+				size_t packedSize = (size_t)(idxSize + pntSize);
+				double ratio = (double)rawSize / (double)packedSize;
+				double mbs = t > 0.0 ? ((double)rawSize / (1024.0 * 1024.0)) / (t * 1.0e-6) : 0.0;
+				nxCore::dbg_msg("packed: %d + %d -> %d + %d bytes (x%.2f), unpack %.1f MB/s\n",
+				                (int)(nidx * sizeof(uint32_t)), (int)(npnt * sizeof(HBIN_FLOAT3)), idxSize, pntSize, ratio, mbs);
+				::fprintf(pOut, "  \"packedIdxSize\" : %d,\n", idxSize);
+				base64_out(pOut, "packedIdx", pPackedIdx, idxSize);
+				::fprintf(pOut, "  \"packedPntsSize\" : %d,\n", pntSize);
+				base64_out(pOut, "packedPnts", pPackedPnts, pntSize);
+				::fprintf(pOut, "  \"packRatio\" : %f,\n", ratio);
+				::fprintf(pOut, "  \"unpackMBs\" : %f,\n", mbs);
+			} else {
+				nxCore::dbg_msg("packed: round trip failed\n");
+			}
+		}
+	}
+	nxCore::mem_free(pPackedPnts);
+	nxCore::mem_free(pPackedIdx);
+	nxCore::mem_free(pPntsChk);
+	nxCore::mem_free(pIdxChk);
+	nxCore::mem_free(pPnts);
+	nxCore::mem_free(pIdx);
+}
+
+static void write_tangents(HBIN_BGEO bgeo, FILE* pOut, const BgeoTris& tris, const BgeoPntMap& pntMap, const HBIN_FLOAT3* pGenNrm) {
+	int npts = bgeoNumPoints(bgeo);
+	if (tris.ntri <= 0 || npts <= 0) return;
+	if (bgeoFindPointAttr(bgeo, "uv") < 0) {
+		/* vertex uv: weldTriTangents with -weld */
+		nxCore::dbg_msg("tangents: no point uv attribute\n");
+		return;
+	}
+	HBIN_FLOAT3* pPos = (HBIN_FLOAT3*)nxCore::mem_alloc(npts * sizeof(HBIN_FLOAT3), "bgeo:tngPos");
+	HBIN_FLOAT3* pNrm = (HBIN_FLOAT3*)nxCore::mem_alloc(npts * sizeof(HBIN_FLOAT3), "bgeo:tngNrm");
+	HBIN_FLOAT2* pUV = (HBIN_FLOAT2*)nxCore::mem_alloc(npts * sizeof(HBIN_FLOAT2), "bgeo:tngUV");
+	float* pTangents = (float*)nxCore::mem_alloc(tris.ntri * 3 * 4 * sizeof(float), "bgeo:tangents");
+	float* pWk = (float*)nxCore::mem_alloc(npts * 12 * sizeof(float), "bgeo:tngWk");
+	if (pPos && pNrm && pUV && pTangents && pWk) {
+		bgeoGetPointPositions(bgeo, pPos);
+		for (int i = 0; i < npts; ++i) {
+			if (pGenNrm) {
+				nxCore::mem_copy(pNrm[i], pGenNrm[i], sizeof(HBIN_FLOAT3));
+			} else {
+				bgeoPointNrm(pNrm[i], bgeo, i);
+			}
+			bgeoPointUV(pUV[i], bgeo, i);
+		}
+		hbinComputeTangents(pTangents, tris.pIdx, tris.ntri, pPos, pNrm, pUV, npts, pWk);
+		/* per triIdx corner */
+		flt_ary_out(pOut, "triTangents", pTangents, (size_t)tris.ntri * 3 * 4);
+	}
+	nxCore::mem_free(pWk);
+	nxCore::mem_free(pTangents);
+	nxCore::mem_free(pUV);
+	nxCore::mem_free(pNrm);
+	nxCore::mem_free(pPos);
+}
+
+struct BgeoPolMask {
+	uint8_t* pMask;
+	const uint32_t* pPrimSel;
+	int n;
+
+	static int prim_cb(const HBIN_PRIM prim, void* pMem) {
+		BgeoPolMask* pPolMask = (BgeoPolMask*)pMem;
+		bool sel = !pPolMask->pPrimSel || HBIN_BIT_TEST(pPolMask->pPrimSel, bgeoPrimId(prim));
+		pPolMask->pMask[pPolMask->n++] = (sel && bgeoPrimIsPoly(prim)) ? 1 : 0;
+		return 1;
+	}
+};
+
+/* polygon primitive attributes, aligned with "pols" and "mtlIds" */
+static void write_prim_attrs(HBIN_BGEO bgeo, FILE* pOut, const uint32_t* pPrimSel) {
+	int nattrs = bgeoNumPrimAttrs(bgeo);
+	int nprim = bgeoNumPrims(bgeo);
+	if (nattrs <= 0 || nprim <= 0) return;
+	int maxSize = 0;
+	for (int i = 0; i < nattrs; ++i) {
+		maxSize = nxCalc::max(maxSize, bgeoPrimAttrSize(bgeo, i));
+	}
+	uint8_t* pPolMask = (uint8_t*)nxCore::mem_alloc(nprim, "bgeo:polMask");
+	float* pFlt = (float*)nxCore::mem_alloc(nprim * maxSize * sizeof(float), "bgeo:primAttrFlt");
+	int32_t* pInt = (int32_t*)nxCore::mem_alloc(nprim * maxSize * sizeof(int32_t), "bgeo:primAttrInt");
+	if (pPolMask && pFlt && pInt) {
+		BgeoPolMask polMask;
+		polMask.pMask = pPolMask;
+		polMask.pPrimSel = pPrimSel;
+		polMask.n = 0;
+		bgeoForEachPrim(bgeo, BgeoPolMask::prim_cb, &polMask);
+		int nread = polMask.n;
+		::fprintf(pOut, "  \"primAttrNames\" : [");
+		for (int i = 0; i < nattrs; ++i) {
+			::fprintf(pOut, "\"");
+			hbin_str_out(pOut, bgeoPrimAttrName(bgeo, i));
+			::fprintf(pOut, "\"%s", i < nattrs - 1 ? ", " : "");
+		}
+		::fprintf(pOut, "],\n");
+		::fprintf(pOut, "  \"primAttrTypes\" : [");
+		for (int i = 0; i < nattrs; ++i) {
+			const char* pType = "unknown";
+			switch (bgeoPrimAttrType(bgeo, i)) {
+				case HBIN_ATTRTYPE_FLOAT: pType = "float"; break;
+				case HBIN_ATTRTYPE_INT: pType = "int"; break;
+				case HBIN_ATTRTYPE_STRING: pType = "string"; break;
+				case HBIN_ATTRTYPE_VECTOR: pType = "vector"; break;
+				default: break;
+			}
+			::fprintf(pOut, "\"%s\"%s", pType, i < nattrs - 1 ? ", " : "");
+		}
+		::fprintf(pOut, "],\n");
+		::fprintf(pOut, "  \"primAttrSizes\" : [");
+		for (int i = 0; i < nattrs; ++i) {
+			::fprintf(pOut, "%d%s", bgeoPrimAttrSize(bgeo, i), i < nattrs - 1 ? ", " : "");
+		}
+		::fprintf(pOut, "],\n");
+		/* [attr][polygon][size]; string attributes as indices into primAttrStrs */
+		::fprintf(pOut, "  \"primAttrData\" : [");
+		bool first = true;
+		for (int i = 0; i < nattrs; ++i) {
+			int size = bgeoPrimAttrSize(bgeo, i);
+			int type = bgeoPrimAttrType(bgeo, i);
+			bool isFlt = type == HBIN_ATTRTYPE_FLOAT || type == HBIN_ATTRTYPE_VECTOR;
+			if (isFlt) {
+				bgeoGetPrimAttrFloats(bgeo, i, pFlt);
+			} else {
+				bgeoGetPrimAttrInts(bgeo, i, pInt);
+			}
+			for (int j = 0; j < nread; ++j) {
+				if (!pPolMask[j]) continue;
+				for (int k = 0; k < size; ++k) {
+					if (!first) {
+						::fprintf(pOut, ", ");
+					}
+					first = false;
+					if (isFlt) {
+						::fprintf(pOut, "%f", pFlt[j * size + k]);
+					} else {
+						::fprintf(pOut, "%d", pInt[j * size + k]);
+					}
+				}
+			}
+		}
+		::fprintf(pOut, "],\n");
+		::fprintf(pOut, "  \"primAttrStrs\" : [");
+		for (int i = 0; i < nattrs; ++i) {
+			int nstrs = bgeoPrimAttrNumStrs(bgeo, i);
+			::fprintf(pOut, "[");
+			for (int j = 0; j < nstrs; ++j) {
+				::fprintf(pOut, "\"");
+				hbin_str_out(pOut, bgeoPrimAttrStr(bgeo, i, j));
+				::fprintf(pOut, "\"%s", j < nstrs - 1 ? ", " : "");
+			}
+			::fprintf(pOut, "]%s", i < nattrs - 1 ? ", " : "");
+		}
+		::fprintf(pOut, "],\n");
+	}
+	nxCore::mem_free(pInt);
+	nxCore::mem_free(pFlt);
+	nxCore::mem_free(pPolMask);
+}
+
+struct BgeoWeldAttrCtx {
+	const int32_t* pCornerVtx;
+	const char* pName;
+	float* pData;
+	int corner;
+	int nvtx;
+
+	static int prim_cb(const HBIN_PRIM prim, void* pMem) {
+		BgeoWeldAttrCtx* pCtx = (BgeoWeldAttrCtx*)pMem;
+		if (bgeoPrimIsPoly(prim)) {
+			int32_t nvtx = bgeoPrimNumVertices(prim);
+			for (int32_t i = 0; i < nvtx; ++i) {
+				if (pCtx->pCornerVtx[pCtx->corner++] == pCtx->nvtx) {
+					bgeoPrimVertexVecAttr(&pCtx->pData[pCtx->nvtx * 3], prim, pCtx->pName, i);
+					++pCtx->nvtx;
+				}
+			}
+		}
+		return 1;
+	}
+};
+
+/* -adjacency: edge counts, boundary loops (as start points) and edge-connected polygon components */
+static void write_adjacency(HBIN_BGEO bgeo, FILE* pOut, const uint32_t* pPrimSel, const BgeoPntMap& pntMap) {
+	int npnt = bgeoNumPoints(bgeo);
+	int npol = bgeoCountPolygonsInGroup(bgeo, pPrimSel);
+	int ncorners = bgeoCountPolyVerticesInGroup(bgeo, pPrimSel);
+	if (npnt <= 0 || npol <= 0 || ncorners <= 0) return;
+	int32_t* pPolOrg = (int32_t*)nxCore::mem_alloc((npol + 1) * sizeof(int32_t), "bgeo:adjPolOrg");
+	int32_t* pPolPnts = (int32_t*)nxCore::mem_alloc(ncorners * sizeof(int32_t), "bgeo:adjPolPnts");
+	int32_t* pTwin = (int32_t*)nxCore::mem_alloc(ncorners * sizeof(int32_t), "bgeo:adjTwin");
+	int32_t* pHEPol = (int32_t*)nxCore::mem_alloc(ncorners * sizeof(int32_t), "bgeo:adjHEPol");
+	int32_t* pLoopOrg = (int32_t*)nxCore::mem_alloc((ncorners + 1) * sizeof(int32_t), "bgeo:adjLoopOrg");
+	int32_t* pLoopHEs = (int32_t*)nxCore::mem_alloc(ncorners * sizeof(int32_t), "bgeo:adjLoopHEs");
+	int32_t* pPolComp = (int32_t*)nxCore::mem_alloc(npol * sizeof(int32_t), "bgeo:adjPolComp");
+	int32_t* pWk = (int32_t*)nxCore::mem_alloc(hbinHalfEdgesWorkSize(ncorners, npnt) * sizeof(int32_t), "bgeo:adjWk");
+	if (pPolOrg && pPolPnts && pTwin && pHEPol && pLoopOrg && pLoopHEs && pPolComp && pWk) {
+		bgeoGetPolygonsCSRInGroup(bgeo, pPrimSel, pPolOrg, pPolPnts, nullptr);
+		int nedges = hbinBuildHalfEdges(pTwin, pHEPol, pPolOrg, pPolPnts, npol, npnt, pWk);
+		if (nedges >= 0) {
+			int nbnd = 0;
+			int nnonManifold = 0;
+			for (int i = 0; i < ncorners; ++i) {
+				int t = pTwin[i];
+				if (t < 0) {
+					++nbnd;
+				} else if (t != i && pTwin[t] != i) {
+					++nnonManifold;
+				}
+			}
+			int nloops = hbinBoundaryLoops(pLoopOrg, pLoopHEs, pPolOrg, pPolPnts, pTwin, pHEPol, npol, npnt, pWk);
+			int ncomp = hbinConnectedComponents(pPolComp, pPolOrg, pTwin, pHEPol, npol, pWk);
+			for (int i = 0; i < nbnd; ++i) {
+				pLoopHEs[i] = pntMap.dst(pPolPnts[pLoopHEs[i]]);
 			}
+			nxCore::dbg_msg("adjacency: %d edges, %d boundary, %d non-manifold half-edges, %d loops, %d components\n", nedges, nbnd, nnonManifold, nloops, ncomp);
+			::fprintf(pOut, "  \"nedges\" : %d,\n", nedges);
+			::fprintf(pOut, "  \"nbndEdges\" : %d,\n", nbnd);
+			::fprintf(pOut, "  \"nnonManifoldHEs\" : %d,\n", nnonManifold);
+			::fprintf(pOut, "  \"nbndLoops\" : %d,\n", nloops);
+			int_ary_out(pOut, "bndLoops", pLoopOrg, nloops + 1);
+			int_ary_out(pOut, "bndLoopPnts", pLoopHEs, nbnd);
+			::fprintf(pOut, "  \"ncomponents\" : %d,\n", ncomp);
+			int_ary_out(pOut, "polComps", pPolComp, npol);
 		}
-		--pCtx->aryCnt;
-		if (pCtx->aryCnt > 0) {
-			::fprintf(pCtx->pOut, ", ");
+	}
+	nxCore::mem_free(pWk);
+	nxCore::mem_free(pPolComp);
+	nxCore::mem_free(pLoopHEs);
+	nxCore::mem_free(pLoopOrg);
+	nxCore::mem_free(pHEPol);
+	nxCore::mem_free(pTwin);
+	nxCore::mem_free(pPolPnts);
+	nxCore::mem_free(pPolOrg);
+}
+
+static void write_welded_tangents(HBIN_BGEO bgeo, FILE* pOut, const int32_t* pCornerVtx, const uint32_t* pIdx, int ntri, int nvtx, const HBIN_FLOAT3* pGenNrm) {
+	if (bgeoFindPointAttr(bgeo, "uv") < 0 && bgeoFindVertexAttr(bgeo, "uv") < 0) {
+		nxCore::dbg_msg("tangents: no uv attribute\n");
+		return;
+	}
+	/* pos, nrm, uv */
+	float* pVB = (float*)nxCore::mem_alloc(nvtx * 8 * sizeof(float), "bgeo:weldTngVB");
+	HBIN_FLOAT3* pPos = (HBIN_FLOAT3*)nxCore::mem_alloc(nvtx * sizeof(HBIN_FLOAT3), "bgeo:weldTngPos");
+	HBIN_FLOAT3* pNrm = (HBIN_FLOAT3*)nxCore::mem_alloc(nvtx * sizeof(HBIN_FLOAT3), "bgeo:weldTngNrm");
+	HBIN_FLOAT2* pUV = (HBIN_FLOAT2*)nxCore::mem_alloc(nvtx * sizeof(HBIN_FLOAT2), "bgeo:weldTngUV");
+	float* pTangents = (float*)nxCore::mem_alloc(ntri * 3 * 4 * sizeof(float), "bgeo:weldTangents");
+	float* pWk = (float*)nxCore::mem_alloc(nvtx * 12 * sizeof(float), "bgeo:weldTngWk");
+	if (pVB && pPos && pNrm && pUV && pTangents && pWk) {
+		bgeoMakeWeldedVertexBuffer(bgeo, pCornerVtx, pVB, 8 * sizeof(float), 0, 3 * sizeof(float), -1, 6 * sizeof(float), -1, -1, 0, pGenNrm);
+		for (int i = 0; i < nvtx; ++i) {
+			const float* pVtx = &pVB[i * 8];
+			nxCore::mem_copy(pPos[i], pVtx, sizeof(HBIN_FLOAT3));
+			nxCore::mem_copy(pNrm[i], pVtx + 3, sizeof(HBIN_FLOAT3));
+			/* undo the vertex buffer's v flip, triTangents use the stored uv as well */
+			pUV[i][0] = pVtx[6];
+			pUV[i][1] = 1.0f - pVtx[7];
 		}
+		hbinComputeTangents(pTangents, pIdx, ntri, pPos, pNrm, pUV, nvtx, pWk);
+		/* per weldTriIdx corner */
+		flt_ary_out(pOut, "weldTriTangents", pTangents, (size_t)ntri * 3 * 4);
 	}
-	return 1;
+	nxCore::mem_free(pWk);
+	nxCore::mem_free(pTangents);
+	nxCore::mem_free(pUV);
+	nxCore::mem_free(pNrm);
+	nxCore::mem_free(pPos);
+	nxCore::mem_free(pVB);
 }
 
-static int polRangePrimCB(const HBIN_PRIM prim, void* pCtxMem) {
-	BgeoContext* pCtx = (BgeoContext*)pCtxMem;
-	if (!pCtx) return 0;
-	if (!pCtx->pOut) return 0;
-	if (bgeoPrimIsPoly(prim)) {
-		int nvtx = bgeoPrimNumVertices(prim);
-		::fprintf(pCtx->pOut, "%d, %d", pCtx->num, nvtx);
-		pCtx->num += nvtx;
-		--pCtx->aryCnt;
-		if (pCtx->aryCnt > 0) {
-			::fprintf(pCtx->pOut, ", ");
+static void write_welded(HBIN_BGEO bgeo, FILE* pOut, const BgeoPntMap& pntMap, bool tangents, const HBIN_FLOAT3* pGenNrm) {
+	int ncorners = bgeoCountPolyVertices(bgeo);
+	int ntri = bgeoCountPolyTriangles(bgeo);
+	if (ncorners <= 0 || ntri <= 0) return;
+	int nvtxAttrs = bgeoNumVertexAttrs(bgeo);
+	int nvecAttrs = 0;
+	for (int i = 0; i < nvtxAttrs; ++i) {
+		if (bgeoVertexAttrIsVec(bgeo, i)) {
+			++nvecAttrs;
+		}
+	}
+	int32_t* pCornerVtx = (int32_t*)nxCore::mem_alloc(ncorners * sizeof(int32_t), "bgeo:weldCorners");
+	int32_t* pVtxPnts = (int32_t*)nxCore::mem_alloc(ncorners * sizeof(int32_t), "bgeo:weldPnts");
+	int32_t* pWk = (int32_t*)nxCore::mem_alloc(bgeoWeldWorkSize(bgeo) * sizeof(int32_t), "bgeo:weldWk");
+	uint32_t* pIdx = (uint32_t*)nxCore::mem_alloc(ntri * 3 * sizeof(uint32_t), "bgeo:weldIdx");
+	float* pData = nvecAttrs > 0 ? (float*)nxCore::mem_alloc(nvecAttrs * ncorners * 3 * sizeof(float), "bgeo:weldData") : nullptr;
+	int earWkSize = bgeoPolyTrianglesWorkSize(bgeo);
+	int32_t* pEarWk = earWkSize > 0 ? (int32_t*)nxCore::mem_alloc(earWkSize * sizeof(int32_t), "bgeo:earClipWk") : nullptr;
+	if (pCornerVtx && pVtxPnts && pWk && pIdx && (pData || nvecAttrs == 0) && (pEarWk || earWkSize <= 0)) {
+		int nvtx = bgeoWeldVertices(bgeo, pCornerVtx, pVtxPnts, pWk);
+		ntri = bgeoGetWeldedTriangles(bgeo, pCornerVtx, pIdx, nullptr, pEarWk);
+		nxCore::dbg_msg("weld: %d corners -> %d vertices\n", ncorners, nvtx);
+		for (int i = 0; i < nvtx; ++i) {
+			pVtxPnts[i] = pntMap.dst(pVtxPnts[i]);
+		}
+		::fprintf(pOut, "  \"nweldVtx\" : %d,\n", nvtx);
+		::fprintf(pOut, "  \"nweldTri\" : %d,\n", ntri);
+		int_ary_out(pOut, "weldVtxPnts", pVtxPnts, nvtx);
+		int_ary_out(pOut, "weldTriIdx", (const int32_t*)pIdx, ntri * 3);
+		::fprintf(pOut, "  \"weldVtxAttrNames\" : [");
+		char nameBuf[256];
+		int iattr = 0;
+		for (int i = 0; i < nvtxAttrs; ++i) {
+			if (!bgeoVertexAttrIsVec(bgeo, i)) continue;
+			HBIN_STRING attrName = bgeoVertexAttrName(bgeo, i);
+			::fprintf(pOut, "\"");
+			hbin_str_out(pOut, attrName);
+			::fprintf(pOut, "\"");
+			if (iattr < nvecAttrs - 1) {
+				::fprintf(pOut, ", ");
+			}
+			float* pAttrData = &pData[iattr * nvtx * 3];
+			nxCore::mem_zero(pAttrData, nvtx * 3 * sizeof(float));
+			if (attrName.pChars && attrName.len > 0 && attrName.len < sizeof(nameBuf) - 1) {
+				nxCore::mem_copy(nameBuf, attrName.pChars, attrName.len);
+				nameBuf[attrName.len] = 0;
+				BgeoWeldAttrCtx attrCtx;
+				attrCtx.pCornerVtx = pCornerVtx;
+				attrCtx.pName = nameBuf;
+				attrCtx.pData = pAttrData;
+				attrCtx.corner = 0;
+				attrCtx.nvtx = 0;
+				bgeoForEachPrim(bgeo, BgeoWeldAttrCtx::prim_cb, &attrCtx);
+			}
+			++iattr;
+		}
+		::fprintf(pOut, "],\n");
+		flt_ary_out(pOut, "weldVtxData", pData, nvecAttrs * nvtx * 3);
+		if (tangents) {
+			write_welded_tangents(bgeo, pOut, pCornerVtx, pIdx, ntri, nvtx, pGenNrm);
+		}
+	}
+	nxCore::mem_free(pEarWk);
+	nxCore::mem_free(pData);
+	nxCore::mem_free(pIdx);
+	nxCore::mem_free(pWk);
+	nxCore::mem_free(pVtxPnts);
+	nxCore::mem_free(pCornerVtx);
+}
+
+static void write_lods(HBIN_BGEO bgeo, FILE* pOut, const BgeoTris& tris, const BgeoPntMap& pntMap, int nlods, float ratio, float maxErr, int cacheSize) {
+	int npnt = bgeoNumPoints(bgeo);
+	int ntri = tris.ntri;
+	if (ntri <= 0 || npnt <= 0 || nlods <= 0) return;
+	int32_t* pWk = (int32_t*)nxCore::mem_alloc(hbinSimplifyWorkSize(ntri, npnt) * sizeof(int32_t), "bgeo:lodWk");
+	HBIN_FLOAT3* pPos = (HBIN_FLOAT3*)nxCore::mem_alloc(npnt * sizeof(HBIN_FLOAT3), "bgeo:lodPos");
+	BgeoTris* pLods = (BgeoTris*)nxCore::mem_alloc(nlods * sizeof(BgeoTris), "bgeo:lods");
+	float* pErrs = (float*)nxCore::mem_alloc(nlods * sizeof(float), "bgeo:lodErrs");
+	int nout = 0;
+	if (pWk && pPos && pLods && pErrs) {
+		bgeoGetPointPositions(bgeo, pPos);
+		const BgeoTris* pPrev = &tris;
+		float err = 0.0f;
+		for (int i = 0; i < nlods; ++i) {
+			BgeoTris* pLod = &pLods[i];
+			pLod->ntri = 0;
+			pLod->pIdx = (uint32_t*)nxCore::mem_alloc(pPrev->ntri * 3 * sizeof(uint32_t), "bgeo:lodIdx");
+			pLod->pMtlIds = (int32_t*)nxCore::mem_alloc(pPrev->ntri * sizeof(int32_t), "bgeo:lodMtlIds");
+			if (!pLod->pIdx || !pLod->pMtlIds) {
+				pLod->reset();
+				break;
+			}
+			int target = (int)((float)pPrev->ntri * ratio);
+			float lodErr = 0.0f;
+			pLod->ntri = hbinSimplify(pLod->pIdx, pLod->pMtlIds, pPrev->pIdx, pPrev->pMtlIds, pPrev->ntri, pPos, npnt, nullptr, target, maxErr, &lodErr, pWk);
+			if (pLod->ntri <= 0 || pLod->ntri >= pPrev->ntri) {
+				pLod->reset();
+				break;
+			}
+			if (cacheSize > 0) {
+				pLod->optimize(bgeo, cacheSize, 0.0f, nullptr, nullptr);
+			}
+			/* each level is simplified from the previous one, so the errors add up */
+			err += lodErr;
+			pErrs[i] = err;
+			pPrev = pLod;
+			++nout;
+		}
+		::fprintf(pOut, "  \"nlods\" : %d,\n", nout);
+		::fprintf(pOut, "  \"lodTris\" : [");
+		for (int i = 0; i < nout; ++i) {
+			::fprintf(pOut, "%d", pLods[i].ntri);
+			if (i < nout - 1) {
+				::fprintf(pOut, ", ");
+			}
+		}
+		::fprintf(pOut, "],\n");
+		flt_ary_out(pOut, "lodErrors", pErrs, nout);
+		::fprintf(pOut, "  \"lodIdx\" : [");
+		for (int i = 0; i < nout; ++i) {
+			int nidx = pLods[i].ntri * 3;
+			for (int j = 0; j < nidx; ++j) {
+				::fprintf(pOut, "%d", pntMap.dst((int)pLods[i].pIdx[j]));
+				if (j < nidx - 1 || i < nout - 1) {
+					::fprintf(pOut, ", ");
+				}
+			}
+		}
+		::fprintf(pOut, "],\n");
+		if (bgeoNumMaterials(bgeo) > 0) {
+			::fprintf(pOut, "  \"lodTriMtlIds\" : [");
+			for (int i = 0; i < nout; ++i) {
+				for (int j = 0; j < pLods[i].ntri; ++j) {
+					::fprintf(pOut, "%d", pLods[i].pMtlIds[j]);
+					if (j < pLods[i].ntri - 1 || i < nout - 1) {
+						::fprintf(pOut, ", ");
+					}
+				}
+			}
+			::fprintf(pOut, "],\n");
+		}
+		for (int i = 0; i < nout; ++i) {
+			pLods[i].reset();
 		}
 	}
-	return 1;
+	nxCore::mem_free(pErrs);
+	nxCore::mem_free(pLods);
+	nxCore::mem_free(pPos);
+	nxCore::mem_free(pWk);
 }
 
-static int polMtlIdCB(const HBIN_PRIM prim, void* pCtxMem) {
-	BgeoContext* pCtx = (BgeoContext*)pCtxMem;
-	if (!pCtx) return 0;
-	if (!pCtx->pOut) return 0;
-	if (bgeoPrimIsPoly(prim)) {
-		int32_t mtlId = bgeoPrimMaterialId(prim);
-		::fprintf(pCtx->pOut, "%d", mtlId);
-		--pCtx->aryCnt;
-		if (pCtx->aryCnt > 0) {
-			::fprintf(pCtx->pOut, ", ");
+/* comma-separated names from an option; everything is selected when the option is absent */
+struct BgeoNameSel {
+	const char* pList;
+
+	void init(const char* pOptName) {
+		pList = nxApp::get_opt(pOptName);
+	}
+
+	bool has(const char* pName, size_t len) const {
+		if (!pList) return true;
+		if (!pName) return false;
+		const char* pItem = pList;
+		while (*pItem) {
+			size_t itemLen = 0;
+			while (pItem[itemLen] && pItem[itemLen] != ',') {
+				++itemLen;
+			}
+			if (itemLen == len) {
+				size_t i = 0;
+				while (i < len && pItem[i] == pName[i]) {
+					++i;
+				}
+				if (i == len) {
+					return true;
+				}
+			}
+			pItem += itemLen;
+			if (*pItem == ',') {
+				++pItem;
+			}
 		}
+		return false;
 	}
-	return 1;
+
+	bool has(const char* pName) const {
+		size_t len = 0;
+		while (pName && pName[len]) {
+			++len;
+		}
+		return has(pName, len);
+	}
+
+	bool has(const HBIN_STRING& name) const { return has(name.pChars, name.len); }
+};
+
+static bool pnt_vec_attr_sel(HBIN_BGEO bgeo, int attrId, const BgeoNameSel& attrSel) {
+	return bgeoPointAttrIsVec(bgeo, attrId) && attrSel.has(bgeoPointAttrName(bgeo, attrId));
+}
+
+static bool pnt_str_attr_sel(HBIN_BGEO bgeo, int attrId, const BgeoNameSel& attrSel) {
+	return bgeoPointAttrIsStr(bgeo, attrId) && attrSel.has(bgeoPointAttrName(bgeo, attrId));
+}
+
+struct BgeoPntGrpSel {
+	const uint32_t* pPntBits;
+	uint32_t* pPrimSel;
+	int npts;
+
+	static int prim_cb(const HBIN_PRIM prim, void* pMem) {
+		BgeoPntGrpSel* pSel = (BgeoPntGrpSel*)pMem;
+		int32_t nvtx = bgeoPrimNumVertices(prim);
+		bool inside = nvtx > 0;
+		for (int32_t i = 0; i < nvtx && inside; ++i) {
+			int32_t pid = bgeoPrimVertexPntId(prim, i);
+			inside = (uint32_t)pid < (uint32_t)pSel->npts && HBIN_BIT_TEST(pSel->pPntBits, pid) != 0;
+		}
+		if (inside) {
+			int32_t id = bgeoPrimId(prim);
+			pSel->pPrimSel[id >> 5] |= 1U << (id & 31);
+		}
+		return 1;
+	}
+};
+
+/* primitive group, or primitives with all points in a point group */
+static uint32_t* select_prims(HBIN_BGEO bgeo, const char* pGrpName) {
+	int nprim = bgeoNumPrims(bgeo);
+	if (nprim <= 0) return nullptr;
+	uint32_t* pPrimSel = (uint32_t*)nxCore::mem_alloc(((nprim + 31) / 32) * sizeof(uint32_t), "bgeo:primSel");
+	if (!pPrimSel) return nullptr;
+	int grpId = bgeoFindPrimGroup(bgeo, pGrpName);
+	int nsel = 0;
+	if (grpId >= 0) {
+		nsel = bgeoGetPrimGroupBits(bgeo, grpId, pPrimSel);
+	} else {
+		grpId = bgeoFindPointGroup(bgeo, pGrpName);
+		int npts = bgeoNumPoints(bgeo);
+		uint32_t* pPntBits = grpId >= 0 ? (uint32_t*)nxCore::mem_alloc(((npts + 31) / 32) * sizeof(uint32_t), "bgeo:pntSel") : nullptr;
+		nxCore::mem_zero(pPrimSel, ((nprim + 31) / 32) * sizeof(uint32_t));
+		if (pPntBits) {
+			bgeoGetPointGroupBits(bgeo, grpId, pPntBits);
+			BgeoPntGrpSel sel;
+			sel.pPntBits = pPntBits;
+			sel.pPrimSel = pPrimSel;
+			sel.npts = npts;
+			bgeoForEachPrim(bgeo, BgeoPntGrpSel::prim_cb, &sel);
+			for (int i = 0; i < nprim; ++i) {
+				nsel += HBIN_BIT_TEST(pPrimSel, i);
+			}
+			nxCore::mem_free(pPntBits);
+		}
+	}
+	nxCore::dbg_msg("group \"%s\": %d of %d primitives\n", pGrpName, nsel, nprim);
+	return pPrimSel;
 }
 
 void write_bgeo_json(HBIN_BGEO bgeo, FILE* pOut) {
 	if (!bgeoValid(bgeo)) return;
 	if (pOut == nullptr) pOut = stdout;
 	char nameBuf[256];
-	BgeoContext ctx;
-	ctx.bgeo = bgeo;
-	ctx.pOut = pOut;
-	int npnt = bgeoNumPoints(bgeo);
-	int ntri = bgeoCountTriangles(bgeo);
-	int npol = bgeoCountPolygons(bgeo);
+	/* -attrs:P,N,... selects point attributes, -sections:attrs,capt,tris,pols,mtl selects output blocks */
+	BgeoNameSel attrSel;
+	attrSel.init("attrs");
+	BgeoNameSel secSel;
+	secSel.init("sections");
+	bool outAttrs = secSel.has("attrs");
+	bool outCapt = secSel.has("capt");
+	bool outTris = secSel.has("tris");
+	bool outPols = secSel.has("pols");
+	bool outMtl = secSel.has("mtl");
+	const char* pGrpName = nxApp::get_opt("group");
+	if (pGrpName && bgeoFindPrimGroup(bgeo, pGrpName) < 0 && bgeoFindPointGroup(bgeo, pGrpName) < 0) {
+		nxCore::dbg_msg("group \"%s\" not found\n", pGrpName);
+		::fprintf(pOut, "{\n");
+		::fprintf(pOut, "  \"dataType\" : \"geo\",\n");
+		::fprintf(pOut, "  \"error\" : \"group \\\"%s\\\" not found\"\n", pGrpName);
+		::fprintf(pOut, "}\n");
+		return;
+	}
+	uint32_t* pPrimSel = pGrpName ? select_prims(bgeo, pGrpName) : nullptr;
+	int ntriPrims = bgeoCountTrianglesInGroup(bgeo, pPrimSel);
+	int npol = bgeoCountPolygonsInGroup(bgeo, pPrimSel);
 	int nmtl = bgeoNumMaterials(bgeo);
 	int npntAttrs = bgeoNumPointAttrs(bgeo);
 	int nprimAttrs = bgeoNumPrimAttrs(bgeo);
-	int ncaptNodes = bgeoNumCaptureNodes(bgeo);
-	int maxCaptsPerPnt = bgeoMaxCapturesPerPoint(bgeo);
+	int ncaptNodes = outCapt ? bgeoNumCaptureNodes(bgeo) : 0;
+	int maxCaptsPerPnt = outCapt ? bgeoMaxCapturesPerPoint(bgeo) : 0;
 	int npntVecAttrs = 0;
-	for (int i = 0; i < npntAttrs; ++i) {
-		if (bgeoPointAttrIsVec(bgeo, i)) {
+	for (int i = 0; outAttrs && i < npntAttrs; ++i) {
+		if (pnt_vec_attr_sel(bgeo, i, attrSel)) {
 			++npntVecAttrs;
 		}
 	}
+	int nrmAttrId = bgeoFindPointAttr(bgeo, "N");
+	bool hasNrm = nrmAttrId >= 0 && bgeoPointAttrIsVec(bgeo, nrmAttrId);
+	bool outNrm = outAttrs && attrSel.has("N");
+	bool tangents = nxApp::get_bool_opt("tangents", false);
+	bool genNrm = nxApp::get_opt("gennrm") ? nxApp::get_bool_opt("gennrm", true) : (!hasNrm && npol > 0 && (outNrm || tangents));
+	HBIN_FLOAT3* pGenNrm = nullptr;
+	if (genNrm) {
+		int nrmWeight = HBIN_NRM_WEIGHT_ANGLE;
+		const char* pWeightOpt = nxApp::get_opt("nrmweight");
+		if (pWeightOpt) {
+			if (nxCore::str_eq(pWeightOpt, "area")) {
+				nrmWeight = HBIN_NRM_WEIGHT_AREA;
+			} else if (nxCore::str_eq(pWeightOpt, "anglearea")) {
+				nrmWeight = HBIN_NRM_WEIGHT_ANGLE_AREA;
+			}
+		}
+		int npts = bgeoNumPoints(bgeo);
+		pGenNrm = npts > 0 ? (HBIN_FLOAT3*)nxCore::mem_alloc(npts * sizeof(HBIN_FLOAT3), "bgeo:genNrm") : nullptr;
+		if (pGenNrm) {
+			bgeoComputePointNormals(bgeo, pGenNrm, nrmWeight);
+		}
+	}
+	/* generated normals are appended as "N" when the file has none */
+	bool addNrm = pGenNrm && !hasNrm && outNrm;
+	if (addNrm) {
+		++npntVecAttrs;
+	}
 	int npntStrAttrs = 0;
-	for (int i = 0; i < npntAttrs; ++i) {
-		if (bgeoPointAttrIsStr(bgeo, i)) {
+	for (int i = 0; outAttrs && i < npntAttrs; ++i) {
+		if (pnt_str_attr_sel(bgeo, i, attrSel)) {
 			++npntStrAttrs;
 		}
 	}
 	int nvtx = 0;
 	if (npol > 0) {
-		if (npol == ntri) {
-			nvtx = ntri * 3;
+		if (npol == ntriPrims) {
+			nvtx = ntriPrims * 3;
 		} else {
-			ctx.num = 0;
-			bgeoForEachPrim(bgeo, countPolVtxCB, &ctx);
-			nvtx = ctx.num;
+			nvtx = bgeoCountPolyVerticesInGroup(bgeo, pPrimSel);
 		}
 	}
+	/* polygons go out as CSR pols, or as triIdx when they are all triangles */
+	bool polsCSR = npol > 0 && outPols && (npol != ntriPrims || !outTris);
+	bool polsOut = polsCSR || (npol > 0 && npol == ntriPrims && outTris);
+	/* without tris there is nothing to triangulate, clean up or optimize */
+	BgeoTris tris;
+	if (outTris) {
+		tris.init(bgeo, nxApp::get_bool_opt("triangulate", true), pPrimSel);
+	} else {
+		tris.clear();
+	}
+	BgeoCleanup cleanup;
+	cleanup.init();
+	bool cleaned = false;
+	if (nxApp::get_opt("cleanup")) {
+		cleaned = cleanup.exec(bgeo, tris, nxApp::get_float_opt("cleanup", 0.0f), nxApp::get_float_opt("cleanarea", 0.0f));
+	}
+	int ntri = tris.ntri;
+	int vcacheSize = nxApp::get_opt("vcache") ? nxApp::get_int_opt("vcache", 16) : 0;
+	HBIN_VCACHE_STATS vcacheIn;
+	HBIN_VCACHE_STATS vcacheOut;
+	bool vcacheOpt = false;
+	if (vcacheSize > 0) {
+		float overdraw = nxApp::get_opt("overdraw") ? nxApp::get_float_opt("overdraw", 1.05f) : 0.0f;
+		vcacheOpt = tris.optimize(bgeo, vcacheSize, overdraw, &vcacheIn, &vcacheOut);
+		if (vcacheOpt) {
+			nxCore::dbg_msg("vcache(%d): ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n", vcacheSize, vcacheIn.acmr, vcacheOut.acmr, vcacheIn.atvr, vcacheOut.atvr);
+		}
+	}
+	HBIN_MTL_RANGE* pMtlRanges = nullptr;
+	bool submeshes = nxApp::get_bool_opt("submeshes", false);
+	if (nxApp::get_bool_opt("mtlsort", false) || submeshes) {
+		pMtlRanges = (HBIN_MTL_RANGE*)nxCore::mem_alloc((nmtl + 1) * sizeof(HBIN_MTL_RANGE), "bgeo:mtlRanges");
+		if (!tris.sort_by_material(nmtl, pMtlRanges)) {
+			nxCore::mem_free(pMtlRanges);
+			pMtlRanges = nullptr;
+		}
+	}
+	BgeoPntMap pntMap;
+	pntMap.init(bgeo);
+	pntMap.pWeld = cleanup.pWeld;
+	if (nxApp::get_bool_opt("vfetch", false) || pPrimSel || pntMap.pWeld) {
+		pntMap.compact(bgeo, tris, pPrimSel);
+	}
+	int npnt = pntMap.npnt;
 	::fprintf(pOut, "{\n");
 	::fprintf(pOut, "  \"dataType\" : \"geo\",\n");
 	::fprintf(pOut, "  \"npnt\" : %d,\n", npnt);
 	::fprintf(pOut, "  \"ntri\" : %d,\n", ntri);
-	::fprintf(pOut, "  \"npol\" : %d,\n", npol);
-	::fprintf(pOut, "  \"nvtx\" : %d,\n", nvtx);
+	::fprintf(pOut, "  \"npol\" : %d,\n", polsOut ? npol : 0);
+	::fprintf(pOut, "  \"ntriPrims\" : %d,\n", polsOut ? ntriPrims : 0);
+	::fprintf(pOut, "  \"nvtx\" : %d,\n", polsOut ? nvtx : 0);
+	::fprintf(pOut, "  \"idxSize\" : %d,\n", bgeoTriangleIndexSize(bgeo));
+	if (!(outAttrs && outCapt && outTris && outPols && outMtl)) {
+		/* sections dropped by -sections, their counts above are 0 and their arrays empty */
+		static const char* pSecNames[] = { "attrs", "capt", "tris", "pols", "mtl" };
+		bool secOut[] = { outAttrs, outCapt, outTris, outPols, outMtl };
+		bool first = true;
+		::fprintf(pOut, "  \"omitted\" : [");
+		for (int i = 0; i < 5; ++i) {
+			if (!secOut[i]) {
+				::fprintf(pOut, first ? "\"%s\"" : ", \"%s\"", pSecNames[i]);
+				first = false;
+			}
+		}
+		::fprintf(pOut, "],\n");
+	}
+	if (cleaned) {
+		::fprintf(pOut, "  \"cleanTol\" : %f,\n", cleanup.tol);
+		::fprintf(pOut, "  \"cleanWeldedPnts\" : %d,\n", cleanup.nwelded);
+		::fprintf(pOut, "  \"cleanDegenerateTris\" : %d,\n", cleanup.stats.degenerate);
+		::fprintf(pOut, "  \"cleanDuplicateTris\" : %d,\n", cleanup.stats.duplicate);
+	}
+	if (vcacheOpt) {
+		::fprintf(pOut, "  \"vcacheSize\" : %d,\n", vcacheSize);
+		::fprintf(pOut, "  \"acmrIn\" : %f,\n", vcacheIn.acmr);
+		::fprintf(pOut, "  \"atvrIn\" : %f,\n", vcacheIn.atvr);
+		::fprintf(pOut, "  \"acmrOut\" : %f,\n", vcacheOut.acmr);
+		::fprintf(pOut, "  \"atvrOut\" : %f,\n", vcacheOut.atvr);
+	}
 	::fprintf(pOut, "  \"nmtl\" : %d,\n", nmtl);
-	::fprintf(pOut, "  \"npntAttrs\" : %d,\n", npntAttrs);
+	::fprintf(pOut, "  \"npntAttrs\" : %d,\n", npntAttrs + (addNrm ? 1 : 0));
 	::fprintf(pOut, "  \"npntVecAttrs\" : %d,\n", npntVecAttrs);
 	::fprintf(pOut, "  \"npntStrAttrs\" : %d,\n", npntStrAttrs);
 	::fprintf(pOut, "  \"nprimAttrs\" : %d,\n", nprimAttrs);
@@ -151,16 +1210,19 @@ void write_bgeo_json(HBIN_BGEO bgeo, FILE* pOut) {
 		::fprintf(pOut, "\"");
 		hbin_str_out(pOut, attrName);
 		::fprintf(pOut, "\"");
-		if (i < npntAttrs-1) {
+		if (i < npntAttrs-1 || addNrm) {
 			::fprintf(pOut, ", ");
 		}
 	}
+	if (addNrm) {
+		::fprintf(pOut, "\"N\"");
+	}
 	::fprintf(pOut, "],\n");
 	::fprintf(pOut, "  \"pntVecAttrNames\" : [");
 	if (npntVecAttrs > 0) {
 		size_t aryCnt = npntVecAttrs;
 		for (int i = 0; i < npntAttrs; ++i) {
-			if (bgeoPointAttrIsVec(bgeo, i)) {
+			if (pnt_vec_attr_sel(bgeo, i, attrSel)) {
 				HBIN_STRING attrName = bgeoPointAttrName(bgeo, i);
 				::fprintf(pOut, "\"");
 				hbin_str_out(pOut, attrName);
@@ -171,13 +1233,16 @@ void write_bgeo_json(HBIN_BGEO bgeo, FILE* pOut) {
 				}
 			}
 		}
+		if (addNrm) {
+			::fprintf(pOut, "\"N\"");
+		}
 	}
 	::fprintf(pOut, "],\n");
 	::fprintf(pOut, "  \"pntStrAttrNames\" : [");
 	if (npntStrAttrs > 0) {
 		size_t aryCnt = npntStrAttrs;
 		for (int i = 0; i < npntAttrs; ++i) {
-			if (bgeoPointAttrIsStr(bgeo, i)) {
+			if (pnt_str_attr_sel(bgeo, i, attrSel)) {
 				HBIN_STRING attrName = bgeoPointAttrName(bgeo, i);
 				::fprintf(pOut, "\"");
 				hbin_str_out(pOut, attrName);
@@ -206,9 +1271,9 @@ void write_bgeo_json(HBIN_BGEO bgeo, FILE* pOut) {
 	}
 	::fprintf(pOut, "],\n");
 	::fprintf(pOut, "  \"pnts\" : [");
-	for (int i = 0; i < npnt; ++i) {
-		HBIN_FLOAT3 pos;
-		bgeoPointPos(pos, bgeo, i);
+	BgeoAttrView<float, 3> pntPos = bgeo_point_attr<float, 3>(bgeo, "P");
+	for (int i = 0; pntPos.valid() && i < npnt; ++i) {
+		BgeoVec<float, 3> pos = pntPos[size_t(pntMap.src(i))];
 		::fprintf(pOut, "%f, %f, %f", pos[0], pos[1], pos[2]);
 		if (i < npnt-1) {
 			::fprintf(pOut, ", ");
@@ -219,14 +1284,19 @@ void write_bgeo_json(HBIN_BGEO bgeo, FILE* pOut) {
 	if (npntVecAttrs > 0) {
 		size_t aryCnt = npnt * npntVecAttrs;
 		for (int i = 0; i < npntAttrs; ++i) {
-			if (bgeoPointAttrIsVec(bgeo, i)) {
+			if (pnt_vec_attr_sel(bgeo, i, attrSel)) {
 				HBIN_STRING attrName = bgeoPointAttrName(bgeo, i);
 				if (attrName.pChars && attrName.len > 0 && attrName.len < sizeof(nameBuf) - 1) {
 					nxCore::mem_copy(nameBuf, attrName.pChars, attrName.len);
 					nameBuf[attrName.len] = 0;
 					HBIN_FLOAT3 vec;
+					bool useGenNrm = pGenNrm && i == nrmAttrId;
 					for (int j = 0; j < npnt; ++j) {
-						bgeoPointVecAttr(vec, bgeo, nameBuf, j);
+						if (useGenNrm) {
+							nxCore::mem_copy(vec, pGenNrm[pntMap.src(j)], sizeof(HBIN_FLOAT3));
+						} else {
+							bgeoPointVecAttr(vec, bgeo, nameBuf, pntMap.src(j));
+						}
 						::fprintf(pOut, "%f, %f, %f", vec[0], vec[1], vec[2]);
 						--aryCnt;
 						if (aryCnt > 0) {
@@ -236,19 +1306,29 @@ void write_bgeo_json(HBIN_BGEO bgeo, FILE* pOut) {
 				}
 			}
 		}
+		if (addNrm) {
+			for (int j = 0; j < npnt; ++j) {
+				const float* pNrm = pGenNrm[pntMap.src(j)];
+				::fprintf(pOut, "%f, %f, %f", pNrm[0], pNrm[1], pNrm[2]);
+				--aryCnt;
+				if (aryCnt > 0) {
+					::fprintf(pOut, ", ");
+				}
+			}
+		}
 	}
 	::fprintf(pOut, "],\n");
 	::fprintf(pOut, "  \"pntsStrData\" : [");
 	if (npntStrAttrs > 0) {
 		size_t aryCnt = npnt * npntStrAttrs;
 		for (int i = 0; i < npntAttrs; ++i) {
-			if (bgeoPointAttrIsStr(bgeo, i)) {
+			if (pnt_str_attr_sel(bgeo, i, attrSel)) {
 				HBIN_STRING attrName = bgeoPointAttrName(bgeo, i);
 				if (attrName.pChars && attrName.len > 0 && attrName.len < sizeof(nameBuf) - 1) {
 					nxCore::mem_copy(nameBuf, attrName.pChars, attrName.len);
 					nameBuf[attrName.len] = 0;
 					for (int j = 0; j < npnt; ++j) {
-						HBIN_STRING hstr = bgeoPointStrAttr(bgeo, nameBuf, j);
+						HBIN_STRING hstr = bgeoPointStrAttr(bgeo, nameBuf, pntMap.src(j));
 						::fprintf(pOut, "\"");
 						hbin_str_out(pOut, hstr);
 						::fprintf(pOut, "\"");
@@ -267,7 +1347,7 @@ void write_bgeo_json(HBIN_BGEO bgeo, FILE* pOut) {
 		size_t aryCnt = npnt * maxCaptsPerPnt;
 		for (int i = 0; i < npnt; ++i) {
 			for (int j = 0; j < maxCaptsPerPnt; ++j) {
-				HBIN_CAPTURE capt = bgeoPointCapture(bgeo, i, j);
+				HBIN_CAPTURE capt = bgeoPointCapture(bgeo, pntMap.src(i), j);
 				::fprintf(pOut, "%d", capt.node);
 				--aryCnt;
 				if (aryCnt > 0) {
@@ -282,7 +1362,7 @@ void write_bgeo_json(HBIN_BGEO bgeo, FILE* pOut) {
 		size_t aryCnt = npnt * maxCaptsPerPnt;
 		for (int i = 0; i < npnt; ++i) {
 			for (int j = 0; j < maxCaptsPerPnt; ++j) {
-				HBIN_CAPTURE capt = bgeoPointCapture(bgeo, i, j);
+				HBIN_CAPTURE capt = bgeoPointCapture(bgeo, pntMap.src(i), j);
 				::fprintf(pOut, "%f", capt.wght);
 				--aryCnt;
 				if (aryCnt > 0) {
@@ -293,7 +1373,7 @@ void write_bgeo_json(HBIN_BGEO bgeo, FILE* pOut) {
 	}
 	::fprintf(pOut, "],\n");
 	::fprintf(pOut, "  \"mtlPaths\" : [");
-	if (nmtl > 0) {
+	if (nmtl > 0 && outMtl) {
 		size_t aryCnt = nmtl;
 		for (int i = 0; i < nmtl; ++i) {
 			HBIN_STRING mtlPath = bgeoMaterialPath(bgeo, i);
@@ -308,30 +1388,129 @@ void write_bgeo_json(HBIN_BGEO bgeo, FILE* pOut) {
 	}
 	::fprintf(pOut, "],\n");
 	::fprintf(pOut, "  \"triIdx\" : [");
-	if (ntri > 0) {
-		ctx.aryCnt = ntri;
-		bgeoForEachPrim(bgeo, triIdxPrimCB, &ctx);
+	for (int i = 0; outTris && i < ntri * 3; ++i) {
+		::fprintf(pOut, "%d", pntMap.dst(tris.pIdx[i]));
+		if (i < ntri * 3 - 1) {
+			::fprintf(pOut, ", ");
+		}
 	}
 	::fprintf(pOut, "],\n");
+	if (nmtl > 0 && outTris) {
+		int_ary_out(pOut, "triMtlIds", tris.pMtlIds, ntri);
+	}
+	bool mtlsCSR = npol > 0 && nmtl > 0 && outPols;
+	int32_t* pPolOrg = nullptr;
+	int32_t* pPolPnts = nullptr;
+	int32_t* pPolMtlIds = nullptr;
+	if (polsCSR) {
+		pPolOrg = (int32_t*)nxCore::mem_alloc((npol + 1) * sizeof(int32_t), "bgeo:polOrg");
+		pPolPnts = (int32_t*)nxCore::mem_alloc(nxCalc::max(nvtx, 1) * sizeof(int32_t), "bgeo:polPnts");
+		polsCSR = pPolOrg && pPolPnts;
+	}
+	if (mtlsCSR) {
+		pPolMtlIds = (int32_t*)nxCore::mem_alloc(npol * sizeof(int32_t), "bgeo:polMtlIds");
+		mtlsCSR = pPolMtlIds != nullptr;
+	}
+	if (polsCSR || mtlsCSR) {
+		bgeoGetPolygonsCSRInGroup(bgeo, pPrimSel, polsCSR ? pPolOrg : nullptr, polsCSR ? pPolPnts : nullptr, pPolMtlIds);
+	}
 	::fprintf(pOut, "  \"polIdx\" : [");
-	if (npol > 0 && npol != ntri) {
-		ctx.aryCnt = npol;
-		bgeoForEachPrim(bgeo, polIdxPrimCB, &ctx);
+	if (polsCSR) {
+		int nidx = pPolOrg[npol];
+		for (int i = 0; i < nidx; ++i) {
+			::fprintf(pOut, "%d", pntMap.dst(pPolPnts[i]));
+			if (i < nidx - 1) {
+				::fprintf(pOut, ", ");
+			}
+		}
 	}
 	::fprintf(pOut, "],\n");
 	::fprintf(pOut, "  \"pols\" : [");
-	if (npol > 0 && npol != ntri) {
-		ctx.aryCnt = npol;
-		ctx.num = 0;
-		bgeoForEachPrim(bgeo, polRangePrimCB, &ctx);
+	if (polsCSR) {
+		for (int i = 0; i < npol; ++i) {
+			::fprintf(pOut, "%d, %d", pPolOrg[i], pPolOrg[i + 1] - pPolOrg[i]);
+			if (i < npol - 1) {
+				::fprintf(pOut, ", ");
+			}
+		}
 	}
 	::fprintf(pOut, "],\n");
-	::fprintf(pOut, "  \"mtlIds\" : [");
-	if (npol > 0 && nmtl > 0) {
-		ctx.aryCnt = npol;
-		bgeoForEachPrim(bgeo, polMtlIdCB, &ctx);
+	if (mtlsCSR) {
+		int_ary_out(pOut, "mtlIds", pPolMtlIds, npol);
+	} else {
+		::fprintf(pOut, "  \"mtlIds\" : [],\n");
 	}
-	::fprintf(pOut, "],\n");
+	nxCore::mem_free(pPolMtlIds);
+	nxCore::mem_free(pPolPnts);
+	nxCore::mem_free(pPolOrg);
+	if (pMtlRanges) {
+		int nranges = 0;
+		for (int i = 0; i <= nmtl; ++i) {
+			if (pMtlRanges[i].idxCount > 0) {
+				pMtlRanges[nranges++] = pMtlRanges[i];
+			}
+		}
+		::fprintf(pOut, "  \"nmtlRanges\" : %d,\n", nranges);
+		int_ary_out(pOut, "mtlRanges", (const int32_t*)pMtlRanges, nranges * 3);
+		::fprintf(pOut, "  \"mtlRangePaths\" : [");
+		for (int i = 0; i < nranges; ++i) {
+			::fprintf(pOut, "\"");
+			if (pMtlRanges[i].mtlId >= 0) {
+				hbin_str_out(pOut, bgeoMaterialPath(bgeo, pMtlRanges[i].mtlId));
+			}
+			::fprintf(pOut, "\"");
+			if (i < nranges - 1) {
+				::fprintf(pOut, ", ");
+			}
+		}
+		::fprintf(pOut, "],\n");
+		nxCore::mem_free(pMtlRanges);
+	}
+	if (tangents) {
+		write_tangents(bgeo, pOut, tris, pntMap, pGenNrm);
+	}
+	if (submeshes) {
+		write_submeshes(bgeo, pOut, tris, pntMap, pGenNrm);
+	}
+	if (nxApp::get_bool_opt("primattrs", false)) {
+		write_prim_attrs(bgeo, pOut, pPrimSel);
+	}
+	if (nxApp::get_bool_opt("weld", false)) {
+		if (pPrimSel) {
+			nxCore::dbg_msg("weld: not supported with -group\n");
+		} else {
+			write_welded(bgeo, pOut, pntMap, tangents, pGenNrm);
+		}
+	}
+	if (nxApp::get_bool_opt("adjacency", false)) {
+		write_adjacency(bgeo, pOut, pPrimSel, pntMap);
+	}
+	if (nxApp::get_bool_opt("pack", false)) {
+		write_packed(bgeo, pOut, tris, pntMap);
+	}
+	int skinPalSize = nxApp::get_int_opt("skinpal", 0);
+	if (skinPalSize > 0) {
+		write_skin_batches(bgeo, pOut, tris, pntMap, skinPalSize);
+	}
+	if (nxApp::get_opt("split16")) {
+		write_idx16_chunks(bgeo, pOut, tris, pntMap, nxApp::get_int_opt("split16", 0));
+	}
+	if (nxApp::get_opt("meshlets")) {
+		int meshletVtx = nxCalc::clamp(nxApp::get_int_opt("meshlets", 64), 3, 256);
+		int meshletTris = nxCalc::max(nxApp::get_int_opt("meshlettris", 124), 1);
+		write_meshlets(bgeo, pOut, tris, pntMap, meshletVtx, meshletTris);
+	}
+	int nlods = nxApp::get_int_opt("lods", 0);
+	if (nlods > 0) {
+		float lodRatio = nxCalc::clamp(nxApp::get_float_opt("lodratio", 0.5f), 0.01f, 0.99f);
+		float lodErr = nxApp::get_float_opt("loderr", 0.01f);
+		write_lods(bgeo, pOut, tris, pntMap, nlods, lodRatio, lodErr, vcacheSize);
+	}
+	nxCore::mem_free(pGenNrm);
+	nxCore::mem_free(pPrimSel);
+	pntMap.reset();
+	cleanup.reset();
+	tris.reset();
 	::fprintf(pOut, "  \"_EOF_\" : true\n");
 	::fprintf(pOut, "}\n");
 }
@@ -343,6 +1522,15 @@ void cvt_bgeo(const char* pBgeoPath, const char* pOutPath) {
 	if (!pBin) {
 		return;
 	}
+	HBIN_BGEO bgeo = bgeoOpen(pBin, bgeoSize);
+	if (!bgeo) {
+		nxCore::dbg_msg("%s: invalid or truncated bgeo\n", pBgeoPath);
+		nxCore::bin_unload(pBin);
+		return;
+	}
+	if (nxApp::get_bool_opt("normalize", true)) {
+		bgeoNormalize(bgeo, bgeoSize);
+	}
 	FILE* pOut = nullptr;
 	if (pOutPath) {
 		pOut = nxSys::fopen_w_txt(pOutPath);
@@ -350,7 +1538,7 @@ void cvt_bgeo(const char* pBgeoPath, const char* pOutPath) {
 			return;
 		}
 	}
-	write_bgeo_json((HBIN_BGEO)pBin, pOut);
+	write_bgeo_json(bgeo, pOut);
 	if (pOutPath) {
 		::fclose(pOut);
 	}
@@ -0,0 +1,245 @@
+#include "crosscore.hpp"
+#include "hbin.h"
+#include "hbin2json.hpp"
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+
+#ifndef _WIN32
+#	include <fcntl.h>
+#	include <unistd.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#endif
+
+/*
+	catalog scan: one JSON line per file, built from the header, attribute descriptors
+	and string tables; bgeoOpen also walks the primitive and group records, which locates
+	the detail attributes holding the capture nodes. Files are mapped, and the point block
+	is stepped over by size, so point records are never read.
+	Worker threads use the C allocator directly rather than nxCore's.
+*/
+
+struct InfoFile {
+	void* pMem;
+	size_t size;
+	bool mapped;
+
+	bool open(const char* pPath) {
+		pMem = nullptr;
+		size = 0;
+		mapped = false;
+#ifndef _WIN32
+		int fd = ::open(pPath, O_RDONLY);
+		if (fd >= 0) {
+			struct stat st;
+			if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+				void* pMap = ::mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (pMap != MAP_FAILED) {
+					pMem = pMap;
+					size = (size_t)st.st_size;
+					mapped = true;
+				}
+			}
+			::close(fd);
+		}
+#endif
+		if (!pMem) {
+			FILE* pFile = ::fopen(pPath, "rb");
+			if (pFile) {
+				if (::fseek(pFile, 0, SEEK_END) == 0) {
+					long len = ::ftell(pFile);
+					if (len > 0 && ::fseek(pFile, 0, SEEK_SET) == 0) {
+						pMem = ::malloc((size_t)len);
+						if (pMem && ::fread(pMem, 1, (size_t)len, pFile) == (size_t)len) {
+							size = (size_t)len;
+						} else {
+							::free(pMem);
+							pMem = nullptr;
+						}
+					}
+				}
+				::fclose(pFile);
+			}
+		}
+		return pMem != nullptr;
+	}
+
+	void close() {
+		if (pMem) {
+#ifndef _WIN32
+			if (mapped) {
+				::munmap(pMem, size);
+			} else
+#endif
+			{
+				::free(pMem);
+			}
+		}
+		pMem = nullptr;
+		size = 0;
+	}
+};
+
+struct InfoLine {
+	char* pStr;
+	size_t len;
+	size_t capacity;
+
+	void init() {
+		pStr = nullptr;
+		len = 0;
+		capacity = 0;
+	}
+
+	void reset() {
+		::free(pStr);
+		init();
+	}
+
+	bool reserve(size_t n) {
+		if (len + n + 1 <= capacity) return true;
+		size_t newCap = nxCalc::max(capacity * 2, len + n + 1);
+		newCap = nxCalc::max(newCap, size_t(256));
+		char* pNew = (char*)::realloc(pStr, newCap);
+		if (!pNew) return false;
+		pStr = pNew;
+		capacity = newCap;
+		return true;
+	}
+
+	void put(const char* pFmt, ...) {
+		char buf[256];
+		va_list args;
+		va_start(args, pFmt);
+		int n = ::vsnprintf(buf, sizeof(buf), pFmt, args);
+		va_end(args);
+		if (n > 0) {
+			size_t len = nxCalc::min(size_t(n), sizeof(buf) - 1);
+			if (reserve(len)) {
+				nxCore::mem_copy(pStr + this->len, buf, len);
+				this->len += len;
+				pStr[this->len] = 0;
+			}
+		}
+	}
+
+	void str(const char* pChars, size_t n) {
+		if (!reserve(n * 2 + 2)) return;
+		pStr[len++] = '"';
+		for (size_t i = 0; i < n; ++i) {
+			char c = pChars[i];
+			if (c == '"' || c == '\\') {
+				pStr[len++] = '\\';
+			}
+			pStr[len++] = c;
+		}
+		pStr[len++] = '"';
+		pStr[len] = 0;
+	}
+
+	void str(const HBIN_STRING& s) { str(s.pChars, s.pChars ? s.len : 0); }
+	void str(const char* pChars) { size_t n = 0; while (pChars && pChars[n]) ++n; str(pChars, n); }
+};
+
+static void info_names(InfoLine& line, const char* pKey, HBIN_BGEO bgeo, int n, HBIN_STRING (*pGetName)(const HBIN_BGEO, const int32_t)) {
+	line.put(", \"%s\" : [", pKey);
+	for (int i = 0; i < n; ++i) {
+		if (i > 0) {
+			line.put(", ");
+		}
+		line.str(pGetName(bgeo, i));
+	}
+	line.put("]");
+}
+
+static void info_bgeo(InfoLine& line, HBIN_BGEO bgeo) {
+	int npts = bgeoNumPoints(bgeo);
+	int nprims = bgeoNumPrims(bgeo);
+	line.put(", \"type\" : \"geo\", \"version\" : %d", bgeoVersion(bgeo));
+	line.put(", \"npnt\" : %d, \"nprim\" : %d", npts, nprims);
+	line.put(", \"npntGroups\" : %d, \"nprimGroups\" : %d", bgeoNumPointGroups(bgeo), bgeoNumPrimGroups(bgeo));
+	info_names(line, "pntAttrs", bgeo, npts > 0 ? bgeoNumPointAttrs(bgeo) : 0, bgeoPointAttrName);
+	info_names(line, "vtxAttrs", bgeo, bgeoNumVertexAttrs(bgeo), bgeoVertexAttrName);
+	info_names(line, "primAttrs", bgeo, bgeoNumPrimAttrs(bgeo), bgeoPrimAttrName);
+	info_names(line, "mtlPaths", bgeo, bgeoNumMaterials(bgeo), bgeoMaterialPath);
+	line.put(", \"ndetailAttrs\" : %d", bgeoNumDetailAttrs(bgeo));
+	info_names(line, "captNodes", bgeo, bgeoNumCaptureNodes(bgeo), bgeoCaptureNodePath);
+}
+
+static void info_bclip(InfoLine& line, const HBIN_CLIP& clip) {
+	line.put(", \"type\" : \"clip\"");
+	line.put(", \"fps\" : %f, \"start\" : %f", clip.rate, clip.start);
+	line.put(", \"frames\" : %d, \"tracks\" : %d", clip.nsmp, clip.ntrk);
+}
+
+static void info_file(InfoLine& line, const char* pPath) {
+	line.put("{\"path\" : ");
+	line.str(pPath);
+	InfoFile file;
+	if (file.open(pPath)) {
+		line.put(", \"size\" : %.0f", double(file.size));
+		if (file.size > 0x29 && bgeoValid(file.pMem)) {
+			HBIN_BGEO bgeo = bgeoOpen(file.pMem, file.size);
+			if (bgeo) {
+				info_bgeo(line, bgeo);
+			} else {
+				line.put(", \"type\" : \"geo\", \"error\" : \"invalid or truncated\"");
+			}
+		} else if (file.size > 8 && bclipValid(file.pMem)) {
+			HBIN_CLIP clip;
+			if (bclipOpen(&clip, file.pMem, file.size, nullptr)) {
+				info_bclip(line, clip);
+			} else {
+				line.put(", \"type\" : \"clip\", \"error\" : \"invalid or truncated\"");
+			}
+		} else {
+			line.put(", \"type\" : \"unknown\"");
+		}
+		file.close();
+	} else {
+		line.put(", \"type\" : \"missing\"");
+	}
+	line.put("}\n");
+}
+
+void info_scan(const char** ppPaths, int npaths, FILE* pOut) {
+	if (!ppPaths || npaths <= 0) return;
+	if (pOut == nullptr) pOut = stdout;
+	InfoLine* pLines = (InfoLine*)nxCore::mem_alloc(npaths * sizeof(InfoLine), "info:lines");
+	if (!pLines) return;
+	for (int i = 0; i < npaths; ++i) {
+		pLines[i].init();
+	}
+	int nthreads = nxApp::get_int_opt("threads", 0);
+	if (nthreads <= 0) {
+		nthreads = nxCalc::max(int(std::thread::hardware_concurrency()), 1);
+	}
+	nthreads = nxCalc::min(nthreads, npaths);
+	std::atomic<int> next(0);
+	auto worker = [&]() {
+		while (true) {
+			int i = next.fetch_add(1);
+			if (i >= npaths) break;
+			info_file(pLines[i], ppPaths[i]);
+		}
+	};
+	std::vector<std::thread> threads;
+	for (int i = 1; i < nthreads; ++i) {
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (auto& thr : threads) {
+		thr.join();
+	}
+	for (int i = 0; i < npaths; ++i) {
+		if (pLines[i].pStr) {
+			::fwrite(pLines[i].pStr, 1, pLines[i].len, pOut);
+		}
+		pLines[i].reset();
+	}
+	nxCore::mem_free(pLines);
+}
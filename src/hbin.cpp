@@ -43,12 +43,36 @@ static int hbinMemCmp(const void* pMem1, const void* pMem2, const size_t len) {
 	}
 	return cmp;
 }
+static float hbinSqrtF(const float x) {
+	float r;
+	uint32_t u;
+	int i;
+	if (!(x > 0.0f)) return 0.0f;
+	hbinMemCpy(&u, &x, sizeof(float));
+	u = 0x1FBD1DF5 + (u >> 1);
+	hbinMemCpy(&r, &u, sizeof(float));
+	for (i = 0; i < 4; ++i) {
+		r = 0.5f * (r + (x / r));
+	}
+	return r;
+}
+static float hbinAcosF(const float x) {
+	/* Abramowitz & Stegun 4.4.45, |error| < 7e-5 */
+	float a = x < 0.0f ? -x : x;
+	float r;
+	if (a > 1.0f) a = 1.0f;
+	r = hbinSqrtF(1.0f - a) * (1.5707288f + (a * (-0.2121144f + (a * (0.0742610f - (a * 0.0187293f))))));
+	return x < 0.0f ? 3.14159265f - r : r;
+}
 #else
 #include <string.h>
 #include <stdio.h>
+#include <math.h>
 #define hbinStrLen strlen
 #define hbinMemCpy memcpy
 #define hbinMemCmp memcmp
+#define hbinSqrtF sqrtf
+#define hbinAcosF acosf
 #endif
 
 enum HBIN_PRIMTYPE {
@@ -126,6 +150,72 @@ static double hbinF64(const uint8_t* pMem) {
 	return d;
 }
 
+static int hbinHostLE(void) {
+	uint32_t u = 1;
+	uint8_t b;
+	hbinMemCpy(&b, &u, 1);
+	return b == 1;
+}
+
+/* byte-wise so that the loop can be vectorized regardless of alignment */
+static void hbinSwap32(uint8_t* pMem, const size_t nwords) {
+	size_t i;
+	for (i = 0; i < nwords; ++i) {
+		uint8_t* p = pMem + (i * 4);
+		uint8_t b0 = p[0];
+		uint8_t b1 = p[1];
+		p[0] = p[3];
+		p[1] = p[2];
+		p[2] = b1;
+		p[3] = b0;
+	}
+}
+
+static void hbinSwap64(uint8_t* pMem, const size_t nwords) {
+	size_t i;
+	int j;
+	for (i = 0; i < nwords; ++i) {
+		uint8_t* p = pMem + (i * 8);
+		for (j = 0; j < 4; ++j) {
+			uint8_t b = p[j];
+			p[j] = p[7 - j];
+			p[7 - j] = b;
+		}
+	}
+}
+
+/* payload values, hostOrder: converted in place by bgeoNormalize/bclipNormalize */
+static uint32_t hbinRecU32(const uint8_t* pMem, const int hostOrder) {
+	uint32_t u;
+	if (hostOrder) {
+		hbinMemCpy(&u, pMem, sizeof(uint32_t));
+	} else {
+		u = hbinU32(pMem);
+	}
+	return u;
+}
+
+static int32_t hbinRecI32(const uint8_t* pMem, const int hostOrder) {
+	return (int32_t)hbinRecU32(pMem, hostOrder);
+}
+
+static float hbinRecF32(const uint8_t* pMem, const int hostOrder) {
+	float f;
+	uint32_t u = hbinRecU32(pMem, hostOrder);
+	hbinMemCpy(&f, &u, sizeof(float));
+	return f;
+}
+
+static double hbinRecF64(const uint8_t* pMem, const int hostOrder) {
+	double d;
+	if (hostOrder) {
+		hbinMemCpy(&d, pMem, sizeof(double));
+	} else {
+		d = hbinF64(pMem);
+	}
+	return d;
+}
+
 HBIN_IFC(HBIN_STRING, NameFromPath)(HBIN_STRING path) {
 	HBIN_STRING name;
 	name.pChars = NULL;
@@ -192,7 +282,7 @@ HBIN_BGEO_IFC(int, Valid)(const HBIN_BGEO bgeo) {
 		static const char* pSig = "Bgeo";
 		const uint8_t* pTop = (const uint8_t*)bgeo;
 		if (hbinMemCmp(pTop, pSig, 4) == 0) {
-			if (pTop[4] == 'V') {
+			if (pTop[4] == 'V' || pTop[4] == 'v') {
 				valid = 1;
 			}
 		}
@@ -200,7 +290,12 @@ HBIN_BGEO_IFC(int, Valid)(const HBIN_BGEO bgeo) {
 	return valid;
 }
 
-static int32_t bgeoI32(const HBIN_BGEO bgeo, const uint32_t offs) {
+/* 'v': attribute values (point, vertex, primitive and detail records) are in host order, see bgeoNormalize */
+static int bgeoHostOrder(const HBIN_BGEO bgeo) {
+	return ((const uint8_t*)bgeo)[4] == 'v';
+}
+
+static int32_t bgeoI32(const HBIN_BGEO bgeo, const size_t offs) {
 	int32_t val = -1;
 	if (HBIN_BGEO_FN(Valid)(bgeo)) {
 		const uint8_t* pTop = (const uint8_t*)bgeo;
@@ -219,7 +314,7 @@ HBIN_BGEO_IFC(int32_t, NumVertexAttrs)(const HBIN_BGEO bgeo) { return bgeoI32(bg
 HBIN_BGEO_IFC(int32_t, NumPrimAttrs)(const HBIN_BGEO bgeo) { return bgeoI32(bgeo, 0x21); }
 HBIN_BGEO_IFC(int32_t, NumDetailAttrs)(const HBIN_BGEO bgeo) { return bgeoI32(bgeo, 0x25); }
 
-static int32_t bgeoCalcItemRecSize(const HBIN_BGEO bgeo, const int32_t nattr, const uint32_t offs, const int32_t stdRecSize, const uint8_t** ppNext) {
+static int32_t bgeoCalcItemRecSize(const HBIN_BGEO bgeo, const int32_t nattr, const size_t offs, const int32_t stdRecSize, const uint8_t** ppNext) {
 	int32_t recSize = 0;
 	const uint8_t* pTop = (const uint8_t*)bgeo;
 	const uint8_t* pAttrDescr = pTop + offs;
@@ -283,11 +378,13 @@ static int32_t bgeoCalcItemRecSize(const HBIN_BGEO bgeo, const int32_t nattr, co
 					}
 					defValSize = attrValSize;
 				}
-				if (defValSize) {
+				if (defValSize || attrType == 4) {
 					pAttrDescr += defValSize;
 					recSize += attrValSize;
 				} else {
+					/* size unknown: nothing after this descriptor can be located */
 					recSize = 0;
+					pAttrDescr = NULL;
 					break;
 				}
 			}
@@ -307,20 +404,42 @@ static int32_t bgeoCalcPntRecSize(const HBIN_BGEO bgeo, const uint8_t** ppPtsTop
 
 HBIN_BGEO_IFC(void, PointPos)(HBIN_FLOAT3 pos, const HBIN_BGEO bgeo, const int32_t pntId) {
 	int32_t npts = HBIN_BGEO_FN(NumPoints)(bgeo);
-	if (npts > 0 && (uint32_t)pntId < (uint32_t)npts) {
+	if (npts > 0 && pntId >= 0 && pntId < npts) {
 		const uint8_t* pPts = NULL;
 		int32_t recSize = bgeoCalcPntRecSize(bgeo, &pPts);
 		if (recSize > 0 && pPts) {
 			int i;
-			const uint8_t* pPntRec = pPts + (pntId * recSize);
+			int hostOrder = bgeoHostOrder(bgeo);
+			const uint8_t* pPntRec = pPts + ((size_t)pntId * (size_t)recSize);
 			for (i = 0; i < 3; ++i) {
-				pos[i] = hbinF32(pPntRec + (i * 4));
+				pos[i] = hbinRecF32(pPntRec + (i * 4), hostOrder);
+			}
+		}
+	}
+}
+
+HBIN_BGEO_IFC(int32_t, GetPointPositions)(const HBIN_BGEO bgeo, HBIN_FLOAT3* pPos) {
+	int32_t i, j;
+	int32_t npts = HBIN_BGEO_FN(NumPoints)(bgeo);
+	if (npts > 0 && pPos) {
+		const uint8_t* pPts = NULL;
+		int32_t recSize = bgeoCalcPntRecSize(bgeo, &pPts);
+		if (recSize > 0 && pPts) {
+			int hostOrder = bgeoHostOrder(bgeo);
+			for (i = 0; i < npts; ++i) {
+				const uint8_t* pPntRec = pPts + ((size_t)i * (size_t)recSize);
+				for (j = 0; j < 3; ++j) {
+					pPos[i][j] = hbinRecF32(pPntRec + (j * 4), hostOrder);
+				}
 			}
+		} else {
+			npts = 0;
 		}
 	}
+	return npts > 0 ? npts : 0;
 }
 
-static HBIN_STRING bgeoFindAttrName(const HBIN_BGEO bgeo, const int nattr, const uint32_t offs, const int32_t stdRecSize, const int iattr) {
+static HBIN_STRING bgeoFindAttrName(const HBIN_BGEO bgeo, const int nattr, const size_t offs, const int32_t stdRecSize, const int iattr) {
 	HBIN_STRING name;
 	name.pChars = NULL;
 	name.len = 0;
@@ -401,7 +520,7 @@ static HBIN_STRING bgeoFindAttrName(const HBIN_BGEO bgeo, const int nattr, const
 	return name;
 }
 
-static int32_t bgeoFindAttrInfo(const HBIN_BGEO bgeo, const int nattr, const uint32_t offs, const int32_t stdRecSize, const char* pName, HBIN_STRING* pBinName, int32_t* pValOffs, int32_t* pType, int32_t* pSize, const uint8_t** ppDescr) {
+static int32_t bgeoFindAttrInfo(const HBIN_BGEO bgeo, const int nattr, const size_t offs, const int32_t stdRecSize, const char* pName, HBIN_STRING* pBinName, int32_t* pValOffs, int32_t* pType, int32_t* pSize, const uint8_t** ppDescr) {
 	int32_t attrId = -1;
 	size_t nameLen = 0;
 	if (pName) {
@@ -511,6 +630,12 @@ static int32_t bgeoFindAttrInfo(const HBIN_BGEO bgeo, const int nattr, const uin
 	return attrId;
 }
 
+HBIN_BGEO_IFC(int32_t, FindPointAttr)(const HBIN_BGEO bgeo, const char* pAttrName) {
+	int32_t nattr = HBIN_BGEO_FN(NumPoints)(bgeo) > 0 ? HBIN_BGEO_FN(NumPointAttrs)(bgeo) : 0;
+	if (nattr <= 0 || !pAttrName) return -1;
+	return bgeoFindAttrInfo(bgeo, nattr, 0x29, 4 * 4, pAttrName, NULL, NULL, NULL, NULL, NULL);
+}
+
 HBIN_BGEO_IFC(void, PointNrm)(HBIN_FLOAT3 nrm, const HBIN_BGEO bgeo, const int32_t pntId) {
 	HBIN_BGEO_FN(PointVecAttr)(nrm, bgeo, "N", pntId);
 }
@@ -523,6 +648,28 @@ HBIN_BGEO_IFC(void, PointUVW)(HBIN_FLOAT3 uvw, const HBIN_BGEO bgeo, const int32
 	HBIN_BGEO_FN(PointVecAttr)(uvw, bgeo, "uv", pntId);
 }
 
+static void bgeoVecVal(HBIN_FLOAT3 vec, const uint8_t* pVal, const int32_t attrType, const int32_t attrSize, const int hostOrder) {
+	int32_t i;
+	int nelem = 0;
+	if (attrType == 5) {
+		nelem = 3;
+	} else if (attrType == 0 || attrType == 1) {
+		nelem = attrSize;
+		if (nelem > 3) {
+			nelem = 3;
+		}
+	}
+	if (attrType == 1) {
+		for (i = 0; i < nelem; ++i) {
+			vec[i] = (float)hbinRecI32(pVal + (i * 4), hostOrder);
+		}
+	} else {
+		for (i = 0; i < nelem; ++i) {
+			vec[i] = hbinRecF32(pVal + (i * 4), hostOrder);
+		}
+	}
+}
+
 HBIN_BGEO_IFC(void, PointUV)(HBIN_FLOAT2 uv, const HBIN_BGEO bgeo, const int32_t pntId) {
 	HBIN_FLOAT3 uvw;
 	HBIN_BGEO_FN(PointVecAttr)(uvw, bgeo, "uv", pntId);
@@ -537,7 +684,7 @@ HBIN_BGEO_IFC(void, PointVecAttr)(HBIN_FLOAT3 vec, const HBIN_BGEO bgeo, const c
 	for (i = 0; i < 3; ++i) {
 		vec[i] = 0.0f;
 	}
-	if (nattr && (unsigned)pntId < (unsigned)npts) {
+	if (nattr && pntId >= 0 && pntId < npts) {
 		int32_t valOffs = 0;
 		int32_t attrType = 0;
 		int32_t attrSize = 0;
@@ -547,25 +694,7 @@ HBIN_BGEO_IFC(void, PointVecAttr)(HBIN_FLOAT3 vec, const HBIN_BGEO bgeo, const c
 			int32_t recSize = bgeoCalcPntRecSize(bgeo, &pPts);
 			attrType &= 0xFFFF;
 			if (recSize > 0 && pPts) {
-				const uint8_t* pVal = pPts + (pntId * recSize) + valOffs;
-				int nelem = 0;
-				if (attrType == 5) {
-					nelem = 3;
-				} else if (attrType == 0 || attrType == 1) {
-					nelem = attrSize;
-					if (nelem > 3) {
-						nelem = 3;
-					}
-				}
-				if (attrType == 1) {
-					for (i = 0; i < nelem; ++i) {
-						vec[i] = (float)hbinI32(pVal + (i * 4));
-					}
-				} else {
-					for (i = 0; i < nelem; ++i) {
-						vec[i] = hbinF32(pVal + (i * 4));
-					}
-				}
+				bgeoVecVal(vec, pPts + ((size_t)pntId * (size_t)recSize) + valOffs, attrType, attrSize, bgeoHostOrder(bgeo));
 			}
 		}
 	}
@@ -596,8 +725,8 @@ HBIN_BGEO_IFC(HBIN_STRING, PointStrAttr)(const HBIN_BGEO bgeo, const char* pAttr
 			attrType &= 0xFFFF;
 			if (recSize > 0 && pPts) {
 				const uint8_t* pStrs;
-				const uint8_t* pVal = pPts + (pntId * recSize) + valOffs;
-				int32_t strId = hbinI32(pVal);
+				const uint8_t* pVal = pPts + ((size_t)pntId * (size_t)recSize) + valOffs;
+				int32_t strId = hbinRecI32(pVal, bgeoHostOrder(bgeo));
 				int32_t nstrs = hbinI32(pDescr);
 				pDescr += 4;
 				pStrs = pDescr;
@@ -660,7 +789,7 @@ HBIN_BGEO_IFC(int32_t, FindPointByStrAttr)(const HBIN_BGEO bgeo, const char* pAt
 					pStrs += strSize;
 				}
 				for (i = 0; i < npts; ++i) {
-					int32_t strId = hbinI32(pVal);
+					int32_t strId = hbinRecI32(pVal, bgeoHostOrder(bgeo));
 					if (strId == strValId) {
 						pntId = i;
 						break;
@@ -738,6 +867,10 @@ HBIN_BGEO_IFC(int, PointAttrIsStr)(const HBIN_BGEO bgeo, const int32_t attrId) {
 	return res;
 }
 
+static int32_t bgeoIdxSize(const int32_t npts) {
+	return npts > 0xFFFF ? 4 : 2;
+}
+
 static int bgeoCountTrisCB(const HBIN_PRIM prim, void* pUserData) {
 	int32_t* pCnt = (int32_t*)pUserData;
 	if (!pCnt) return 0;
@@ -751,10 +884,14 @@ static int bgeoCountTrisCB(const HBIN_PRIM prim, void* pUserData) {
 }
 
 HBIN_BGEO_IFC(int32_t, CountTriangles)(const HBIN_BGEO bgeo) {
+	return HBIN_BGEO_FN(CountTrianglesInGroup)(bgeo, NULL);
+}
+
+HBIN_BGEO_IFC(int32_t, CountTrianglesInGroup)(const HBIN_BGEO bgeo, const uint32_t* pPrimBits) {
 	int32_t ntri = 0;
 	int32_t nprim = HBIN_BGEO_FN(NumPrims)(bgeo);
 	if (nprim > 0) {
-		HBIN_BGEO_FN(ForEachPrim)(bgeo, bgeoCountTrisCB, &ntri);
+		HBIN_BGEO_FN(ForEachPrimInGroup)(bgeo, pPrimBits, bgeoCountTrisCB, &ntri);
 	}
 	return ntri;
 }
@@ -769,10 +906,14 @@ static int bgeoCountPolsCB(const HBIN_PRIM prim, void* pUserData) {
 }
 
 HBIN_BGEO_IFC(int32_t, CountPolygons)(const HBIN_BGEO bgeo) {
+	return HBIN_BGEO_FN(CountPolygonsInGroup)(bgeo, NULL);
+}
+
+HBIN_BGEO_IFC(int32_t, CountPolygonsInGroup)(const HBIN_BGEO bgeo, const uint32_t* pPrimBits) {
 	int32_t npol = 0;
 	int32_t nprim = HBIN_BGEO_FN(NumPrims)(bgeo);
 	if (nprim > 0) {
-		HBIN_BGEO_FN(ForEachPrim)(bgeo, bgeoCountPolsCB, &npol);
+		HBIN_BGEO_FN(ForEachPrimInGroup)(bgeo, pPrimBits, bgeoCountPolsCB, &npol);
 	}
 	return npol;
 }
@@ -781,9 +922,9 @@ typedef struct _HBIN_PRIM_S {
 	const uint8_t* pTop;
 	const uint8_t* pRec;
 	const uint8_t* pIdx;
-	uint32_t vtxAttrsOffs;
-	uint32_t primAttrsOffs;
-	uint32_t primRecsOffs;
+	size_t vtxAttrsOffs;
+	size_t primAttrsOffs;
+	size_t primRecsOffs;
 	int32_t vtxAttrsRecSize;
 	int32_t primAttrsRecSize;
 	int32_t idxSize;
@@ -794,6 +935,16 @@ typedef struct _HBIN_PRIM_S {
 	int32_t id;
 } HBIN_PRIM_S;
 
+static const uint8_t* bgeoPrimAttrsRec(const HBIN_PRIM_S* pPrim) {
+	const uint8_t* pRec = NULL;
+	if (pPrim->type == HBIN_PRIMTYPE_Poly) {
+		pRec = pPrim->pIdx + ((pPrim->idxSize + pPrim->vtxAttrsRecSize) * pPrim->nvtx);
+	} else if (pPrim->type == HBIN_PRIMTYPE_Sphere) {
+		pRec = pPrim->pIdx + pPrim->idxSize + (3 * 3 * 4) + pPrim->vtxAttrsRecSize;
+	}
+	return pRec;
+}
+
 static const uint8_t* bgeoForEachPrimImpl(const HBIN_BGEO bgeo, HBIN_PRIM_CB callback, void* pUserData) {
 	const uint8_t* pPrim = NULL;
 	int nprim = HBIN_BGEO_FN(NumPrims)(bgeo);
@@ -810,25 +961,26 @@ static const uint8_t* bgeoForEachPrimImpl(const HBIN_BGEO bgeo, HBIN_PRIM_CB cal
 		int cont = 1;
 		int32_t mtlValOffs = -1;
 		int32_t type = 0;
+		int hostOrder = bgeoHostOrder(bgeo);
 		prim.pTop = pTop;
 		prim.vtxAttrsOffs = 0;
 		prim.primAttrsOffs = 0;
-		prim.primRecsOffs = pPts ? (uint32_t)(pPts + (npts * pntRecSize) - pTop) : 0x29;
+		prim.primRecsOffs = pPts ? (size_t)(pPts + ((size_t)npts * (size_t)pntRecSize) - pTop) : 0;
 		prim.vtxAttrsRecSize = 0;
 		prim.primAttrsRecSize = 0;
-		prim.idxSize = npts > 0xFFFF ? 4 : 2;
+		prim.idxSize = bgeoIdxSize(npts);
 		prim.recSize = 0;
-		if (nattrVtx) {
+		if (nattrVtx && prim.primRecsOffs) {
 			const uint8_t* pNext = NULL;
 			prim.vtxAttrsOffs = prim.primRecsOffs;
 			prim.vtxAttrsRecSize = bgeoCalcItemRecSize(bgeo, nattrVtx, prim.vtxAttrsOffs, 0, &pNext);
-			prim.primRecsOffs = (uint32_t)(pNext - pTop);
+			prim.primRecsOffs = pNext ? (size_t)(pNext - pTop) : 0;
 		}
-		if (nattr) {
+		if (nattr && prim.primRecsOffs) {
 			const uint8_t* pNext = NULL;
 			prim.primAttrsOffs = prim.primRecsOffs;
 			prim.primAttrsRecSize = bgeoCalcItemRecSize(bgeo, nattr, prim.primAttrsOffs, 0, &pNext);
-			prim.primRecsOffs = (uint32_t)(pNext - pTop);
+			prim.primRecsOffs = pNext ? (size_t)(pNext - pTop) : 0;
 		}
 		if (prim.primAttrsOffs) {
 			int32_t valOffs = 0;
@@ -839,8 +991,9 @@ static const uint8_t* bgeoForEachPrimImpl(const HBIN_BGEO bgeo, HBIN_PRIM_CB cal
 				mtlValOffs = valOffs;
 			}
 		}
-		pPrim = pTop + prim.primRecsOffs;
-		while (cont && iprim < nprim) {
+		/* records that follow an attribute of unknown size are not walked */
+		pPrim = prim.primRecsOffs ? pTop + prim.primRecsOffs : NULL;
+		while (pPrim && cont && iprim < nprim) {
 			int isRun = 0;
 			if (runLen <= 0) {
 				type = hbinI32(pPrim);
@@ -874,7 +1027,7 @@ static const uint8_t* bgeoForEachPrimImpl(const HBIN_BGEO bgeo, HBIN_PRIM_CB cal
 				prim.pIdx = prim.pRec + 4 + 1;
 				prim.recSize = 4 + 1 + (prim.idxSize * nvtx) + (prim.vtxAttrsRecSize * nvtx) + prim.primAttrsRecSize;
 				if (mtlValOffs >= 0) {
-					prim.mtlId = hbinI32(prim.pIdx + ((prim.idxSize + prim.vtxAttrsRecSize) * nvtx) + mtlValOffs);
+					prim.mtlId = hbinRecI32(bgeoPrimAttrsRec(&prim) + mtlValOffs, hostOrder);
 				}
 				cont = callback ? callback(&prim, pUserData) : 1;
 				pPrim += prim.recSize;
@@ -886,7 +1039,7 @@ static const uint8_t* bgeoForEachPrimImpl(const HBIN_BGEO bgeo, HBIN_PRIM_CB cal
 				prim.pIdx = prim.pRec;
 				prim.recSize = prim.idxSize + (3 * 3 * 4) + prim.vtxAttrsRecSize + prim.primAttrsRecSize;
 				if (mtlValOffs >= 0) {
-					prim.mtlId = hbinI32(prim.pIdx + prim.idxSize + (3 * 3 * 4) + prim.vtxAttrsRecSize + mtlValOffs);
+					prim.mtlId = hbinRecI32(bgeoPrimAttrsRec(&prim) + mtlValOffs, hostOrder);
 				}
 				cont = callback ? callback(&prim, pUserData) : 1;
 				pPrim += prim.recSize;
@@ -904,6 +1057,39 @@ HBIN_BGEO_IFC(void, ForEachPrim)(const HBIN_BGEO bgeo, HBIN_PRIM_CB callback, vo
 	bgeoForEachPrimImpl(bgeo, callback, pUserData);
 }
 
+typedef struct _BGEO_GRP_FILTER_WK {
+	const uint32_t* pBits;
+	HBIN_PRIM_CB callback;
+	void* pUserData;
+} BGEO_GRP_FILTER_WK;
+
+static int bgeoGrpFilterCB(const HBIN_PRIM prim, void* pUserData) {
+	BGEO_GRP_FILTER_WK* pWk = (BGEO_GRP_FILTER_WK*)pUserData;
+	int32_t id = ((const HBIN_PRIM_S*)prim)->id;
+	if (pWk->pBits[id >> 5] & (1U << (id & 31))) {
+		return pWk->callback(prim, pWk->pUserData);
+	}
+	return 1;
+}
+
+HBIN_BGEO_IFC(void, ForEachPrimInGroup)(const HBIN_BGEO bgeo, const uint32_t* pPrimBits, HBIN_PRIM_CB callback, void* pUserData) {
+	if (!callback) return;
+	if (pPrimBits) {
+		BGEO_GRP_FILTER_WK wk;
+		wk.pBits = pPrimBits;
+		wk.callback = callback;
+		wk.pUserData = pUserData;
+		bgeoForEachPrimImpl(bgeo, bgeoGrpFilterCB, &wk);
+	} else {
+		bgeoForEachPrimImpl(bgeo, callback, pUserData);
+	}
+}
+
+HBIN_BGEO_IFC(int32_t, PrimId)(const HBIN_PRIM prim) {
+	const HBIN_PRIM_S* pPrim = (const HBIN_PRIM_S*)prim;
+	return pPrim ? pPrim->id : -1;
+}
+
 HBIN_BGEO_IFC(const HBIN_BGEO, PrimBgeo)(const HBIN_PRIM prim) {
 	const HBIN_PRIM_S* pPrim = (const HBIN_PRIM_S*)prim;
 	return (pPrim ? (const HBIN_BGEO)pPrim->pTop : NULL);
@@ -944,475 +1130,4450 @@ HBIN_BGEO_IFC(int32_t, PrimMaterialId)(const HBIN_PRIM prim) {
 	return pPrim ? pPrim->mtlId : -1;
 }
 
-HBIN_BGEO_IFC(int32_t, NumMaterials)(const HBIN_BGEO bgeo) {
-	int32_t nmtl = 0;
-	int32_t nattr = HBIN_BGEO_FN(NumPrimAttrs)(bgeo);
-	if (nattr > 0) {
+static size_t bgeoVtxAttrsOffs(const HBIN_BGEO bgeo) {
+	size_t offs = 0;
+	if (HBIN_BGEO_FN(NumVertexAttrs)(bgeo) > 0) {
 		int npts = HBIN_BGEO_FN(NumPoints)(bgeo);
 		const uint8_t* pPts = NULL;
 		int32_t pntRecSize = bgeoCalcPntRecSize(bgeo, &pPts);
-		int nattrVtx = HBIN_BGEO_FN(NumVertexAttrs)(bgeo);
-		const uint8_t* pTop = (const uint8_t*)bgeo;
-		uint32_t attrsOffs = pPts ? (uint32_t)(pPts + (npts * pntRecSize) - pTop) : 0x29;
-		if (nattrVtx) {
-			const uint8_t* pNext = NULL;
-			bgeoCalcItemRecSize(bgeo, nattrVtx, attrsOffs, 0, &pNext);
-			attrsOffs = (uint32_t)(pNext - pTop);
+		offs = pPts ? (size_t)(pPts + ((size_t)npts * (size_t)pntRecSize) - (const uint8_t*)bgeo) : 0;
+	}
+	return offs;
+}
+
+HBIN_BGEO_IFC(HBIN_STRING, VertexAttrName)(const HBIN_BGEO bgeo, const int32_t attrId) {
+	HBIN_STRING name;
+	name.pChars = NULL;
+	name.len = 0;
+	if (bgeo) {
+		size_t offs = bgeoVtxAttrsOffs(bgeo);
+		if (offs) {
+			name = bgeoFindAttrName(bgeo, HBIN_BGEO_FN(NumVertexAttrs)(bgeo), offs, 0, attrId);
 		}
-		if (attrsOffs) {
-			int32_t valOffs = 0;
-			int32_t attrType = 0;
-			int32_t attrSize = 0;
-			const uint8_t* pDescr = NULL;
-			int32_t attrId = bgeoFindAttrInfo(bgeo, nattr, attrsOffs, 0, s_pBgeoMtlAttrName, NULL, &valOffs, &attrType, &attrSize, &pDescr);
-			if (attrId >= 0 && attrType == 4 && pDescr) {
-				nmtl = hbinI32(pDescr);
-				if (nmtl < 0) {
-					nmtl = 0;
-				}
-			}
+	}
+	return name;
+}
+
+HBIN_BGEO_IFC(int32_t, FindVertexAttr)(const HBIN_BGEO bgeo, const char* pAttrName) {
+	int32_t attrId = -1;
+	size_t offs = bgeo ? bgeoVtxAttrsOffs(bgeo) : 0;
+	if (offs && pAttrName) {
+		attrId = bgeoFindAttrInfo(bgeo, HBIN_BGEO_FN(NumVertexAttrs)(bgeo), offs, 0, pAttrName, NULL, NULL, NULL, NULL, NULL);
+	}
+	return attrId;
+}
+
+HBIN_BGEO_IFC(int, VertexAttrIsVec)(const HBIN_BGEO bgeo, const int32_t attrId) {
+	int res = 0;
+	HBIN_STRING name = HBIN_BGEO_FN(VertexAttrName)(bgeo, attrId);
+	if (name.pChars && name.len > 0) {
+		int32_t attrType = 0;
+		int32_t attrSize = 0;
+		if (bgeoFindAttrInfo(bgeo, HBIN_BGEO_FN(NumVertexAttrs)(bgeo), bgeoVtxAttrsOffs(bgeo), 0, NULL, &name, NULL, &attrType, &attrSize, NULL) >= 0) {
+			attrType &= 0xFFFF;
+			res = attrType == 5 || ((attrType == 0 || attrType == 1) && attrSize >= 1);
 		}
 	}
-	return nmtl;
+	return res;
 }
 
-HBIN_BGEO_IFC(HBIN_STRING, MaterialPath)(const HBIN_BGEO bgeo, const int32_t mtlId) {
-	int32_t nmtl = 0;
-	int32_t nattr = HBIN_BGEO_FN(NumPrimAttrs)(bgeo);
-	HBIN_STRING path;
-	path.pChars = NULL;
-	path.len = 0;
-	if (nattr > 0 && mtlId >= 0) {
+HBIN_BGEO_IFC(void, PrimVertexVecAttr)(HBIN_FLOAT3 vec, const HBIN_PRIM prim, const char* pAttrName, const int32_t vtxId) {
+	const HBIN_PRIM_S* pPrim = (const HBIN_PRIM_S*)prim;
+	vec[0] = 0.0f;
+	vec[1] = 0.0f;
+	vec[2] = 0.0f;
+	if (pPrim && pPrim->pIdx && pPrim->vtxAttrsOffs && (uint32_t)vtxId < (uint32_t)pPrim->nvtx) {
+		const HBIN_BGEO bgeo = (HBIN_BGEO)pPrim->pTop;
+		int32_t valOffs = 0;
+		int32_t attrType = 0;
+		int32_t attrSize = 0;
+		int32_t attrId = bgeoFindAttrInfo(bgeo, HBIN_BGEO_FN(NumVertexAttrs)(bgeo), pPrim->vtxAttrsOffs, 0, pAttrName, NULL, &valOffs, &attrType, &attrSize, NULL);
+		if (attrId >= 0) {
+			const uint8_t* pRec = pPrim->pIdx + (vtxId * (pPrim->idxSize + pPrim->vtxAttrsRecSize)) + pPrim->idxSize;
+			bgeoVecVal(vec, pRec + valOffs, attrType & 0xFFFF, attrSize, bgeoHostOrder(bgeo));
+		}
+	}
+}
+
+static size_t bgeoPrimAttrsOffs(const HBIN_BGEO bgeo) {
+	size_t offs = 0;
+	if (HBIN_BGEO_FN(NumPrimAttrs)(bgeo) > 0) {
 		int npts = HBIN_BGEO_FN(NumPoints)(bgeo);
 		const uint8_t* pPts = NULL;
 		int32_t pntRecSize = bgeoCalcPntRecSize(bgeo, &pPts);
 		int nattrVtx = HBIN_BGEO_FN(NumVertexAttrs)(bgeo);
 		const uint8_t* pTop = (const uint8_t*)bgeo;
-		uint32_t attrsOffs = pPts ? (uint32_t)(pPts + (npts * pntRecSize) - pTop) : 0x29;
-		if (nattrVtx) {
+		offs = pPts ? (size_t)(pPts + ((size_t)npts * (size_t)pntRecSize) - pTop) : 0;
+		if (nattrVtx && offs) {
 			const uint8_t* pNext = NULL;
-			bgeoCalcItemRecSize(bgeo, nattrVtx, attrsOffs, 0, &pNext);
-			attrsOffs = (uint32_t)(pNext - pTop);
-		}
-		if (attrsOffs) {
-			int32_t valOffs = 0;
-			int32_t attrType = 0;
-			int32_t attrSize = 0;
-			const uint8_t* pDescr = NULL;
-			int32_t attrId = bgeoFindAttrInfo(bgeo, nattr, attrsOffs, 0, s_pBgeoMtlAttrName, NULL, &valOffs, &attrType, &attrSize, &pDescr);
-			if (attrId >= 0 && attrType == 4 && pDescr) {
-				nmtl = hbinI32(pDescr);
-				if (nmtl > 0) {
-					pDescr += 4;
-					if ((uint32_t)mtlId < (uint32_t)nmtl) {
-						int32_t i;
-						int32_t len = 0;
-						for (i = 0; i <= mtlId; ++i) {
-							len = hbinI16(pDescr);
-							pDescr += 2;
-							if (len < 0) {
-								len = hbinI32(pDescr);
-								pDescr += 4;
-							}
-							path.pChars = (const char*)pDescr;
-							pDescr += len;
-						}
-						path.len = len;
-					}
-				}
-			}
-		}
-	}
-	return path;
-}
-
-static const uint8_t* bgeoDetailAttrsTop(const HBIN_BGEO bgeo) {
-	const uint8_t* pAttrs = NULL;
-	int32_t nattr = HBIN_BGEO_FN(NumDetailAttrs)(bgeo);
-	if (nattr > 0) {
-		int32_t npts = HBIN_BGEO_FN(NumPoints)(bgeo);
-		int32_t nprims = HBIN_BGEO_FN(NumPrims)(bgeo);
-		int nattrPnt = HBIN_BGEO_FN(NumPointAttrs)(bgeo);
-		int nattrVtx = HBIN_BGEO_FN(NumVertexAttrs)(bgeo);
-		int nattrPrim = HBIN_BGEO_FN(NumPrimAttrs)(bgeo);
-		if (npts == 0 && nprims == 0 && nattrPnt == 0 && nattrVtx == 0 && nattrPrim == 0) {
-			const uint8_t* pTop = (const uint8_t*)bgeo;
-			pAttrs = pTop + 0x29;
-		} else {
-			pAttrs = bgeoForEachPrimImpl(bgeo, NULL, NULL);
+			bgeoCalcItemRecSize(bgeo, nattrVtx, offs, 0, &pNext);
+			offs = pNext ? (size_t)(pNext - pTop) : 0;
 		}
 	}
-	return pAttrs;
+	return offs;
 }
 
-HBIN_BGEO_IFC(HBIN_STRING, DetailStrAttr)(const HBIN_BGEO bgeo, const char* pAttrName) {
-	const uint8_t* pAttrs = NULL;
+/* pDescr: index attribute descriptor (string count followed by the strings) */
+static HBIN_STRING bgeoStrTableEntry(const uint8_t* pDescr, const int32_t strId) {
 	HBIN_STRING str;
+	int32_t nstrs = hbinI32(pDescr);
 	str.pChars = NULL;
 	str.len = 0;
-	pAttrs = bgeoDetailAttrsTop(bgeo);
-	if (pAttrs) {
-		const uint8_t* pTop = (const uint8_t*)bgeo;
-		uint32_t attrsOffs = (uint32_t)(pAttrs - pTop);
-		int32_t nattr = HBIN_BGEO_FN(NumDetailAttrs)(bgeo);
-		int32_t valOffs = 0;
-		int32_t attrType = 0;
-		int32_t attrSize = 0;
-		const uint8_t* pDescr = NULL;
-		int32_t attrId = bgeoFindAttrInfo(bgeo, nattr, attrsOffs, 0, pAttrName, NULL, &valOffs, &attrType, &attrSize, &pDescr);
-		if (attrId >= 0) {
-			if (attrType == 4 && attrSize > 0) {
-				int32_t nstrs = hbinI32(pDescr);
-				if (nstrs > 0) {
-					str.len = hbinI16(pDescr + 4);
-					str.pChars = (const char*)(pDescr + 6);
-				}
+	if ((uint32_t)strId < (uint32_t)nstrs) {
+		int32_t i;
+		int32_t len = 0;
+		pDescr += 4;
+		for (i = 0; i <= strId; ++i) {
+			len = hbinI16(pDescr);
+			pDescr += 2;
+			if (len < 0) {
+				len = hbinI32(pDescr);
+				pDescr += 4;
 			}
+			str.pChars = (const char*)pDescr;
+			pDescr += len;
 		}
+		str.len = len;
 	}
 	return str;
 }
 
-HBIN_BGEO_IFC(int32_t, NumCaptureNodes)(const HBIN_BGEO bgeo) {
-	int32_t n = 0;
-	const uint8_t* pAttrs = bgeoDetailAttrsTop(bgeo);
-	if (pAttrs) {
-		const uint8_t* pTop = (const uint8_t*)bgeo;
-		uint32_t attrsOffs = (uint32_t)(pAttrs - pTop);
-		int32_t nattr = HBIN_BGEO_FN(NumDetailAttrs)(bgeo);
-		int32_t valOffs = 0;
+HBIN_BGEO_IFC(int32_t, NumMaterials)(const HBIN_BGEO bgeo) {
+	int32_t nmtl = 0;
+	size_t attrsOffs = bgeoPrimAttrsOffs(bgeo);
+	if (attrsOffs) {
 		int32_t attrType = 0;
-		int32_t attrSize = 0;
 		const uint8_t* pDescr = NULL;
-		int32_t attrId = bgeoFindAttrInfo(bgeo, nattr, attrsOffs, 0, s_pBgeoCaptPathName, NULL, &valOffs, &attrType, &attrSize, &pDescr);
-		if (attrId >= 0) {
-			if (attrType == 4 && attrSize > 0) {
-				n = hbinI32(pDescr);
+		int32_t attrId = bgeoFindAttrInfo(bgeo, HBIN_BGEO_FN(NumPrimAttrs)(bgeo), attrsOffs, 0, s_pBgeoMtlAttrName, NULL, NULL, &attrType, NULL, &pDescr);
+		if (attrId >= 0 && attrType == 4 && pDescr) {
+			nmtl = hbinI32(pDescr);
+			if (nmtl < 0) {
+				nmtl = 0;
 			}
 		}
 	}
-	return n;
+	return nmtl;
 }
 
-HBIN_BGEO_IFC(HBIN_STRING, CaptureNodePath)(const HBIN_BGEO bgeo, const int32_t nodeId) {
-	const uint8_t* pAttrs = bgeoDetailAttrsTop(bgeo);
+HBIN_BGEO_IFC(HBIN_STRING, MaterialPath)(const HBIN_BGEO bgeo, const int32_t mtlId) {
 	HBIN_STRING path;
+	size_t attrsOffs = mtlId >= 0 ? bgeoPrimAttrsOffs(bgeo) : 0;
 	path.pChars = NULL;
 	path.len = 0;
-	if (pAttrs && nodeId >= 0) {
-		const uint8_t* pTop = (const uint8_t*)bgeo;
-		uint32_t attrsOffs = (uint32_t)(pAttrs - pTop);
-		int32_t nattr = HBIN_BGEO_FN(NumDetailAttrs)(bgeo);
-		int32_t valOffs = 0;
+	if (attrsOffs) {
 		int32_t attrType = 0;
-		int32_t attrSize = 0;
 		const uint8_t* pDescr = NULL;
-		int32_t attrId = bgeoFindAttrInfo(bgeo, nattr, attrsOffs, 0, s_pBgeoCaptPathName, NULL, &valOffs, &attrType, &attrSize, &pDescr);
-		if (attrId >= 0) {
-			int32_t i;
-			int32_t ncap = 0;
-			int32_t len = 0;
-			if (attrType == 4 && attrSize > 0) {
-				ncap = hbinI32(pDescr);
-			}
-			if (ncap > 0 && nodeId < ncap) {
-				pDescr += 4;
-				for (i = 0; i <= nodeId; ++i) {
-					len = hbinI16(pDescr);
-					pDescr += 2;
-					if (len < 0) {
-						len = hbinI32(pDescr);
-						pDescr += 4;
-					}
-					path.pChars = (const char*)pDescr;
-					pDescr += len;
-				}
-				path.len = len;
-			}
+		int32_t attrId = bgeoFindAttrInfo(bgeo, HBIN_BGEO_FN(NumPrimAttrs)(bgeo), attrsOffs, 0, s_pBgeoMtlAttrName, NULL, NULL, &attrType, NULL, &pDescr);
+		if (attrId >= 0 && attrType == 4 && pDescr) {
+			path = bgeoStrTableEntry(pDescr, mtlId);
 		}
 	}
 	return path;
 }
 
-HBIN_BGEO_IFC(int32_t, MaxCapturesPerPoint)(const HBIN_BGEO bgeo) {
-	int32_t nwgt = 0;
-	int32_t nattr = HBIN_BGEO_FN(NumPointAttrs)(bgeo);
-	if (nattr) {
-		int32_t valOffs = 0;
-		int32_t attrType = 0;
-		int32_t attrSize = 0;
-		int32_t attrId = bgeoFindAttrInfo(bgeo, nattr, 0x29, 4 * 4, s_pBgeoCaptAttrName, NULL, &valOffs, &attrType, &attrSize, NULL);
-		if (attrId >= 0 && attrType == 0x10000) {
-			nwgt = attrSize / 2;
+static int32_t bgeoPrimAttrInfoById(const HBIN_BGEO bgeo, const int32_t attrId, int32_t* pValOffs, int32_t* pType, int32_t* pSize, const uint8_t** ppDescr) {
+	int32_t id = -1;
+	size_t attrsOffs = bgeoPrimAttrsOffs(bgeo);
+	if (attrsOffs) {
+		int32_t nattr = HBIN_BGEO_FN(NumPrimAttrs)(bgeo);
+		HBIN_STRING name = bgeoFindAttrName(bgeo, nattr, attrsOffs, 0, attrId);
+		if (name.pChars && name.len > 0) {
+			id = bgeoFindAttrInfo(bgeo, nattr, attrsOffs, 0, NULL, &name, pValOffs, pType, pSize, ppDescr);
+			if (pType) {
+				*pType &= 0xFFFF;
+			}
 		}
 	}
-	return nwgt;
+	return id;
 }
 
-HBIN_BGEO_IFC(HBIN_CAPTURE, PointCapture)(const HBIN_BGEO bgeo, const int32_t pntId, const int32_t wgtId) {
-	int32_t npts = HBIN_BGEO_FN(NumPoints)(bgeo);
-	int32_t nattr = npts > 0 ? HBIN_BGEO_FN(NumPointAttrs)(bgeo) : 0;
-	HBIN_CAPTURE capt;
-	capt.node = -1;
-	capt.wght = 0.0f;
-	if (nattr && (uint32_t)pntId < (uint32_t)npts) {
-		int32_t nwgt = 0;
-		int32_t valOffs = 0;
-		int32_t attrType = 0;
-		int32_t attrSize = 0;
-		int32_t attrId = bgeoFindAttrInfo(bgeo, nattr, 0x29, 4 * 4, s_pBgeoCaptAttrName, NULL, &valOffs, &attrType, &attrSize, NULL);
-		if (attrId >= 0 && attrType == 0x10000) {
-			nwgt = attrSize / 2;
-		}
-		if (nwgt > 0 && (uint32_t)wgtId < (uint32_t)nwgt) {
-			const uint8_t* pPts = NULL;
-			int32_t recSize = bgeoCalcPntRecSize(bgeo, &pPts);
-			if (recSize > 0 && pPts) {
-				const uint8_t* pWgt = pPts + (pntId * recSize) + valOffs + (wgtId * 8);
-				capt.node = (int32_t)hbinF32(pWgt);
-				capt.wght = hbinF32(pWgt + 4);
-			}
+HBIN_BGEO_IFC(HBIN_STRING, PrimAttrName)(const HBIN_BGEO bgeo, const int32_t attrId) {
+	HBIN_STRING name;
+	size_t attrsOffs = bgeo ? bgeoPrimAttrsOffs(bgeo) : 0;
+	name.pChars = NULL;
+	name.len = 0;
+	if (attrsOffs) {
+		name = bgeoFindAttrName(bgeo, HBIN_BGEO_FN(NumPrimAttrs)(bgeo), attrsOffs, 0, attrId);
+	}
+	return name;
+}
+
+HBIN_BGEO_IFC(int32_t, FindPrimAttr)(const HBIN_BGEO bgeo, const char* pAttrName) {
+	int32_t attrId = -1;
+	size_t attrsOffs = bgeo ? bgeoPrimAttrsOffs(bgeo) : 0;
+	if (attrsOffs && pAttrName) {
+		attrId = bgeoFindAttrInfo(bgeo, HBIN_BGEO_FN(NumPrimAttrs)(bgeo), attrsOffs, 0, pAttrName, NULL, NULL, NULL, NULL, NULL);
+	}
+	return attrId;
+}
+
+HBIN_BGEO_IFC(int32_t, PrimAttrType)(const HBIN_BGEO bgeo, const int32_t attrId) {
+	int32_t attrType = -1;
+	if (bgeoPrimAttrInfoById(bgeo, attrId, NULL, &attrType, NULL, NULL) < 0) {
+		attrType = -1;
+	}
+	return attrType;
+}
+
+HBIN_BGEO_IFC(int32_t, PrimAttrSize)(const HBIN_BGEO bgeo, const int32_t attrId) {
+	int32_t attrType = 0;
+	int32_t attrSize = 0;
+	if (bgeoPrimAttrInfoById(bgeo, attrId, NULL, &attrType, &attrSize, NULL) < 0) {
+		attrSize = 0;
+	} else if (attrType == HBIN_ATTRTYPE_VECTOR) {
+		attrSize = 3;
+	} else if (attrType == HBIN_ATTRTYPE_STRING) {
+		attrSize = 1;
+	}
+	return attrSize;
+}
+
+HBIN_BGEO_IFC(int32_t, PrimAttrNumStrs)(const HBIN_BGEO bgeo, const int32_t attrId) {
+	int32_t nstrs = 0;
+	int32_t attrType = 0;
+	const uint8_t* pDescr = NULL;
+	if (bgeoPrimAttrInfoById(bgeo, attrId, NULL, &attrType, NULL, &pDescr) >= 0 && attrType == HBIN_ATTRTYPE_STRING && pDescr) {
+		nstrs = hbinI32(pDescr);
+		if (nstrs < 0) {
+			nstrs = 0;
+		}
+	}
+	return nstrs;
+}
+
+HBIN_BGEO_IFC(HBIN_STRING, PrimAttrStr)(const HBIN_BGEO bgeo, const int32_t attrId, const int32_t strId) {
+	HBIN_STRING str;
+	int32_t attrType = 0;
+	const uint8_t* pDescr = NULL;
+	str.pChars = NULL;
+	str.len = 0;
+	if (bgeoPrimAttrInfoById(bgeo, attrId, NULL, &attrType, NULL, &pDescr) >= 0 && attrType == HBIN_ATTRTYPE_STRING && pDescr) {
+		str = bgeoStrTableEntry(pDescr, strId);
+	}
+	return str;
+}
+
+typedef struct _BGEO_PRIM_ATTR_WK {
+	int32_t valOffs;
+	int32_t size;
+	uint8_t* pDst;
+	int32_t count;
+} BGEO_PRIM_ATTR_WK;
+
+/* raw stored words only, the column is swapped (unless normalized) and converted in one pass afterwards */
+static int bgeoPrimAttrCB(const HBIN_PRIM prim, void* pUserData) {
+	int32_t i;
+	BGEO_PRIM_ATTR_WK* pWk = (BGEO_PRIM_ATTR_WK*)pUserData;
+	const uint8_t* pRec = bgeoPrimAttrsRec((const HBIN_PRIM_S*)prim);
+	uint8_t* pDst = pWk->pDst + ((size_t)pWk->count * (size_t)pWk->size * 4);
+	if (pRec) {
+		hbinMemCpy(pDst, pRec + pWk->valOffs, (size_t)pWk->size * 4);
+	} else {
+		/* no record: zeros, so that values stay indexed by primitive */
+		for (i = 0; i < pWk->size * 4; ++i) {
+			pDst[i] = 0;
+		}
+	}
+	++pWk->count;
+	return 1;
+}
+
+static void bgeoI32ToF32(void* pVals, const size_t n) {
+	size_t i;
+	for (i = 0; i < n; ++i) {
+		int32_t ival;
+		float fval;
+		hbinMemCpy(&ival, (uint8_t*)pVals + (i * 4), sizeof(int32_t));
+		fval = (float)ival;
+		hbinMemCpy((uint8_t*)pVals + (i * 4), &fval, sizeof(float));
+	}
+}
+
+/* truncates toward zero, saturates out-of-range values, NaN reads as 0 */
+static void bgeoF32ToI32(void* pVals, const size_t n) {
+	size_t i;
+	for (i = 0; i < n; ++i) {
+		float fval;
+		int32_t ival;
+		hbinMemCpy(&fval, (uint8_t*)pVals + (i * 4), sizeof(float));
+		if (fval != fval) {
+			ival = 0;
+		} else if (fval >= 2147483648.0f) {
+			ival = 0x7FFFFFFF;
+		} else if (fval <= -2147483648.0f) {
+			ival = (int32_t)(-0x7FFFFFFF - 1);
+		} else {
+			ival = (int32_t)fval;
+		}
+		hbinMemCpy((uint8_t*)pVals + (i * 4), &ival, sizeof(int32_t));
+	}
+}
+
+static int32_t bgeoGetPrimAttr(const HBIN_BGEO bgeo, const int32_t attrId, float* pFlt, int32_t* pInt) {
+	BGEO_PRIM_ATTR_WK wk;
+	int32_t type = 0;
+	int isFlt;
+	size_t nvals;
+	wk.valOffs = 0;
+	wk.size = 0;
+	wk.pDst = pFlt ? (uint8_t*)pFlt : (uint8_t*)pInt;
+	wk.count = 0;
+	if (bgeoPrimAttrInfoById(bgeo, attrId, &wk.valOffs, &type, &wk.size, NULL) < 0) return 0;
+	wk.size = HBIN_BGEO_FN(PrimAttrSize)(bgeo, attrId);
+	if (wk.size <= 0) return 0;
+	HBIN_BGEO_FN(ForEachPrim)(bgeo, bgeoPrimAttrCB, &wk);
+	nvals = (size_t)wk.count * (size_t)wk.size;
+	if (hbinHostLE() && !bgeoHostOrder(bgeo)) {
+		hbinSwap32(wk.pDst, nvals);
+	}
+	isFlt = type == HBIN_ATTRTYPE_FLOAT || type == HBIN_ATTRTYPE_VECTOR;
+	if (pFlt && !isFlt) {
+		bgeoI32ToF32(pFlt, nvals);
+	} else if (pInt && isFlt) {
+		bgeoF32ToI32(pInt, nvals);
+	}
+	return wk.count;
+}
+
+HBIN_BGEO_IFC(int32_t, GetPrimAttrFloats)(const HBIN_BGEO bgeo, const int32_t attrId, float* pVals) {
+	return pVals ? bgeoGetPrimAttr(bgeo, attrId, pVals, NULL) : 0;
+}
+
+HBIN_BGEO_IFC(int32_t, GetPrimAttrInts)(const HBIN_BGEO bgeo, const int32_t attrId, int32_t* pVals) {
+	return pVals ? bgeoGetPrimAttr(bgeo, attrId, NULL, pVals) : 0;
+}
+
+typedef struct _BGEO_GROUP_INFO {
+	HBIN_STRING name;
+	int32_t count;
+	const uint8_t* pBits;
+	int32_t norder; /* ordered groups: number of entries in pOrder, 0 otherwise */
+	const uint8_t* pOrder; /* i32 element indices in selection order */
+} BGEO_GROUP_INFO;
+
+static int bgeoGroupTypeIs(const uint8_t* pType, const int32_t len, const char* pName) {
+	return (size_t)len == hbinStrLen(pName) && hbinMemCmp(pType, pName, (size_t)len) == 0;
+}
+
+/* group record layouts by tag, in the order they are tried: the self-identifying type string first, then the flags */
+#define BGEO_GROUP_TAG_STR 0
+#define BGEO_GROUP_TAG_FLAG32 1
+#define BGEO_GROUP_TAG_FLAG8 2
+#define BGEO_GROUP_TAG_NONE 3
+#define BGEO_GROUP_NUM_TAGS 4
+
+static const uint8_t* bgeoGroupShort(int* pShort) {
+	if (pShort) {
+		*pShort = 1;
+	}
+	return NULL;
+}
+
+/*
+  group record: name, [ordered/unordered tag], number of elements, element bits packed MSB-first,
+  then for ordered groups the number of ordered entries and the entries as i32 element indices;
+  the tag is a type string, a 32/8-bit flag or absent depending on the writer (BGEO_GROUP_TAG_*);
+  structural checks come before size checks, so that a wrong layout is usually refused before it runs out of bytes;
+  avail limits the bytes read from pGrp, *pShort is set if the record doesn't fit; returns the next record or NULL
+*/
+static const uint8_t* bgeoGroupInfo(const uint8_t* pGrp, const size_t avail, const int32_t nelems, const int tag, BGEO_GROUP_INFO* pInfo, int* pShort) {
+	int32_t nameLen;
+	int32_t count;
+	int32_t ordered = 0;
+	size_t offs = 2;
+	size_t tagSize = 0;
+	size_t bitsSize;
+	size_t i;
+	if (avail < 2) return bgeoGroupShort(pShort);
+	nameLen = hbinI16(pGrp);
+	if (nameLen < 0) {
+		if (avail < 6) return bgeoGroupShort(pShort);
+		nameLen = hbinI32(pGrp + 2);
+		offs = 6;
+	}
+	if (nameLen <= 0) return NULL;
+	/* group names are printable */
+	for (i = 0; i < (size_t)nameLen; ++i) {
+		if (offs + i >= avail) return bgeoGroupShort(pShort);
+		if (pGrp[offs + i] < 0x21 || pGrp[offs + i] > 0x7E) return NULL;
+	}
+	if (pInfo) {
+		pInfo->name.pChars = (const char*)(pGrp + offs);
+		pInfo->name.len = (size_t)nameLen;
+	}
+	offs += (size_t)nameLen;
+	if (tag == BGEO_GROUP_TAG_STR) {
+		/* "ordered" / "unordered" */
+		int32_t typeLen;
+		if (avail - offs < 2) return bgeoGroupShort(pShort);
+		typeLen = hbinI16(pGrp + offs);
+		if (typeLen != 7 && typeLen != 9) return NULL;
+		if ((size_t)typeLen > avail - offs - 2) return bgeoGroupShort(pShort);
+		if (bgeoGroupTypeIs(pGrp + offs + 2, typeLen, "ordered")) {
+			ordered = 1;
+		} else if (bgeoGroupTypeIs(pGrp + offs + 2, typeLen, "unordered")) {
+			ordered = 0;
+		} else {
+			return NULL;
+		}
+		tagSize = 2 + (size_t)typeLen;
+	} else if (tag == BGEO_GROUP_TAG_FLAG32 || tag == BGEO_GROUP_TAG_FLAG8) {
+		tagSize = tag == BGEO_GROUP_TAG_FLAG32 ? 4 : 1;
+		if (avail - offs < tagSize) return bgeoGroupShort(pShort);
+		ordered = tag == BGEO_GROUP_TAG_FLAG32 ? hbinI32(pGrp + offs) : pGrp[offs];
+		if (ordered != 0 && ordered != 1) return NULL;
+	}
+	offs += tagSize;
+	if (avail - offs < 4) return bgeoGroupShort(pShort);
+	count = hbinI32(pGrp + offs);
+	if (count != nelems || count < 0) return NULL;
+	offs += 4;
+	bitsSize = ((size_t)count + 7) / 8;
+	if (bitsSize > avail - offs) return bgeoGroupShort(pShort);
+	if (pInfo) {
+		pInfo->count = count;
+		pInfo->pBits = pGrp + offs;
+		pInfo->norder = 0;
+		pInfo->pOrder = NULL;
+	}
+	offs += bitsSize;
+	if (ordered) {
+		int32_t norder;
+		if (avail - offs < 4) return bgeoGroupShort(pShort);
+		norder = hbinI32(pGrp + offs);
+		offs += 4;
+		if (norder < 0 || norder > count) return NULL;
+		if ((size_t)norder * 4 > avail - offs) return bgeoGroupShort(pShort);
+		if (pInfo) {
+			pInfo->norder = norder;
+			pInfo->pOrder = pGrp + offs;
+		}
+		offs += (size_t)norder * 4;
+	}
+	return pGrp + offs;
+}
+
+/* all group records (point groups first) in one layout; returns the end of the last one or NULL */
+static const uint8_t* bgeoGroupChain(const uint8_t* pTop, const size_t avail, const int32_t npts, const int32_t nprims, const int32_t ngrpPnt, const int32_t ngrp, const int tag, int* pShort) {
+	int32_t i;
+	const uint8_t* pGrp = pTop;
+	for (i = 0; i < ngrp && pGrp; ++i) {
+		pGrp = bgeoGroupInfo(pGrp, avail - (size_t)(pGrp - pTop), i < ngrpPnt ? npts : nprims, tag, NULL, pShort);
+	}
+	return pGrp;
+}
+
+/* one layout per file: the first one that reads the whole chain; *pShort is set if a layout tried before it ran out of bytes */
+static int bgeoGroupLayout(const uint8_t* pTop, const size_t avail, const int32_t npts, const int32_t nprims, const int32_t ngrpPnt, const int32_t ngrp, int* pShort) {
+	int tag;
+	if (!pTop) return -1;
+	for (tag = 0; tag < BGEO_GROUP_NUM_TAGS; ++tag) {
+		if (bgeoGroupChain(pTop, avail, npts, nprims, ngrpPnt, ngrp, tag, pShort)) return tag;
+	}
+	return -1;
+}
+
+static const uint8_t* bgeoGroupsTop(const HBIN_BGEO bgeo) {
+	int32_t npts = HBIN_BGEO_FN(NumPoints)(bgeo);
+	int32_t nprims = HBIN_BGEO_FN(NumPrims)(bgeo);
+	int nattrPnt = HBIN_BGEO_FN(NumPointAttrs)(bgeo);
+	int nattrVtx = HBIN_BGEO_FN(NumVertexAttrs)(bgeo);
+	int nattrPrim = HBIN_BGEO_FN(NumPrimAttrs)(bgeo);
+	if (npts == 0 && nprims == 0 && nattrPnt == 0 && nattrVtx == 0 && nattrPrim == 0) {
+		return (const uint8_t*)bgeo + 0x29;
+	}
+	return bgeoForEachPrimImpl(bgeo, NULL, NULL);
+}
+
+/* grpId: point groups first, then primitive groups */
+static int32_t bgeoGroupElems(const HBIN_BGEO bgeo, const int32_t grpId) {
+	return grpId < HBIN_BGEO_FN(NumPointGroups)(bgeo) ? HBIN_BGEO_FN(NumPoints)(bgeo) : HBIN_BGEO_FN(NumPrims)(bgeo);
+}
+
+/*
+  group records were checked by bgeoOpen, so they are walked without a size limit;
+  bgeoOpen refuses files where a layout tried before the file's own one runs out of bytes,
+  so the unsized layout search reads nothing the sized one didn't
+*/
+static int bgeoGroupTag(const HBIN_BGEO bgeo, const uint8_t* pTop) {
+	return bgeoGroupLayout(pTop, ~(size_t)0, HBIN_BGEO_FN(NumPoints)(bgeo), HBIN_BGEO_FN(NumPrims)(bgeo),
+		HBIN_BGEO_FN(NumPointGroups)(bgeo), HBIN_BGEO_FN(NumPointGroups)(bgeo) + HBIN_BGEO_FN(NumPrimGroups)(bgeo), NULL);
+}
+
+static const uint8_t* bgeoFindGroup(const HBIN_BGEO bgeo, const int32_t grpId, BGEO_GROUP_INFO* pInfo, int* pTag) {
+	int32_t i;
+	const uint8_t* pGrp = NULL;
+	int32_t ngrp = HBIN_BGEO_FN(NumPointGroups)(bgeo) + HBIN_BGEO_FN(NumPrimGroups)(bgeo);
+	if ((uint32_t)grpId < (uint32_t)ngrp) {
+		int tag;
+		pGrp = bgeoGroupsTop(bgeo);
+		tag = bgeoGroupTag(bgeo, pGrp);
+		if (tag < 0) return NULL;
+		for (i = 0; i < grpId && pGrp; ++i) {
+			pGrp = bgeoGroupInfo(pGrp, ~(size_t)0, bgeoGroupElems(bgeo, i), tag, NULL, NULL);
+		}
+		if (pGrp && pInfo && !bgeoGroupInfo(pGrp, ~(size_t)0, bgeoGroupElems(bgeo, grpId), tag, pInfo, NULL)) {
+			pGrp = NULL;
+		}
+		if (pTag) {
+			*pTag = tag;
+		}
+	}
+	return pGrp;
+}
+
+static const uint8_t* bgeoDetailAttrsTop(const HBIN_BGEO bgeo) {
+	const uint8_t* pAttrs = NULL;
+	int32_t nattr = HBIN_BGEO_FN(NumDetailAttrs)(bgeo);
+	if (nattr > 0) {
+		int32_t ngrpPnt = HBIN_BGEO_FN(NumPointGroups)(bgeo);
+		int32_t ngrp = ngrpPnt + HBIN_BGEO_FN(NumPrimGroups)(bgeo);
+		pAttrs = bgeoGroupsTop(bgeo);
+		if (ngrp > 0) {
+			int tag = bgeoGroupTag(bgeo, pAttrs);
+			pAttrs = tag < 0 ? NULL : bgeoGroupChain(pAttrs, ~(size_t)0, HBIN_BGEO_FN(NumPoints)(bgeo), HBIN_BGEO_FN(NumPrims)(bgeo), ngrpPnt, ngrp, tag, NULL);
+		}
+	}
+	return pAttrs;
+}
+
+typedef struct _BGEO_CHECK {
+	const uint8_t* pTop;
+	size_t size;
+	size_t offs;
+} BGEO_CHECK;
+
+static int bgeoChkAvail(const BGEO_CHECK* pChk, const size_t n) {
+	return pChk->offs <= pChk->size && n <= pChk->size - pChk->offs;
+}
+
+/* i16 length, followed by i32 if negative */
+static int bgeoChkLen(BGEO_CHECK* pChk, int32_t* pLen) {
+	int32_t len;
+	if (!bgeoChkAvail(pChk, 2)) return 0;
+	len = hbinI16(pChk->pTop + pChk->offs);
+	pChk->offs += 2;
+	if (len < 0) {
+		if (!bgeoChkAvail(pChk, 4)) return 0;
+		len = hbinI32(pChk->pTop + pChk->offs);
+		pChk->offs += 4;
+	}
+	*pLen = len;
+	return len >= 0;
+}
+
+static int bgeoChkSkip(BGEO_CHECK* pChk, const size_t n) {
+	if (!bgeoChkAvail(pChk, n)) return 0;
+	pChk->offs += n;
+	return 1;
+}
+
+/* attribute descriptors as walked by bgeoCalcItemRecSize; *pRecSize is -1 if an attribute of unknown size stops the walk */
+static int bgeoChkAttrs(BGEO_CHECK* pChk, const int32_t nattr, int32_t* pRecSize) {
+	int32_t i, j;
+	int32_t recSize = 0;
+	for (i = 0; i < nattr; ++i) {
+		int32_t nameLen = 0;
+		int32_t attrSize = 0;
+		int32_t valSize = 0;
+		uint32_t attrType;
+		if (!bgeoChkLen(pChk, &nameLen) || nameLen == 0 || !bgeoChkSkip(pChk, (size_t)nameLen)) return 0;
+		if (!bgeoChkLen(pChk, &attrSize) || !bgeoChkAvail(pChk, 4)) return 0;
+		attrType = hbinU32(pChk->pTop + pChk->offs) & 0xFFFF;
+		pChk->offs += 4;
+		if (attrType == HBIN_ATTRTYPE_STRING) {
+			int32_t nstrs;
+			if (!bgeoChkAvail(pChk, 4)) return 0;
+			nstrs = hbinI32(pChk->pTop + pChk->offs);
+			pChk->offs += 4;
+			if (nstrs < 0) return 0;
+			for (j = 0; j < nstrs; ++j) {
+				int32_t strLen = 0;
+				if (!bgeoChkLen(pChk, &strLen) || !bgeoChkSkip(pChk, (size_t)strLen)) return 0;
+			}
+			valSize = 4;
+		} else {
+			if (attrType == HBIN_ATTRTYPE_FLOAT || attrType == HBIN_ATTRTYPE_INT) {
+				if (attrSize > 0x1000000) return 0;
+				valSize = 4 * attrSize;
+			} else if (attrType == HBIN_ATTRTYPE_VECTOR) {
+				valSize = 4 * 3;
+			}
+			if (valSize == 0) {
+				/* unknown type: its default value can't be skipped, so the reader stops here as well;
+				   the descriptors left still take at least 2 + 1 + 2 + 4 bytes each */
+				*pRecSize = -1;
+				return bgeoChkAvail(pChk, (size_t)(nattr - i - 1) * 9);
+			}
+			if (!bgeoChkSkip(pChk, (size_t)valSize)) return 0;
+		}
+		if (valSize < 0 || recSize > 0x7FFFFFFF - valSize) return 0;
+		recSize += valSize;
+	}
+	*pRecSize = recSize;
+	return 1;
+}
+
+/* smallest size the remaining sections can take (9 per attribute descriptor, 4 * 4 per point, 4 + 1 per polygon, 2 per group name), for counts that can't be checked item by item */
+static int bgeoChkRest(const BGEO_CHECK* pChk, const int64_t nattr, const int32_t npts, const int32_t nprims, const int32_t ngrp) {
+	uint64_t minSize = ((uint64_t)nattr * 9) + ((uint64_t)npts * 16) + ((uint64_t)nprims * 5) + ((uint64_t)ngrp * 2);
+	return bgeoChkAvail(pChk, 0) && minSize <= (uint64_t)(pChk->size - pChk->offs);
+}
+
+static int bgeoChkPrimIdx(const BGEO_CHECK* pChk, const int32_t idxSize, const int32_t npts) {
+	int32_t pntId = idxSize == 2 ? hbinU16(pChk->pTop + pChk->offs) : hbinI32(pChk->pTop + pChk->offs);
+	return (uint32_t)pntId < (uint32_t)npts;
+}
+
+HBIN_BGEO_IFC(HBIN_BGEO, Open)(const void* pMem, const size_t size) {
+	int32_t i, j;
+	int32_t npts, nprims, ngrp, ngrpPnt;
+	int32_t nattrPnt, nattrVtx, nattrPrim, nattrDetail;
+	int32_t pntRecSize = 0;
+	int32_t vtxRecSize = 0;
+	int32_t primRecSize = 0;
+	int32_t detailRecSize = 0;
+	int32_t idxSize;
+	int32_t type = 0;
+	int32_t runLen = -1;
+	BGEO_CHECK chk;
+	HBIN_BGEO bgeo = (HBIN_BGEO)pMem;
+	if (!pMem || size < 0x29 || !HBIN_BGEO_FN(Valid)(bgeo)) return HBIN_NONE;
+	npts = HBIN_BGEO_FN(NumPoints)(bgeo);
+	nprims = HBIN_BGEO_FN(NumPrims)(bgeo);
+	nattrPnt = HBIN_BGEO_FN(NumPointAttrs)(bgeo);
+	nattrVtx = HBIN_BGEO_FN(NumVertexAttrs)(bgeo);
+	nattrPrim = HBIN_BGEO_FN(NumPrimAttrs)(bgeo);
+	nattrDetail = HBIN_BGEO_FN(NumDetailAttrs)(bgeo);
+	if (npts < 0 || nprims < 0 || nattrPnt < 0 || nattrVtx < 0 || nattrPrim < 0 || nattrDetail < 0) return HBIN_NONE;
+	if (HBIN_BGEO_FN(NumPointGroups)(bgeo) < 0 || HBIN_BGEO_FN(NumPrimGroups)(bgeo) < 0) return HBIN_NONE;
+	ngrpPnt = HBIN_BGEO_FN(NumPointGroups)(bgeo);
+	ngrp = HBIN_BGEO_FN(NumPrimGroups)(bgeo);
+	/* the accessors add the two group counts in int32_t */
+	if (ngrp > 0x7FFFFFFF - ngrpPnt) return HBIN_NONE;
+	ngrp += ngrpPnt;
+	chk.pTop = (const uint8_t*)pMem;
+	chk.size = size;
+	chk.offs = 0x29;
+	/* past an attribute of unknown size the accessors locate nothing, so only the counts are bounded from there on */
+	if (!bgeoChkAttrs(&chk, nattrPnt, &pntRecSize)) return HBIN_NONE;
+	if (pntRecSize < 0) return bgeoChkRest(&chk, (int64_t)nattrVtx + nattrPrim + nattrDetail, npts, nprims, ngrp) ? bgeo : HBIN_NONE;
+	pntRecSize += 4 * 4;
+	if ((chk.size - chk.offs) / (size_t)pntRecSize < (size_t)npts) return HBIN_NONE;
+	chk.offs += (size_t)npts * (size_t)pntRecSize;
+	if (!bgeoChkAttrs(&chk, nattrVtx, &vtxRecSize)) return HBIN_NONE;
+	if (vtxRecSize < 0) return bgeoChkRest(&chk, (int64_t)nattrPrim + nattrDetail, 0, nprims, ngrp) ? bgeo : HBIN_NONE;
+	if (!bgeoChkAttrs(&chk, nattrPrim, &primRecSize)) return HBIN_NONE;
+	if (primRecSize < 0) return bgeoChkRest(&chk, nattrDetail, 0, nprims, ngrp) ? bgeo : HBIN_NONE;
+	idxSize = bgeoIdxSize(npts);
+	for (i = 0; i < nprims; ++i) {
+		if (runLen <= 0) {
+			if (!bgeoChkAvail(&chk, 4)) return HBIN_NONE;
+			type = hbinI32(chk.pTop + chk.offs);
+			chk.offs += 4;
+			if (type == -1) {
+				if (!bgeoChkAvail(&chk, 2 + 4)) return HBIN_NONE;
+				runLen = hbinU16(chk.pTop + chk.offs);
+				type = hbinI32(chk.pTop + chk.offs + 2);
+				chk.offs += 2 + 4;
+				--runLen;
+			} else {
+				runLen = 0;
+			}
+		} else {
+			--runLen;
+		}
+		if (type == 1) {
+			/* Poly */
+			int32_t nvtx;
+			size_t stride = (size_t)(idxSize + vtxRecSize);
+			if (!bgeoChkAvail(&chk, 4 + 1)) return HBIN_NONE;
+			nvtx = hbinI32(chk.pTop + chk.offs);
+			chk.offs += 4 + 1;
+			if (nvtx < 0 || (chk.size - chk.offs) / stride < (size_t)nvtx) return HBIN_NONE;
+			for (j = 0; j < nvtx; ++j) {
+				if (!bgeoChkPrimIdx(&chk, idxSize, npts)) return HBIN_NONE;
+				chk.offs += stride;
+			}
+		} else if (type == 0x2000) {
+			/* Sphere */
+			if (!bgeoChkAvail(&chk, (size_t)idxSize) || !bgeoChkPrimIdx(&chk, idxSize, npts)) return HBIN_NONE;
+			if (!bgeoChkSkip(&chk, (size_t)idxSize + (3 * 3 * 4) + (size_t)vtxRecSize)) return HBIN_NONE;
+		} else {
+			/* the walker stops here, so nothing past this primitive could be located */
+			return HBIN_NONE;
+		}
+		if (!bgeoChkSkip(&chk, (size_t)primRecSize)) return HBIN_NONE;
+	}
+	if (ngrp > 0) {
+		const uint8_t* pEnd;
+		int grpShort = 0;
+		int grpTag;
+		if (!bgeoChkAvail(&chk, 0)) return HBIN_NONE;
+		grpTag = bgeoGroupLayout(chk.pTop + chk.offs, chk.size - chk.offs, npts, nprims, ngrpPnt, ngrp, &grpShort);
+		/* the accessors search the layout without a size, so every layout tried before this one must have failed inside the buffer */
+		if (grpTag < 0 || grpShort) return HBIN_NONE;
+		pEnd = bgeoGroupChain(chk.pTop + chk.offs, chk.size - chk.offs, npts, nprims, ngrpPnt, ngrp, grpTag, NULL);
+		chk.offs = (size_t)(pEnd - chk.pTop);
+	}
+	if (nattrDetail > 0) {
+		if (!bgeoChkAttrs(&chk, nattrDetail, &detailRecSize)) return HBIN_NONE;
+		if (detailRecSize >= 0 && !bgeoChkSkip(&chk, (size_t)detailRecSize)) return HBIN_NONE;
+	}
+	return bgeo;
+}
+
+/* vertex records sit between the point indices, so they swap one by one; pUserData: the writable buffer */
+static int bgeoNormalizePrimCB(const HBIN_PRIM prim, void* pUserData) {
+	int32_t i;
+	const HBIN_PRIM_S* pPrim = (const HBIN_PRIM_S*)prim;
+	uint8_t* pTop = (uint8_t*)pUserData;
+	if (pPrim->vtxAttrsRecSize > 0) {
+		size_t offs = (size_t)(pPrim->pIdx - pPrim->pTop) + (size_t)pPrim->idxSize;
+		for (i = 0; i < pPrim->nvtx; ++i) {
+			hbinSwap32(pTop + offs, (size_t)pPrim->vtxAttrsRecSize / 4);
+			offs += (size_t)(pPrim->idxSize + pPrim->vtxAttrsRecSize);
+		}
+	}
+	if (pPrim->primAttrsRecSize > 0) {
+		hbinSwap32(pTop + (bgeoPrimAttrsRec(pPrim) - pPrim->pTop), (size_t)pPrim->primAttrsRecSize / 4);
+	}
+	return 1;
+}
+
+HBIN_BGEO_IFC(int, Normalize)(HBIN_BGEO bgeo, const size_t size) {
+	int32_t npts;
+	int32_t recSize;
+	const uint8_t* pPts = NULL;
+	const uint8_t* pAttrs = NULL;
+	uint8_t* pTop = (uint8_t*)bgeo;
+	if (!HBIN_BGEO_FN(Open)(bgeo, size)) return 0;
+	if (bgeoHostOrder(bgeo)) return 1;
+	if (hbinHostLE()) {
+		npts = HBIN_BGEO_FN(NumPoints)(bgeo);
+		recSize = bgeoCalcPntRecSize(bgeo, &pPts);
+		/* every attribute value is a 32-bit word, so the whole point block swaps as one array */
+		if (npts > 0 && recSize > 0 && pPts) {
+			hbinSwap32(pTop + (pPts - pTop), ((size_t)npts * (size_t)recSize) / 4);
+		}
+		/* the walk reads each material id before the callback swaps that record */
+		if (HBIN_BGEO_FN(NumVertexAttrs)(bgeo) > 0 || HBIN_BGEO_FN(NumPrimAttrs)(bgeo) > 0) {
+			bgeoForEachPrimImpl(bgeo, bgeoNormalizePrimCB, pTop);
+		}
+		pAttrs = bgeoDetailAttrsTop(bgeo);
+		if (pAttrs) {
+			const uint8_t* pVals = NULL;
+			recSize = bgeoCalcItemRecSize(bgeo, HBIN_BGEO_FN(NumDetailAttrs)(bgeo), (size_t)(pAttrs - pTop), 0, &pVals);
+			if (recSize > 0 && pVals) {
+				hbinSwap32(pTop + (pVals - pTop), (size_t)recSize / 4);
+			}
+		}
+	}
+	pTop[4] = 'v';
+	return 1;
+}
+
+HBIN_BGEO_IFC(int, IsNormalized)(const HBIN_BGEO bgeo) {
+	return HBIN_BGEO_FN(Valid)(bgeo) && bgeoHostOrder(bgeo);
+}
+
+HBIN_BGEO_IFC(const void*, PointRecords)(const HBIN_BGEO bgeo, int32_t* pStride) {
+	const uint8_t* pPts = NULL;
+	int32_t recSize = 0;
+	if (HBIN_BGEO_FN(IsNormalized)(bgeo) && HBIN_BGEO_FN(NumPoints)(bgeo) > 0) {
+		recSize = bgeoCalcPntRecSize(bgeo, &pPts);
+		if (recSize <= 0) {
+			pPts = NULL;
+		}
+	}
+	if (pStride) {
+		*pStride = pPts ? recSize : 0;
+	}
+	return pPts;
+}
+
+HBIN_BGEO_IFC(int32_t, PointAttrOffset)(const HBIN_BGEO bgeo, const char* pAttrName) {
+	int32_t valOffs = -1;
+	int32_t npts = HBIN_BGEO_FN(NumPoints)(bgeo);
+	int32_t nattr = npts > 0 ? HBIN_BGEO_FN(NumPointAttrs)(bgeo) : 0;
+	if (nattr > 0 && pAttrName) {
+		if (bgeoFindAttrInfo(bgeo, nattr, 0x29, 4 * 4, pAttrName, NULL, &valOffs, NULL, NULL, NULL) < 0) {
+			valOffs = -1;
+		}
+	}
+	return valOffs;
+}
+
+static HBIN_STRING bgeoGroupName(const HBIN_BGEO bgeo, const int32_t grpId) {
+	HBIN_STRING name;
+	BGEO_GROUP_INFO info;
+	name.pChars = NULL;
+	name.len = 0;
+	if (bgeoFindGroup(bgeo, grpId, &info, NULL)) {
+		name = info.name;
+	}
+	return name;
+}
+
+static int32_t bgeoFindGroupByName(const HBIN_BGEO bgeo, const int32_t grpOrg, const int32_t ngrp, const char* pName) {
+	int32_t i;
+	int32_t grpId = -1;
+	size_t nameLen = pName ? hbinStrLen(pName) : 0;
+	int tag = -1;
+	const uint8_t* pGrp = nameLen > 0 ? bgeoFindGroup(bgeo, grpOrg, NULL, &tag) : NULL;
+	for (i = 0; i < ngrp && pGrp; ++i) {
+		BGEO_GROUP_INFO info;
+		const uint8_t* pNext = bgeoGroupInfo(pGrp, ~(size_t)0, bgeoGroupElems(bgeo, grpOrg + i), tag, &info, NULL);
+		if (pNext && info.name.len == nameLen && hbinMemCmp(info.name.pChars, pName, nameLen) == 0) {
+			grpId = i;
+			break;
+		}
+		pGrp = pNext;
+	}
+	return grpId;
+}
+
+static int32_t bgeoGroupBits(const HBIN_BGEO bgeo, const int32_t grpId, const int32_t nelems, uint32_t* pBits) {
+	int32_t i;
+	int32_t nmembers = 0;
+	int32_t count;
+	const uint8_t* pSrc;
+	BGEO_GROUP_INFO info;
+	if (!pBits || nelems <= 0 || !bgeoFindGroup(bgeo, grpId, &info, NULL)) return 0;
+	count = info.count;
+	pSrc = info.pBits;
+	if (count > nelems) {
+		count = nelems;
+	}
+	for (i = 0; i < (nelems + 31) / 32; ++i) {
+		pBits[i] = 0;
+	}
+	for (i = 0; i < count; ++i) {
+		if (pSrc[i >> 3] & (0x80 >> (i & 7))) {
+			pBits[i >> 5] |= 1U << (i & 31);
+			++nmembers;
+		}
+	}
+	return nmembers;
+}
+
+static int32_t bgeoGroupOrder(const HBIN_BGEO bgeo, const int32_t grpId, const int32_t nelems, int32_t* pIdx) {
+	int32_t i;
+	int32_t n = 0;
+	BGEO_GROUP_INFO info;
+	if (bgeoFindGroup(bgeo, grpId, &info, NULL) && info.pOrder) {
+		for (i = 0; i < info.norder; ++i) {
+			int32_t idx = hbinI32(info.pOrder + (i * 4));
+			if ((uint32_t)idx >= (uint32_t)nelems) continue;
+			if (pIdx) {
+				pIdx[n] = idx;
+			}
+			++n;
+		}
+	}
+	return n;
+}
+
+HBIN_BGEO_IFC(HBIN_STRING, PointGroupName)(const HBIN_BGEO bgeo, const int32_t grpId) {
+	HBIN_STRING name;
+	name.pChars = NULL;
+	name.len = 0;
+	if ((uint32_t)grpId < (uint32_t)HBIN_BGEO_FN(NumPointGroups)(bgeo)) {
+		name = bgeoGroupName(bgeo, grpId);
+	}
+	return name;
+}
+
+HBIN_BGEO_IFC(HBIN_STRING, PrimGroupName)(const HBIN_BGEO bgeo, const int32_t grpId) {
+	HBIN_STRING name;
+	name.pChars = NULL;
+	name.len = 0;
+	if ((uint32_t)grpId < (uint32_t)HBIN_BGEO_FN(NumPrimGroups)(bgeo)) {
+		name = bgeoGroupName(bgeo, HBIN_BGEO_FN(NumPointGroups)(bgeo) + grpId);
+	}
+	return name;
+}
+
+HBIN_BGEO_IFC(int32_t, FindPointGroup)(const HBIN_BGEO bgeo, const char* pGrpName) {
+	return bgeoFindGroupByName(bgeo, 0, HBIN_BGEO_FN(NumPointGroups)(bgeo), pGrpName);
+}
+
+HBIN_BGEO_IFC(int32_t, FindPrimGroup)(const HBIN_BGEO bgeo, const char* pGrpName) {
+	return bgeoFindGroupByName(bgeo, HBIN_BGEO_FN(NumPointGroups)(bgeo), HBIN_BGEO_FN(NumPrimGroups)(bgeo), pGrpName);
+}
+
+HBIN_BGEO_IFC(int32_t, GetPointGroupBits)(const HBIN_BGEO bgeo, const int32_t grpId, uint32_t* pBits) {
+	int32_t n = 0;
+	if ((uint32_t)grpId < (uint32_t)HBIN_BGEO_FN(NumPointGroups)(bgeo)) {
+		n = bgeoGroupBits(bgeo, grpId, HBIN_BGEO_FN(NumPoints)(bgeo), pBits);
+	}
+	return n;
+}
+
+HBIN_BGEO_IFC(int32_t, GetPrimGroupBits)(const HBIN_BGEO bgeo, const int32_t grpId, uint32_t* pBits) {
+	int32_t n = 0;
+	if ((uint32_t)grpId < (uint32_t)HBIN_BGEO_FN(NumPrimGroups)(bgeo)) {
+		n = bgeoGroupBits(bgeo, HBIN_BGEO_FN(NumPointGroups)(bgeo) + grpId, HBIN_BGEO_FN(NumPrims)(bgeo), pBits);
+	}
+	return n;
+}
+
+HBIN_BGEO_IFC(int32_t, GetPointGroupOrder)(const HBIN_BGEO bgeo, const int32_t grpId, int32_t* pIdx) {
+	int32_t n = 0;
+	if ((uint32_t)grpId < (uint32_t)HBIN_BGEO_FN(NumPointGroups)(bgeo)) {
+		n = bgeoGroupOrder(bgeo, grpId, HBIN_BGEO_FN(NumPoints)(bgeo), pIdx);
+	}
+	return n;
+}
+
+HBIN_BGEO_IFC(int32_t, GetPrimGroupOrder)(const HBIN_BGEO bgeo, const int32_t grpId, int32_t* pIdx) {
+	int32_t n = 0;
+	if ((uint32_t)grpId < (uint32_t)HBIN_BGEO_FN(NumPrimGroups)(bgeo)) {
+		n = bgeoGroupOrder(bgeo, HBIN_BGEO_FN(NumPointGroups)(bgeo) + grpId, HBIN_BGEO_FN(NumPrims)(bgeo), pIdx);
+	}
+	return n;
+}
+
+HBIN_BGEO_IFC(HBIN_STRING, DetailStrAttr)(const HBIN_BGEO bgeo, const char* pAttrName) {
+	const uint8_t* pAttrs = NULL;
+	HBIN_STRING str;
+	str.pChars = NULL;
+	str.len = 0;
+	pAttrs = bgeoDetailAttrsTop(bgeo);
+	if (pAttrs) {
+		const uint8_t* pTop = (const uint8_t*)bgeo;
+		size_t attrsOffs = (size_t)(pAttrs - pTop);
+		int32_t nattr = HBIN_BGEO_FN(NumDetailAttrs)(bgeo);
+		int32_t valOffs = 0;
+		int32_t attrType = 0;
+		int32_t attrSize = 0;
+		const uint8_t* pDescr = NULL;
+		int32_t attrId = bgeoFindAttrInfo(bgeo, nattr, attrsOffs, 0, pAttrName, NULL, &valOffs, &attrType, &attrSize, &pDescr);
+		if (attrId >= 0) {
+			if (attrType == 4 && attrSize > 0) {
+				int32_t nstrs = hbinI32(pDescr);
+				if (nstrs > 0) {
+					str.len = hbinI16(pDescr + 4);
+					str.pChars = (const char*)(pDescr + 6);
+				}
+			}
+		}
+	}
+	return str;
+}
+
+static void bgeoAttrDataInit(HBIN_ATTR_DATA* pData) {
+	pData->pRecs = NULL;
+	pData->stride = 0;
+	pData->offs = 0;
+	pData->count = 0;
+	pData->type = -1;
+	pData->size = 0;
+	pData->hostOrder = 0;
+}
+
+/* values per record as laid out by bgeoCalcItemRecSize */
+static int32_t bgeoAttrDataSize(const int32_t attrType, const int32_t attrSize) {
+	int32_t size = 0;
+	if (attrType == HBIN_ATTRTYPE_FLOAT || attrType == HBIN_ATTRTYPE_INT) {
+		size = attrSize;
+	} else if (attrType == HBIN_ATTRTYPE_VECTOR) {
+		size = 3;
+	} else if (attrType == HBIN_ATTRTYPE_STRING) {
+		size = 1;
+	}
+	return size;
+}
+
+HBIN_BGEO_IFC(int, PointAttrData)(const HBIN_BGEO bgeo, const char* pAttrName, HBIN_ATTR_DATA* pData) {
+	int res = 0;
+	int32_t npts = HBIN_BGEO_FN(NumPoints)(bgeo);
+	if (!pData) return 0;
+	bgeoAttrDataInit(pData);
+	if (npts > 0 && pAttrName) {
+		const uint8_t* pPts = NULL;
+		int32_t recSize = bgeoCalcPntRecSize(bgeo, &pPts);
+		if (recSize > 0 && pPts) {
+			if (pAttrName[0] == 'P' && pAttrName[1] == 0) {
+				pData->type = HBIN_ATTRTYPE_FLOAT;
+				pData->size = 4;
+				res = 1;
+			} else {
+				int32_t valOffs = 0;
+				int32_t attrType = 0;
+				int32_t attrSize = 0;
+				int32_t nattr = HBIN_BGEO_FN(NumPointAttrs)(bgeo);
+				if (bgeoFindAttrInfo(bgeo, nattr, 0x29, 4 * 4, pAttrName, NULL, &valOffs, &attrType, &attrSize, NULL) >= 0) {
+					pData->offs = valOffs;
+					pData->type = attrType & 0xFFFF;
+					pData->size = bgeoAttrDataSize(pData->type, attrSize);
+					res = pData->size > 0;
+				}
+			}
+			if (res) {
+				pData->pRecs = pPts;
+				pData->stride = recSize;
+				pData->count = npts;
+				pData->hostOrder = bgeoHostOrder(bgeo);
+			}
+		}
+	}
+	return res;
+}
+
+HBIN_BGEO_IFC(int, PrimAttrData)(const HBIN_BGEO bgeo, const char* pAttrName, HBIN_ATTR_DATA* pData) {
+	int res = 0;
+	int32_t attrId = HBIN_BGEO_FN(FindPrimAttr)(bgeo, pAttrName);
+	if (!pData) return 0;
+	bgeoAttrDataInit(pData);
+	if (attrId >= 0) {
+		int32_t valOffs = 0;
+		int32_t attrType = 0;
+		int32_t attrSize = 0;
+		if (bgeoPrimAttrInfoById(bgeo, attrId, &valOffs, &attrType, &attrSize, NULL) >= 0) {
+			pData->offs = valOffs;
+			pData->type = attrType & 0xFFFF;
+			pData->size = bgeoAttrDataSize(pData->type, attrSize);
+			pData->count = HBIN_BGEO_FN(NumPrims)(bgeo);
+			pData->hostOrder = bgeoHostOrder(bgeo);
+			res = pData->size > 0;
+		}
+	}
+	return res;
+}
+
+HBIN_BGEO_IFC(int, DetailAttrData)(const HBIN_BGEO bgeo, const char* pAttrName, HBIN_ATTR_DATA* pData) {
+	int res = 0;
+	const uint8_t* pAttrs = bgeoDetailAttrsTop(bgeo);
+	if (!pData) return 0;
+	bgeoAttrDataInit(pData);
+	if (pAttrs && pAttrName) {
+		size_t attrsOffs = (size_t)(pAttrs - (const uint8_t*)bgeo);
+		int32_t nattr = HBIN_BGEO_FN(NumDetailAttrs)(bgeo);
+		int32_t valOffs = 0;
+		int32_t attrType = 0;
+		int32_t attrSize = 0;
+		if (bgeoFindAttrInfo(bgeo, nattr, attrsOffs, 0, pAttrName, NULL, &valOffs, &attrType, &attrSize, NULL) >= 0) {
+			const uint8_t* pVals = NULL;
+			bgeoCalcItemRecSize(bgeo, nattr, attrsOffs, 0, &pVals);
+			pData->pRecs = pVals;
+			pData->offs = valOffs;
+			pData->count = 1;
+			pData->type = attrType & 0xFFFF;
+			pData->size = bgeoAttrDataSize(pData->type, attrSize);
+			pData->hostOrder = bgeoHostOrder(bgeo);
+			res = pVals && pData->size > 0;
+		}
+	}
+	return res;
+}
+
+HBIN_BGEO_IFC(const uint8_t*, PrimAttrRecord)(const HBIN_PRIM prim) {
+	return prim ? bgeoPrimAttrsRec((const HBIN_PRIM_S*)prim) : NULL;
+}
+
+HBIN_BGEO_IFC(int32_t, NumCaptureNodes)(const HBIN_BGEO bgeo) {
+	int32_t n = 0;
+	const uint8_t* pAttrs = bgeoDetailAttrsTop(bgeo);
+	if (pAttrs) {
+		const uint8_t* pTop = (const uint8_t*)bgeo;
+		size_t attrsOffs = (size_t)(pAttrs - pTop);
+		int32_t nattr = HBIN_BGEO_FN(NumDetailAttrs)(bgeo);
+		int32_t valOffs = 0;
+		int32_t attrType = 0;
+		int32_t attrSize = 0;
+		const uint8_t* pDescr = NULL;
+		int32_t attrId = bgeoFindAttrInfo(bgeo, nattr, attrsOffs, 0, s_pBgeoCaptPathName, NULL, &valOffs, &attrType, &attrSize, &pDescr);
+		if (attrId >= 0) {
+			if (attrType == 4 && attrSize > 0) {
+				n = hbinI32(pDescr);
+			}
+		}
+	}
+	return n;
+}
+
+HBIN_BGEO_IFC(HBIN_STRING, CaptureNodePath)(const HBIN_BGEO bgeo, const int32_t nodeId) {
+	const uint8_t* pAttrs = bgeoDetailAttrsTop(bgeo);
+	HBIN_STRING path;
+	path.pChars = NULL;
+	path.len = 0;
+	if (pAttrs && nodeId >= 0) {
+		const uint8_t* pTop = (const uint8_t*)bgeo;
+		size_t attrsOffs = (size_t)(pAttrs - pTop);
+		int32_t nattr = HBIN_BGEO_FN(NumDetailAttrs)(bgeo);
+		int32_t valOffs = 0;
+		int32_t attrType = 0;
+		int32_t attrSize = 0;
+		const uint8_t* pDescr = NULL;
+		int32_t attrId = bgeoFindAttrInfo(bgeo, nattr, attrsOffs, 0, s_pBgeoCaptPathName, NULL, &valOffs, &attrType, &attrSize, &pDescr);
+		if (attrId >= 0) {
+			int32_t i;
+			int32_t ncap = 0;
+			int32_t len = 0;
+			if (attrType == 4 && attrSize > 0) {
+				ncap = hbinI32(pDescr);
+			}
+			if (ncap > 0 && nodeId < ncap) {
+				pDescr += 4;
+				for (i = 0; i <= nodeId; ++i) {
+					len = hbinI16(pDescr);
+					pDescr += 2;
+					if (len < 0) {
+						len = hbinI32(pDescr);
+						pDescr += 4;
+					}
+					path.pChars = (const char*)pDescr;
+					pDescr += len;
+				}
+				path.len = len;
+			}
+		}
+	}
+	return path;
+}
+
+HBIN_BGEO_IFC(int32_t, MaxCapturesPerPoint)(const HBIN_BGEO bgeo) {
+	int32_t nwgt = 0;
+	int32_t nattr = HBIN_BGEO_FN(NumPointAttrs)(bgeo);
+	if (nattr) {
+		int32_t valOffs = 0;
+		int32_t attrType = 0;
+		int32_t attrSize = 0;
+		int32_t attrId = bgeoFindAttrInfo(bgeo, nattr, 0x29, 4 * 4, s_pBgeoCaptAttrName, NULL, &valOffs, &attrType, &attrSize, NULL);
+		if (attrId >= 0 && attrType == 0x10000) {
+			nwgt = attrSize / 2;
+		}
+	}
+	return nwgt;
+}
+
+HBIN_BGEO_IFC(HBIN_CAPTURE, PointCapture)(const HBIN_BGEO bgeo, const int32_t pntId, const int32_t wgtId) {
+	int32_t npts = HBIN_BGEO_FN(NumPoints)(bgeo);
+	int32_t nattr = npts > 0 ? HBIN_BGEO_FN(NumPointAttrs)(bgeo) : 0;
+	HBIN_CAPTURE capt;
+	capt.node = -1;
+	capt.wght = 0.0f;
+	if (nattr && (uint32_t)pntId < (uint32_t)npts) {
+		int32_t nwgt = 0;
+		int32_t valOffs = 0;
+		int32_t attrType = 0;
+		int32_t attrSize = 0;
+		int32_t attrId = bgeoFindAttrInfo(bgeo, nattr, 0x29, 4 * 4, s_pBgeoCaptAttrName, NULL, &valOffs, &attrType, &attrSize, NULL);
+		if (attrId >= 0 && attrType == 0x10000) {
+			nwgt = attrSize / 2;
+		}
+		if (nwgt > 0 && (uint32_t)wgtId < (uint32_t)nwgt) {
+			const uint8_t* pPts = NULL;
+			int32_t recSize = bgeoCalcPntRecSize(bgeo, &pPts);
+			if (recSize > 0 && pPts) {
+				int hostOrder = bgeoHostOrder(bgeo);
+				const uint8_t* pWgt = pPts + ((size_t)pntId * (size_t)recSize) + valOffs + (wgtId * 8);
+				capt.node = (int32_t)hbinRecF32(pWgt, hostOrder);
+				capt.wght = hbinRecF32(pWgt + 4, hostOrder);
+			}
+		}
+	}
+	return capt;
+}
+
+HBIN_BGEO_IFC(int32_t, SkeletonNames)(const HBIN_BGEO bgeo, const char* pAttrName, HBIN_STRING* pNames) {
+	int32_t n = 0;
+	const uint8_t* pAttrs = bgeoDetailAttrsTop(bgeo);
+	if (pAttrs && pAttrName) {
+		int32_t i;
+		const uint8_t* pTop = (const uint8_t*)bgeo;
+		size_t attrsOffs = (size_t)(pAttrs - pTop);
+		int32_t nattr = HBIN_BGEO_FN(NumDetailAttrs)(bgeo);
+		int32_t valOffs = 0;
+		int32_t attrType = 0;
+		int32_t attrSize = 0;
+		const uint8_t* pDescr = NULL;
+		int32_t attrId = bgeoFindAttrInfo(bgeo, nattr, attrsOffs, 0, pAttrName, NULL, &valOffs, &attrType, &attrSize, &pDescr);
+		if (attrId >= 0 && attrType == 4 && pDescr) {
+			n = hbinI32(pDescr);
+			if (n > 0 && pNames) {
+				pDescr += 4;
+				for (i = 0; i < n; ++i) {
+					pNames[i].len = hbinU16(pDescr);
+					pDescr += 2;
+					if (pNames[i].len == 0xFFFF) {
+						pNames[i].len = hbinI32(pDescr);
+						pDescr += 4;
+					}
+					pNames[i].pChars = (const char*)pDescr;
+					pDescr += pNames[i].len;
+				}
+			}
+		}
+	}
+	return n;
+}
+
+HBIN_BGEO_IFC(int32_t, SkeletonParents)(const HBIN_BGEO bgeo, const char* pAttrName, int32_t* pParents) {
+	int32_t n = 0;
+	const uint8_t* pAttrs = bgeoDetailAttrsTop(bgeo);
+	if (pAttrs && pAttrName) {
+		int32_t i;
+		const uint8_t* pTop = (const uint8_t*)bgeo;
+		size_t attrsOffs = (size_t)(pAttrs - pTop);
+		int32_t nattr = HBIN_BGEO_FN(NumDetailAttrs)(bgeo);
+		int32_t valOffs = 0;
+		int32_t attrType = 0;
+		int32_t attrSize = 0;
+		const uint8_t* pDescr = NULL;
+		int32_t attrId = bgeoFindAttrInfo(bgeo, nattr, attrsOffs, 0, pAttrName, NULL, &valOffs, &attrType, &attrSize, &pDescr);
+		if (attrId >= 0 && attrType == 1 && pDescr) {
+			n = attrSize;
+			if (n > 0 && pParents) {
+				const uint8_t* pVals = NULL;
+				bgeoCalcItemRecSize(bgeo, nattr, attrsOffs, 0, &pVals);
+				if (pVals) {
+					int hostOrder = bgeoHostOrder(bgeo);
+					for (i = 0; i < n; ++i) {
+						pParents[i] = hbinRecI32(pVals + valOffs + (i * 4), hostOrder);
+					}
+				}
+			}
+		}
+	}
+	return n;
+}
+
+HBIN_BGEO_IFC(int32_t, SkeletonTransforms)(const HBIN_BGEO bgeo, const char* pAttrName, float* pXforms) {
+	int32_t n = 0;
+	const uint8_t* pAttrs = bgeoDetailAttrsTop(bgeo);
+	if (pAttrs && pAttrName) {
+		int32_t i;
+		const uint8_t* pTop = (const uint8_t*)bgeo;
+		size_t attrsOffs = (size_t)(pAttrs - pTop);
+		int32_t nattr = HBIN_BGEO_FN(NumDetailAttrs)(bgeo);
+		int32_t valOffs = 0;
+		int32_t attrType = 0;
+		int32_t attrSize = 0;
+		const uint8_t* pDescr = NULL;
+		int32_t attrId = bgeoFindAttrInfo(bgeo, nattr, attrsOffs, 0, pAttrName, NULL, &valOffs, &attrType, &attrSize, &pDescr);
+		if (attrId >= 0 && attrType == 0 && pDescr) {
+			n = attrSize;
+			if (n > 0 && pXforms) {
+				const uint8_t* pVals = NULL;
+				bgeoCalcItemRecSize(bgeo, nattr, attrsOffs, 0, &pVals);
+				if (pVals) {
+					int hostOrder = bgeoHostOrder(bgeo);
+					for (i = 0; i < n; ++i) {
+						pXforms[i] = hbinRecF32(pVals + valOffs + (i * 4), hostOrder);
+					}
+				}
+			}
+		}
+	}
+	return n;
+}
+
+static void bgeoWriteVertex(
+	const HBIN_BGEO bgeo, const int32_t pntId,
+	uint8_t* pVtx,
+	const int32_t posOffs, const int32_t nrmOffs,
+	const int32_t rgbOffs, const int32_t texOffs,
+	const int32_t wgtOffs, const int32_t idxOffs,
+	const int32_t maxWghts, const int32_t numVtxCapts,
+	const HBIN_FLOAT3* pNrm)
+{
+	int32_t j;
+	if (posOffs >= 0) {
+		HBIN_BGEO_FN(PointPos)(*(HBIN_FLOAT3*)(pVtx + posOffs), bgeo, pntId);
+	}
+	if (nrmOffs >= 0) {
+		if (pNrm) {
+			float* pDst = (float*)(pVtx + nrmOffs);
+			for (j = 0; j < 3; ++j) {
+				pDst[j] = pNrm[pntId][j];
+			}
+		} else {
+			HBIN_BGEO_FN(PointNrm)(*(HBIN_FLOAT3*)(pVtx + nrmOffs), bgeo, pntId);
+		}
+	}
+	if (rgbOffs >= 0) {
+		HBIN_BGEO_FN(PointRGB)(*(HBIN_FLOAT3*)(pVtx + rgbOffs), bgeo, pntId);
+	}
+	if (texOffs >= 0) {
+		HBIN_FLOAT2* pTex = (HBIN_FLOAT2*)(pVtx + texOffs);
+		HBIN_BGEO_FN(PointUV)(*pTex, bgeo, pntId);
+		(*pTex)[1] = 1.0f - (*pTex)[1];
+	}
+	if (wgtOffs >= 0 || idxOffs >= 0) {
+		float* pWgt = wgtOffs < 0 ? NULL : (float*)(pVtx + wgtOffs);
+		int32_t* pIdx = idxOffs < 0 ? NULL : (int32_t*)(pVtx + idxOffs);
+		if (pWgt) {
+			for (j = 0; j < maxWghts; ++j) {
+				pWgt[j] = 0.0f;
+			}
+			if (maxWghts > 0) {
+				pWgt[0] = 1.0f;
+			}
+		}
+		if (pIdx) {
+			for (j = 0; j < maxWghts; ++j) {
+				pIdx[j] = 0;
+			}
+		}
+		for (j = 0; j < numVtxCapts; ++j) {
+			HBIN_CAPTURE capt = HBIN_BGEO_FN(PointCapture)(bgeo, pntId, j);
+			if (pWgt) {
+				pWgt[j] = capt.wght;
+			}
+			if (pIdx) {
+				pIdx[j] = capt.node;
+			}
+		}
+		for (j = 0; j < numVtxCapts; ++j) {
+			if (pIdx[j] < 0) {
+				pWgt[j] = 0.0f;
+			}
+			if (pWgt[j] <= 0.0f) {
+				pIdx[j] = 0;
+				pWgt[j] = 0.0f;
+			}
+		}
+	}
+}
+
+static int32_t bgeoNumVertexCaptures(const HBIN_BGEO bgeo, const int32_t maxWghts) {
+	int32_t numVtxCapts = 0;
+	int32_t maxCapts = 0;
+	if (maxWghts > 0) {
+		maxCapts = HBIN_BGEO_FN(MaxCapturesPerPoint)(bgeo);
+	}
+	if (maxCapts > 0) {
+		if (maxWghts < maxCapts) {
+			numVtxCapts = maxWghts;
+		} else {
+			numVtxCapts = maxCapts;
+		}
+	}
+	return numVtxCapts;
+}
+
+HBIN_BGEO_IFC(void, MakeVertexBuffer)(
+	const HBIN_BGEO bgeo,
+	void* pMem, const int32_t stride,
+	const int32_t posOffs, const int32_t nrmOffs,
+	const int32_t rgbOffs, const int32_t texOffs,
+	const int32_t wgtOffs, const int32_t idxOffs,
+	const int32_t maxWghts, int32_t* pInflCounts)
+{
+	HBIN_BGEO_FN(MakeVertexBufferNrm)(bgeo, pMem, stride, posOffs, nrmOffs, rgbOffs, texOffs, wgtOffs, idxOffs, maxWghts, pInflCounts, NULL);
+}
+
+HBIN_BGEO_IFC(void, MakeVertexBufferNrm)(
+	const HBIN_BGEO bgeo,
+	void* pMem, const int32_t stride,
+	const int32_t posOffs, const int32_t nrmOffs,
+	const int32_t rgbOffs, const int32_t texOffs,
+	const int32_t wgtOffs, const int32_t idxOffs,
+	const int32_t maxWghts, int32_t* pInflCounts,
+	const HBIN_FLOAT3* pNrm)
+{
+	int32_t i, j;
+	int32_t numVtxCapts = 0;
+	int32_t nvtx = 0;
+	int32_t numCaptNodes = 0;
+	if (!HBIN_BGEO_FN(Valid)(bgeo)) return;
+	if (!pMem) return;
+	if (stride <= 0) return;
+	nvtx = HBIN_BGEO_FN(NumPoints)(bgeo);
+	if (nvtx < 1) return;
+	if (wgtOffs > 0 && idxOffs > 0) {
+		numVtxCapts = bgeoNumVertexCaptures(bgeo, maxWghts);
+	}
+	if (pInflCounts) {
+		numCaptNodes = bgeoNumCaptureNodes(bgeo);
+		for (i = 0; i < numCaptNodes; ++i) {
+			pInflCounts[i] = 0;
+		}
+	}
+	for (i = 0; i < nvtx; ++i) {
+		uint8_t* pVtx = (uint8_t*)pMem + ((size_t)i * (size_t)stride);
+		bgeoWriteVertex(bgeo, i, pVtx, posOffs, nrmOffs, rgbOffs, texOffs, wgtOffs, idxOffs, maxWghts, numVtxCapts, pNrm);
+		if ((wgtOffs >= 0 || idxOffs >= 0) && pInflCounts) {
+			float* pWgt = (float*)(pVtx + wgtOffs);
+			int32_t* pIdx = (int32_t*)(pVtx + idxOffs);
+			for (j = 0; j < numVtxCapts; ++j) {
+				if (pWgt[j] > 0.0f) {
+					++pInflCounts[pIdx[j]];
+				}
+			}
+		}
+	}
+}
+
+HBIN_BGEO_IFC(void, GatherVertexBuffer)(
+	const HBIN_BGEO bgeo,
+	const int32_t* pPntIds, const int32_t nvtx,
+	void* pMem, const int32_t stride,
+	const int32_t posOffs, const int32_t nrmOffs,
+	const int32_t rgbOffs, const int32_t texOffs,
+	const int32_t wgtOffs, const int32_t idxOffs,
+	const int32_t maxWghts, const HBIN_FLOAT3* pNrm)
+{
+	int32_t i;
+	int32_t numVtxCapts = 0;
+	int32_t npts = HBIN_BGEO_FN(NumPoints)(bgeo);
+	if (!HBIN_BGEO_FN(Valid)(bgeo)) return;
+	if (!pPntIds || !pMem) return;
+	if (stride <= 0) return;
+	if (wgtOffs > 0 && idxOffs > 0) {
+		numVtxCapts = bgeoNumVertexCaptures(bgeo, maxWghts);
+	}
+	for (i = 0; i < nvtx; ++i) {
+		uint8_t* pVtx = (uint8_t*)pMem + ((size_t)i * (size_t)stride);
+		if ((uint32_t)pPntIds[i] < (uint32_t)npts) {
+			bgeoWriteVertex(bgeo, pPntIds[i], pVtx, posOffs, nrmOffs, rgbOffs, texOffs, wgtOffs, idxOffs, maxWghts, numVtxCapts, pNrm);
+		}
+	}
+}
+
+typedef struct _BGEO_NRM_WK {
+	const uint8_t* pPts;
+	int hostOrder;
+	int32_t pntRecSize;
+	int32_t npts;
+	int32_t weighting;
+	HBIN_FLOAT3* pNrm;
+} BGEO_NRM_WK;
+
+static void bgeoNrmWkPos(float* pPos, const BGEO_NRM_WK* pWk, const int32_t pntId) {
+	const uint8_t* pRec = pWk->pPts + ((size_t)pntId * (size_t)pWk->pntRecSize);
+	pPos[0] = hbinRecF32(pRec, pWk->hostOrder);
+	pPos[1] = hbinRecF32(pRec + 4, pWk->hostOrder);
+	pPos[2] = hbinRecF32(pRec + 8, pWk->hostOrder);
+}
+
+static int bgeoNrmCB(const HBIN_PRIM prim, void* pUserData) {
+	int32_t i, k;
+	int32_t nvtx;
+	float fnrm[3];
+	float flen;
+	float maxLen2 = 0.0f;
+	float pos[3], prev[3], next[3];
+	BGEO_NRM_WK* pWk = (BGEO_NRM_WK*)pUserData;
+	if (!pWk) return 0;
+	if (!bgeoPrimIsPoly(prim)) return 1;
+	nvtx = bgeoPrimNumVertices(prim);
+	if (nvtx < 3) return 1;
+	for (i = 0; i < nvtx; ++i) {
+		if ((uint32_t)bgeoPrimVertexPntId(prim, i) >= (uint32_t)pWk->npts) return 1;
+	}
+	/* Newell normal for clockwise front faces (Houdini), its length is twice the polygon area */
+	fnrm[0] = fnrm[1] = fnrm[2] = 0.0f;
+	bgeoNrmWkPos(prev, pWk, bgeoPrimVertexPntId(prim, nvtx - 1));
+	for (i = 0; i < nvtx; ++i) {
+		float elen2 = 0.0f;
+		bgeoNrmWkPos(pos, pWk, bgeoPrimVertexPntId(prim, i));
+		fnrm[0] += (pos[1] - prev[1]) * (prev[2] + pos[2]);
+		fnrm[1] += (pos[2] - prev[2]) * (prev[0] + pos[0]);
+		fnrm[2] += (pos[0] - prev[0]) * (prev[1] + pos[1]);
+		for (k = 0; k < 3; ++k) {
+			elen2 += (pos[k] - prev[k]) * (pos[k] - prev[k]);
+			prev[k] = pos[k];
+		}
+		if (elen2 > maxLen2) maxLen2 = elen2;
+	}
+	flen = hbinSqrtF((fnrm[0] * fnrm[0]) + (fnrm[1] * fnrm[1]) + (fnrm[2] * fnrm[2]));
+	/* collapsed polygons have no reliable orientation */
+	if (flen <= maxLen2 * 1.0e-5f) return 1;
+	if (pWk->weighting == HBIN_NRM_WEIGHT_AREA) {
+		for (i = 0; i < nvtx; ++i) {
+			float* pDst = pWk->pNrm[bgeoPrimVertexPntId(prim, i)];
+			for (k = 0; k < 3; ++k) {
+				pDst[k] += fnrm[k];
+			}
+		}
+		return 1;
+	}
+	for (k = 0; k < 3; ++k) {
+		fnrm[k] /= flen;
+	}
+	bgeoNrmWkPos(prev, pWk, bgeoPrimVertexPntId(prim, nvtx - 1));
+	bgeoNrmWkPos(pos, pWk, bgeoPrimVertexPntId(prim, 0));
+	for (i = 0; i < nvtx; ++i) {
+		float e0[3], e1[3];
+		float l0, l1, w;
+		float* pDst = pWk->pNrm[bgeoPrimVertexPntId(prim, i)];
+		bgeoNrmWkPos(next, pWk, bgeoPrimVertexPntId(prim, (i + 1) % nvtx));
+		for (k = 0; k < 3; ++k) {
+			e0[k] = prev[k] - pos[k];
+			e1[k] = next[k] - pos[k];
+		}
+		l0 = hbinSqrtF((e0[0] * e0[0]) + (e0[1] * e0[1]) + (e0[2] * e0[2]));
+		l1 = hbinSqrtF((e1[0] * e1[0]) + (e1[1] * e1[1]) + (e1[2] * e1[2]));
+		if (l0 > 0.0f && l1 > 0.0f) {
+			w = ((e0[0] * e1[0]) + (e0[1] * e1[1]) + (e0[2] * e1[2])) / (l0 * l1);
+			w = hbinAcosF(w < -1.0f ? -1.0f : (w > 1.0f ? 1.0f : w));
+			if (pWk->weighting == HBIN_NRM_WEIGHT_ANGLE_AREA) {
+				w *= flen;
+			}
+			for (k = 0; k < 3; ++k) {
+				pDst[k] += fnrm[k] * w;
+			}
+		}
+		for (k = 0; k < 3; ++k) {
+			prev[k] = pos[k];
+			pos[k] = next[k];
+		}
+	}
+	return 1;
+}
+
+HBIN_BGEO_IFC(int32_t, ComputePointNormals)(const HBIN_BGEO bgeo, HBIN_FLOAT3* pNrm, const int32_t weighting) {
+	int32_t i, k;
+	BGEO_NRM_WK wk;
+	int32_t npts = HBIN_BGEO_FN(NumPoints)(bgeo);
+	if (npts <= 0 || !pNrm) return 0;
+	for (i = 0; i < npts; ++i) {
+		for (k = 0; k < 3; ++k) {
+			pNrm[i][k] = 0.0f;
+		}
+	}
+	wk.pPts = NULL;
+	wk.pntRecSize = bgeoCalcPntRecSize(bgeo, &wk.pPts);
+	if (wk.pntRecSize <= 0 || !wk.pPts) return 0;
+	wk.hostOrder = bgeoHostOrder(bgeo);
+	wk.npts = npts;
+	wk.weighting = weighting;
+	wk.pNrm = pNrm;
+	HBIN_BGEO_FN(ForEachPrim)(bgeo, bgeoNrmCB, &wk);
+	for (i = 0; i < npts; ++i) {
+		float* pDst = pNrm[i];
+		float len = hbinSqrtF((pDst[0] * pDst[0]) + (pDst[1] * pDst[1]) + (pDst[2] * pDst[2]));
+		if (len > 0.0f) {
+			for (k = 0; k < 3; ++k) {
+				pDst[k] /= len;
+			}
+		}
+	}
+	return npts;
+}
+
+typedef struct _BGEO_GETTRIS_WK {
+	uint16_t* pIdx16;
+	uint32_t* pIdx32;
+	int32_t* pMtlIds;
+	int32_t triCount;
+	int32_t* pMtlCursor; /* [nmtl + 1], NULL: primitive order */
+	int32_t nmtl;
+} BGEO_GETTRIS_WK;
+
+/* material slot for counting sorts, triangles without a material go last */
+static int32_t hbinMtlSlot(const int32_t mtlId, const int32_t nmtl) {
+	return (mtlId >= 0 && mtlId < nmtl) ? mtlId : nmtl;
+}
+
+static int bgeoGetTrisCB(const HBIN_PRIM prim, void* pUserData) {
+	int32_t i;
+	BGEO_GETTRIS_WK* pWk = (BGEO_GETTRIS_WK*)pUserData;
+	if (!pWk) return 0;
+	if (bgeoPrimIsPoly(prim)) {
+		int32_t nvtx = bgeoPrimNumVertices(prim);
+		if (nvtx == 3) {
+			int32_t mtlId = bgeoPrimMaterialId(prim);
+			int32_t triId = pWk->pMtlCursor ? pWk->pMtlCursor[hbinMtlSlot(mtlId, pWk->nmtl)]++ : pWk->triCount;
+			if (pWk->pIdx16) {
+				size_t idxOrg = (size_t)triId * 3;
+				for (i = 0; i < 3; ++i) {
+					pWk->pIdx16[idxOrg + i] = (uint16_t)bgeoPrimVertexPntId(prim, i);
+				}
+			}
+			if (pWk->pIdx32) {
+				size_t idxOrg = (size_t)triId * 3;
+				for (i = 0; i < 3; ++i) {
+					pWk->pIdx32[idxOrg + i] = (uint32_t)bgeoPrimVertexPntId(prim, i);
+				}
+			}
+			if (pWk->pMtlIds) {
+				pWk->pMtlIds[triId] = mtlId;
+			}
+			++pWk->triCount;
+		}
+	}
+	return 1;
+}
+
+HBIN_BGEO_IFC(int32_t, GetTriangles)(
+	const HBIN_BGEO bgeo, uint16_t* pIdx16, uint32_t* pIdx32, int32_t* pMtlIds)
+{
+	return HBIN_BGEO_FN(GetTrianglesInGroup)(bgeo, NULL, pIdx16, pIdx32, pMtlIds);
+}
+
+HBIN_BGEO_IFC(int32_t, GetTrianglesInGroup)(
+	const HBIN_BGEO bgeo, const uint32_t* pPrimBits, uint16_t* pIdx16, uint32_t* pIdx32, int32_t* pMtlIds)
+{
+	int32_t ntris = 0;
+	int32_t nprim = HBIN_BGEO_FN(NumPrims)(bgeo);
+	if (pIdx16 && HBIN_BGEO_FN(TriangleIndexSize)(bgeo) != 2) return -1;
+	if (nprim > 0) {
+		BGEO_GETTRIS_WK wk;
+		wk.pIdx16 = pIdx16;
+		wk.pIdx32 = pIdx32;
+		wk.pMtlIds = pMtlIds;
+		wk.triCount = 0;
+		wk.pMtlCursor = NULL;
+		wk.nmtl = 0;
+		HBIN_BGEO_FN(ForEachPrimInGroup)(bgeo, pPrimBits, bgeoGetTrisCB, &wk);
+		ntris = wk.triCount;
+	}
+	return ntris;
+}
+
+HBIN_IFC(int32_t, SplitSubmeshes)(
+	const uint32_t* pTriIdx, const int32_t* pMtlIds, const int32_t ntris,
+	const HBIN_FLOAT3* pPos, const int32_t nvtx,
+	HBIN_SUBMESH* pSubmeshes, uint32_t* pSubIdx, int32_t* pSubPnts,
+	int32_t* pWk)
+{
+	int32_t i, j, k;
+	int32_t nsub = 0;
+	int32_t* pStamp;
+	int32_t* pLocal;
+	HBIN_SUBMESH sub;
+	if (!pTriIdx || !pMtlIds || ntris <= 0 || nvtx <= 0 || !pWk) return 0;
+	pStamp = pWk;
+	pLocal = pWk + nvtx;
+	for (i = 0; i < nvtx; ++i) {
+		pStamp[i] = 0;
+	}
+	sub.mtlId = pMtlIds[0];
+	sub.triOrg = 0;
+	sub.triCount = 0;
+	sub.vtxOrg = 0;
+	sub.vtxCount = 0;
+	for (k = 0; k < 3; ++k) {
+		sub.bboxMin[k] = 0.0f;
+		sub.bboxMax[k] = 0.0f;
+	}
+	for (i = 0; i < ntris; ++i) {
+		const uint32_t* pTri = pTriIdx + (i * 3);
+		if (pMtlIds[i] != sub.mtlId) {
+			if (pSubmeshes) {
+				pSubmeshes[nsub] = sub;
+			}
+			++nsub;
+			sub.mtlId = pMtlIds[i];
+			sub.triOrg += sub.triCount;
+			sub.vtxOrg += sub.vtxCount;
+			sub.triCount = 0;
+			sub.vtxCount = 0;
+		}
+		for (j = 0; j < 3; ++j) {
+			uint32_t vtxId = pTri[j];
+			if (vtxId >= (uint32_t)nvtx) return -1;
+			if (pStamp[vtxId] != nsub + 1) {
+				pStamp[vtxId] = nsub + 1;
+				pLocal[vtxId] = sub.vtxCount;
+				if (pSubPnts) {
+					pSubPnts[sub.vtxOrg + sub.vtxCount] = (int32_t)vtxId;
+				}
+				if (pPos) {
+					for (k = 0; k < 3; ++k) {
+						float val = pPos[vtxId][k];
+						if (sub.vtxCount == 0 || val < sub.bboxMin[k]) sub.bboxMin[k] = val;
+						if (sub.vtxCount == 0 || val > sub.bboxMax[k]) sub.bboxMax[k] = val;
+					}
+				}
+				++sub.vtxCount;
+			}
+			if (pSubIdx) {
+				pSubIdx[(i * 3) + j] = (uint32_t)pLocal[vtxId];
+			}
+		}
+		++sub.triCount;
+	}
+	if (sub.triCount > 0) {
+		if (pSubmeshes) {
+			pSubmeshes[nsub] = sub;
+		}
+		++nsub;
+	}
+	return nsub;
+}
+
+static void hbinMtlRanges(HBIN_MTL_RANGE* pRanges, int32_t* pCursor, const int32_t nmtl) {
+	int32_t i;
+	int32_t org = 0;
+	for (i = 0; i <= nmtl; ++i) {
+		int32_t cnt = pCursor[i];
+		if (pRanges) {
+			pRanges[i].mtlId = i < nmtl ? i : -1;
+			pRanges[i].idxOrg = org * 3;
+			pRanges[i].idxCount = cnt * 3;
+		}
+		pCursor[i] = org;
+		org += cnt;
+	}
+}
+
+HBIN_BGEO_IFC(int32_t, GetTrianglesByMaterial)(
+	const HBIN_BGEO bgeo, uint16_t* pIdx16, uint32_t* pIdx32, int32_t* pMtlIds,
+	HBIN_MTL_RANGE* pRanges, int32_t* pWk)
+{
+	int32_t i;
+	int32_t ntris = 0;
+	int32_t nprim = HBIN_BGEO_FN(NumPrims)(bgeo);
+	if (pIdx16 && HBIN_BGEO_FN(TriangleIndexSize)(bgeo) != 2) return -1;
+	if (nprim > 0 && pWk) {
+		BGEO_GETTRIS_WK wk;
+		wk.nmtl = HBIN_BGEO_FN(NumMaterials)(bgeo);
+		for (i = 0; i <= wk.nmtl; ++i) {
+			pWk[i] = 0;
+		}
+		wk.pIdx16 = NULL;
+		wk.pIdx32 = NULL;
+		wk.pMtlIds = NULL;
+		wk.triCount = 0;
+		wk.pMtlCursor = pWk;
+		HBIN_BGEO_FN(ForEachPrim)(bgeo, bgeoGetTrisCB, &wk);
+		hbinMtlRanges(pRanges, pWk, wk.nmtl);
+		wk.pIdx16 = pIdx16;
+		wk.pIdx32 = pIdx32;
+		wk.pMtlIds = pMtlIds;
+		wk.triCount = 0;
+		HBIN_BGEO_FN(ForEachPrim)(bgeo, bgeoGetTrisCB, &wk);
+		ntris = wk.triCount;
+	}
+	return ntris;
+}
+
+HBIN_IFC(void, SortTrianglesByMaterial)(
+	uint32_t* pDstIdx, int32_t* pDstMtlIds, HBIN_MTL_RANGE* pRanges,
+	const uint32_t* pSrcIdx, const int32_t* pSrcMtlIds, const int32_t ntris, const int32_t nmtl,
+	int32_t* pWk)
+{
+	int32_t i, k;
+	if (!pDstIdx || !pSrcIdx || !pSrcMtlIds || ntris <= 0 || nmtl < 0 || !pWk) return;
+	for (i = 0; i <= nmtl; ++i) {
+		pWk[i] = 0;
+	}
+	for (i = 0; i < ntris; ++i) {
+		++pWk[hbinMtlSlot(pSrcMtlIds[i], nmtl)];
+	}
+	hbinMtlRanges(pRanges, pWk, nmtl);
+	for (i = 0; i < ntris; ++i) {
+		int32_t triId = pWk[hbinMtlSlot(pSrcMtlIds[i], nmtl)]++;
+		for (k = 0; k < 3; ++k) {
+			pDstIdx[(triId * 3) + k] = pSrcIdx[(i * 3) + k];
+		}
+		if (pDstMtlIds) {
+			pDstMtlIds[triId] = pSrcMtlIds[i];
+		}
+	}
+}
+
+HBIN_IFC(HBIN_VCACHE_STATS, VertexCacheStats)(
+	const uint32_t* pTriIdx, const int32_t ntris, const int32_t nvtx, const int32_t cacheSize,
+	int32_t* pWk)
+{
+	int32_t i;
+	int32_t time = 0;
+	int32_t nused = 0;
+	HBIN_VCACHE_STATS stats;
+	stats.acmr = 0.0f;
+	stats.atvr = 0.0f;
+	stats.misses = 0;
+	if (!pTriIdx || ntris <= 0 || nvtx <= 0 || cacheSize <= 0 || !pWk) return stats;
+	/* FIFO cache: a vertex is resident while fewer than cacheSize misses followed its load */
+	for (i = 0; i < nvtx; ++i) {
+		pWk[i] = -1;
+	}
+	for (i = 0; i < ntris * 3; ++i) {
+		uint32_t vtxId = pTriIdx[i];
+		if (vtxId >= (uint32_t)nvtx) continue;
+		if (pWk[vtxId] < 0) {
+			++nused;
+		}
+		if (pWk[vtxId] < 0 || time - pWk[vtxId] >= cacheSize) {
+			pWk[vtxId] = time;
+			++time;
+		}
+	}
+	stats.misses = time;
+	stats.acmr = (float)time / (float)ntris;
+	stats.atvr = nused > 0 ? (float)time / (float)nused : 0.0f;
+	return stats;
+}
+
+HBIN_IFC(int32_t, VertexCacheWorkSize)(const int32_t ntris, const int32_t nvtx) {
+	return ((nvtx + 1) + (nvtx * 2) + ntris + (ntris * 3 * 3));
+}
+
+HBIN_IFC(int32_t, OptimizeVertexCache)(
+	int32_t* pTriOrder, int32_t* pClusters,
+	const uint32_t* pTriIdx, const int32_t ntris, const int32_t nvtx, const int32_t cacheSize,
+	int32_t* pWk)
+{
+	/* Tipsify: Sander, Nehab, Barczak, "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" */
+	int32_t i, j, k;
+	int32_t* pAdjOrg;
+	int32_t* pAdj;
+	int32_t* pLive;
+	int32_t* pTime;
+	int32_t* pDone;
+	int32_t* pDead;
+	int32_t* pCand;
+	int32_t ndead = 0;
+	int32_t ntriOut = 0;
+	int32_t nclusters = 0;
+	int32_t time;
+	int32_t cursor = 0;
+	int32_t fan = 0;
+	int32_t csize = cacheSize > 0 ? cacheSize : 16;
+	if (!pTriOrder || !pTriIdx || ntris <= 0 || nvtx <= 0 || !pWk) return 0;
+	pAdjOrg = pWk;
+	pLive = pAdjOrg + nvtx + 1;
+	pTime = pLive + nvtx;
+	pDone = pTime + nvtx;
+	pAdj = pDone + ntris;
+	pDead = pAdj + (ntris * 3);
+	pCand = pDead + (ntris * 3);
+	for (i = 0; i < nvtx; ++i) {
+		pLive[i] = 0;
+		pTime[i] = 0;
+	}
+	for (i = 0; i < ntris * 3; ++i) {
+		if (pTriIdx[i] >= (uint32_t)nvtx) return 0;
+		++pLive[pTriIdx[i]];
+	}
+	pAdjOrg[0] = 0;
+	for (i = 0; i < nvtx; ++i) {
+		pAdjOrg[i + 1] = pAdjOrg[i] + pLive[i];
+	}
+	for (i = 0; i < nvtx; ++i) {
+		pTime[i] = pAdjOrg[i];
+	}
+	for (i = 0; i < ntris; ++i) {
+		pDone[i] = 0;
+		for (j = 0; j < 3; ++j) {
+			uint32_t vtxId = pTriIdx[(i * 3) + j];
+			pAdj[pTime[vtxId]++] = i;
+		}
+	}
+	for (i = 0; i < nvtx; ++i) {
+		pTime[i] = 0;
+	}
+	time = csize + 1;
+	fan = (int32_t)pTriIdx[0];
+	if (pClusters) {
+		pClusters[nclusters] = 0;
+	}
+	++nclusters;
+	while (fan >= 0) {
+		int32_t ncand = 0;
+		int32_t best = -1;
+		int32_t bestPriority = -1;
+		for (i = pAdjOrg[fan]; i < pAdjOrg[fan + 1]; ++i) {
+			int32_t triId = pAdj[i];
+			if (pDone[triId]) continue;
+			pDone[triId] = 1;
+			pTriOrder[ntriOut++] = triId;
+			for (j = 0; j < 3; ++j) {
+				int32_t vtxId = (int32_t)pTriIdx[(triId * 3) + j];
+				pDead[ndead++] = vtxId;
+				pCand[ncand++] = vtxId;
+				--pLive[vtxId];
+				if (time - pTime[vtxId] > csize) {
+					pTime[vtxId] = time;
+					++time;
+				}
+			}
+		}
+		for (k = 0; k < ncand; ++k) {
+			int32_t vtxId = pCand[k];
+			if (pLive[vtxId] > 0) {
+				int32_t priority = 0;
+				if (time - pTime[vtxId] + (2 * pLive[vtxId]) <= csize) {
+					priority = time - pTime[vtxId];
+				}
+				if (priority > bestPriority) {
+					bestPriority = priority;
+					best = vtxId;
+				}
+			}
+		}
+		if (best < 0) {
+			/* dead end: restart from the most recent vertex with live triangles, or scan forward */
+			while (ndead > 0) {
+				int32_t vtxId = pDead[--ndead];
+				if (pLive[vtxId] > 0) {
+					best = vtxId;
+					break;
+				}
+			}
+			if (best < 0) {
+				while (cursor < nvtx) {
+					if (pLive[cursor] > 0) {
+						best = cursor;
+						break;
+					}
+					++cursor;
+				}
+			}
+			if (best >= 0 && ntriOut < ntris) {
+				if (pClusters) {
+					pClusters[nclusters] = ntriOut;
+				}
+				++nclusters;
+			}
+		}
+		fan = best;
+	}
+	/* triangles that reference no live vertex chain (can't happen with valid input) */
+	for (i = 0; i < ntris && ntriOut < ntris; ++i) {
+		if (!pDone[i]) {
+			pTriOrder[ntriOut++] = i;
+		}
+	}
+	if (pClusters) {
+		pClusters[nclusters] = ntris;
+	}
+	return nclusters;
+}
+
+/* stable bottom-up merge sort of pSorted[n] (indices into pKeys) */
+static void hbinSortByKeys(int32_t* pSorted, int32_t* pTmp, const float* pKeys, const int32_t n, const int descending) {
+	int32_t i, k;
+	int32_t width;
+	for (width = 1; width < n; width *= 2) {
+		for (i = 0; i < n; i += width * 2) {
+			int32_t lo = i;
+			int32_t mid = i + width < n ? i + width : n;
+			int32_t hi = i + (width * 2) < n ? i + (width * 2) : n;
+			int32_t a = lo;
+			int32_t b = mid;
+			for (k = lo; k < hi; ++k) {
+				int takeA = a < mid;
+				if (takeA && b < hi) {
+					takeA = descending ? pKeys[pSorted[a]] >= pKeys[pSorted[b]] : pKeys[pSorted[a]] <= pKeys[pSorted[b]];
+				}
+				if (takeA) {
+					pTmp[k] = pSorted[a++];
+				} else {
+					pTmp[k] = pSorted[b++];
+				}
+			}
+		}
+		for (i = 0; i < n; ++i) {
+			pSorted[i] = pTmp[i];
+		}
+	}
+}
+
+HBIN_IFC(int32_t, OverdrawWorkSize)(const int32_t ntris, const int32_t nvtx) {
+	return (nvtx + (ntris * 5) + 2);
+}
+
+HBIN_IFC(void, OptimizeOverdraw)(
+	int32_t* pTriOrder, const int32_t* pClusters, const int32_t nclusters,
+	const uint32_t* pTriIdx, const int32_t ntris,
+	const HBIN_FLOAT3* pPos, const int32_t nvtx,
+	const int32_t cacheSize, const float threshold,
+	int32_t* pWk)
+{
+	int32_t i, j, k;
+	int32_t* pTime;
+	int32_t* pOrgOrder;
+	int32_t* pSoft;
+	int32_t* pSorted;
+	int32_t* pTmp;
+	float* pKeys;
+	int32_t nsoft = 0;
+	int32_t csize = cacheSize > 0 ? cacheSize : 16;
+	float meshCtr[3];
+	float meshArea = 0.0f;
+	if (!pTriOrder || !pClusters || nclusters <= 0 || !pTriIdx || ntris <= 0 || !pPos || nvtx <= 0 || !pWk) return;
+	/* out-of-range input leaves pTriOrder as is */
+	for (i = 0; i < ntris * 3; ++i) {
+		if (pTriIdx[i] >= (uint32_t)nvtx) return;
+	}
+	for (i = 0; i < ntris; ++i) {
+		if ((uint32_t)pTriOrder[i] >= (uint32_t)ntris) return;
+	}
+	if (pClusters[0] != 0 || pClusters[nclusters] != ntris) return;
+	for (i = 0; i < nclusters; ++i) {
+		if (pClusters[i] > pClusters[i + 1]) return;
+	}
+	pTime = pWk;
+	pOrgOrder = pTime + nvtx;
+	pSoft = pOrgOrder + ntris;
+	pSorted = pSoft + ntris + 1;
+	pTmp = pSorted + ntris;
+	pKeys = (float*)(pTmp + ntris);
+	for (i = 0; i < ntris; ++i) {
+		pOrgOrder[i] = pTriOrder[i];
+	}
+	/* split hard clusters at points where the local ACMR is already close to the cluster's */
+	for (i = 0; i < nclusters; ++i) {
+		int32_t triOrg = pClusters[i];
+		int32_t triEnd = pClusters[i + 1];
+		int32_t misses = 0;
+		int32_t time = 0;
+		float acmr;
+		for (j = triOrg; j < triEnd; ++j) {
+			const uint32_t* pTri = pTriIdx + (pOrgOrder[j] * 3);
+			for (k = 0; k < 3; ++k) {
+				pTime[pTri[k]] = -csize - 1;
+			}
+		}
+		for (j = triOrg; j < triEnd; ++j) {
+			const uint32_t* pTri = pTriIdx + (pOrgOrder[j] * 3);
+			for (k = 0; k < 3; ++k) {
+				if (time - pTime[pTri[k]] > csize) {
+					pTime[pTri[k]] = time++;
+				}
+			}
+		}
+		misses = time;
+		acmr = triEnd > triOrg ? (float)misses / (float)(triEnd - triOrg) : 0.0f;
+		pSoft[nsoft++] = triOrg;
+		time = 0;
+		for (j = triOrg; j < triEnd; ++j) {
+			const uint32_t* pTri = pTriIdx + (pOrgOrder[j] * 3);
+			for (k = 0; k < 3; ++k) {
+				pTime[pTri[k]] = -csize - 1;
+			}
+		}
+		misses = 0;
+		for (j = triOrg; j < triEnd; ++j) {
+			const uint32_t* pTri = pTriIdx + (pOrgOrder[j] * 3);
+			int32_t start = pSoft[nsoft - 1];
+			for (k = 0; k < 3; ++k) {
+				if (time - pTime[pTri[k]] > csize) {
+					pTime[pTri[k]] = time++;
+					++misses;
+				}
+			}
+			if (j + 1 < triEnd && (float)misses / (float)(j + 1 - start) <= acmr * threshold) {
+				pSoft[nsoft++] = j + 1;
+				misses = 0;
+				time += csize + 1; /* flush */
+			}
+		}
+	}
+	pSoft[nsoft] = ntris;
+	meshCtr[0] = 0.0f;
+	meshCtr[1] = 0.0f;
+	meshCtr[2] = 0.0f;
+	for (i = 0; i < ntris; ++i) {
+		const uint32_t* pTri = pTriIdx + (i * 3);
+		const float* p0 = pPos[pTri[0]];
+		const float* p1 = pPos[pTri[1]];
+		const float* p2 = pPos[pTri[2]];
+		float e1[3], e2[3], n[3];
+		float area;
+		for (k = 0; k < 3; ++k) {
+			e1[k] = p1[k] - p0[k];
+			e2[k] = p2[k] - p0[k];
+		}
+		n[0] = (e1[1] * e2[2]) - (e1[2] * e2[1]);
+		n[1] = (e1[2] * e2[0]) - (e1[0] * e2[2]);
+		n[2] = (e1[0] * e2[1]) - (e1[1] * e2[0]);
+		area = hbinSqrtF((n[0] * n[0]) + (n[1] * n[1]) + (n[2] * n[2]));
+		for (k = 0; k < 3; ++k) {
+			meshCtr[k] += ((p0[k] + p1[k] + p2[k]) / 3.0f) * area;
+		}
+		meshArea += area;
+	}
+	if (meshArea > 0.0f) {
+		for (k = 0; k < 3; ++k) {
+			meshCtr[k] /= meshArea;
+		}
+	}
+	/* clusters facing away from the mesh center are drawn first; Houdini front faces are clockwise */
+	for (i = 0; i < nsoft; ++i) {
+		float ctr[3], nrm[3];
+		float area = 0.0f;
+		float nlen;
+		ctr[0] = ctr[1] = ctr[2] = 0.0f;
+		nrm[0] = nrm[1] = nrm[2] = 0.0f;
+		for (j = pSoft[i]; j < pSoft[i + 1]; ++j) {
+			const uint32_t* pTri = pTriIdx + (pOrgOrder[j] * 3);
+			const float* p0 = pPos[pTri[0]];
+			const float* p1 = pPos[pTri[1]];
+			const float* p2 = pPos[pTri[2]];
+			float e1[3], e2[3], n[3];
+			float triArea;
+			for (k = 0; k < 3; ++k) {
+				e1[k] = p2[k] - p0[k];
+				e2[k] = p1[k] - p0[k];
+			}
+			n[0] = (e1[1] * e2[2]) - (e1[2] * e2[1]);
+			n[1] = (e1[2] * e2[0]) - (e1[0] * e2[2]);
+			n[2] = (e1[0] * e2[1]) - (e1[1] * e2[0]);
+			triArea = hbinSqrtF((n[0] * n[0]) + (n[1] * n[1]) + (n[2] * n[2]));
+			for (k = 0; k < 3; ++k) {
+				ctr[k] += ((p0[k] + p1[k] + p2[k]) / 3.0f) * triArea;
+				nrm[k] += n[k];
+			}
+			area += triArea;
+		}
+		if (area > 0.0f) {
+			for (k = 0; k < 3; ++k) {
+				ctr[k] /= area;
+			}
+		}
+		nlen = hbinSqrtF((nrm[0] * nrm[0]) + (nrm[1] * nrm[1]) + (nrm[2] * nrm[2]));
+		pKeys[i] = 0.0f;
+		if (nlen > 0.0f) {
+			for (k = 0; k < 3; ++k) {
+				pKeys[i] += (ctr[k] - meshCtr[k]) * (nrm[k] / nlen);
+			}
+		}
+		pSorted[i] = i;
+	}
+	hbinSortByKeys(pSorted, pTmp, pKeys, nsoft, 1);
+	k = 0;
+	for (i = 0; i < nsoft; ++i) {
+		int32_t c = pSorted[i];
+		for (j = pSoft[c]; j < pSoft[c + 1]; ++j) {
+			pTriOrder[k++] = pOrgOrder[j];
+		}
+	}
+}
+
+HBIN_IFC(void, ReorderTriangles)(uint32_t* pDstIdx, const uint32_t* pSrcIdx, const int32_t* pTriOrder, const int32_t ntris) {
+	int32_t i;
+	if (!pDstIdx || !pSrcIdx || !pTriOrder) return;
+	for (i = 0; i < ntris; ++i) {
+		const uint32_t* pSrc = pSrcIdx + (pTriOrder[i] * 3);
+		uint32_t* pDst = pDstIdx + (i * 3);
+		pDst[0] = pSrc[0];
+		pDst[1] = pSrc[1];
+		pDst[2] = pSrc[2];
+	}
+}
+
+HBIN_IFC(int32_t, VertexFetchRemap)(int32_t* pRemap, const uint32_t* pIdx, const int32_t nidx, const int32_t nvtx) {
+	int32_t i;
+	int32_t nused = 0;
+	if (!pRemap || nvtx <= 0) return 0;
+	for (i = 0; i < nvtx; ++i) {
+		pRemap[i] = -1;
+	}
+	if (pIdx) {
+		for (i = 0; i < nidx; ++i) {
+			uint32_t vtxId = pIdx[i];
+			if (vtxId < (uint32_t)nvtx && pRemap[vtxId] < 0) {
+				pRemap[vtxId] = nused++;
+			}
+		}
+	}
+	return nused;
+}
+
+HBIN_IFC(void, RemapIndices)(uint32_t* pIdx, const int32_t nidx, const int32_t* pRemap, const int32_t nvtx) {
+	int32_t i;
+	if (!pIdx || !pRemap) return;
+	for (i = 0; i < nidx; ++i) {
+		uint32_t vtxId = pIdx[i];
+		pIdx[i] = vtxId < (uint32_t)nvtx ? (uint32_t)pRemap[vtxId] : (uint32_t)-1;
+	}
+}
+
+HBIN_IFC(int32_t, BuildMeshlets)(
+	HBIN_MESHLET* pMeshlets, uint32_t* pMeshletVtx, uint8_t* pMeshletTris,
+	const uint32_t* pTriIdx, const int32_t ntris, const int32_t nvtx,
+	const int32_t maxVtx, const int32_t maxTris,
+	int32_t* pWk)
+{
+	int32_t i, j;
+	int32_t nmeshlets = 0;
+	int32_t* pStamp;
+	int32_t* pLocal;
+	HBIN_MESHLET meshlet;
+	if (!pTriIdx || ntris <= 0 || nvtx <= 0 || !pWk) return 0;
+	if (maxVtx < 3 || maxVtx > 256 || maxTris < 1) return 0;
+	pStamp = pWk;
+	pLocal = pWk + nvtx;
+	for (i = 0; i < nvtx; ++i) {
+		pStamp[i] = 0;
+	}
+	meshlet.vtxOrg = 0;
+	meshlet.vtxCount = 0;
+	meshlet.triOrg = 0;
+	meshlet.triCount = 0;
+	for (i = 0; i < ntris; ++i) {
+		const uint32_t* pTri = pTriIdx + (i * 3);
+		int32_t numNew = 0;
+		for (j = 0; j < 3; ++j) {
+			if (pTri[j] >= (uint32_t)nvtx) return -1;
+			if (pStamp[pTri[j]] != nmeshlets + 1) {
+				if (j == 0 || (pTri[j] != pTri[0] && (j == 1 || pTri[j] != pTri[1]))) {
+					++numNew;
+				}
+			}
+		}
+		if (meshlet.vtxCount + numNew > maxVtx || meshlet.triCount >= maxTris) {
+			if (pMeshlets) {
+				pMeshlets[nmeshlets] = meshlet;
+			}
+			++nmeshlets;
+			meshlet.vtxOrg += meshlet.vtxCount;
+			meshlet.triOrg += meshlet.triCount;
+			meshlet.vtxCount = 0;
+			meshlet.triCount = 0;
+		}
+		for (j = 0; j < 3; ++j) {
+			uint32_t vtxId = pTri[j];
+			if (pStamp[vtxId] != nmeshlets + 1) {
+				pStamp[vtxId] = nmeshlets + 1;
+				pLocal[vtxId] = meshlet.vtxCount;
+				if (pMeshletVtx) {
+					pMeshletVtx[meshlet.vtxOrg + meshlet.vtxCount] = vtxId;
+				}
+				++meshlet.vtxCount;
+			}
+			if (pMeshletTris) {
+				pMeshletTris[(i * 3) + j] = (uint8_t)pLocal[vtxId];
+			}
+		}
+		++meshlet.triCount;
+	}
+	if (meshlet.triCount > 0) {
+		if (pMeshlets) {
+			pMeshlets[nmeshlets] = meshlet;
+		}
+		++nmeshlets;
+	}
+	return nmeshlets;
+}
+
+HBIN_IFC(HBIN_MESHLET_BOUNDS, MeshletBounds)(
+	const HBIN_MESHLET* pMeshlet, const uint32_t* pMeshletVtx, const uint8_t* pMeshletTris,
+	const HBIN_FLOAT3* pPos, const int32_t nvtx)
+{
+	int32_t i, j, k;
+	HBIN_MESHLET_BOUNDS bounds;
+	const uint32_t* pVtx;
+	const uint8_t* pTris;
+	float axis[3];
+	float alen;
+	float mindp = 1.0f;
+	float maxt = 0.0f;
+	int32_t nvalid = 0;
+	for (k = 0; k < 3; ++k) {
+		bounds.center[k] = 0.0f;
+		bounds.coneApex[k] = 0.0f;
+		bounds.coneAxis[k] = 0.0f;
+		axis[k] = 0.0f;
+	}
+	bounds.radius = 0.0f;
+	bounds.coneCutoff = 1.0f;
+	if (!pMeshlet || !pMeshletVtx || !pMeshletTris || !pPos || pMeshlet->vtxCount <= 0) return bounds;
+	pVtx = pMeshletVtx + pMeshlet->vtxOrg;
+	pTris = pMeshletTris + (pMeshlet->triOrg * 3);
+	for (i = 0; i < pMeshlet->vtxCount; ++i) {
+		if (pVtx[i] >= (uint32_t)nvtx) return bounds;
+	}
+	/* Ritter's sphere: start from the most distant pair along x, y or z, then grow */
+	{
+		int32_t pmin[3], pmax[3];
+		float span = -1.0f;
+		int32_t i0 = 0;
+		int32_t i1 = 0;
+		for (k = 0; k < 3; ++k) {
+			pmin[k] = 0;
+			pmax[k] = 0;
+		}
+		for (i = 1; i < pMeshlet->vtxCount; ++i) {
+			const float* p = pPos[pVtx[i]];
+			for (k = 0; k < 3; ++k) {
+				if (p[k] < pPos[pVtx[pmin[k]]][k]) pmin[k] = i;
+				if (p[k] > pPos[pVtx[pmax[k]]][k]) pmax[k] = i;
+			}
+		}
+		for (k = 0; k < 3; ++k) {
+			const float* pa = pPos[pVtx[pmin[k]]];
+			const float* pb = pPos[pVtx[pmax[k]]];
+			float d2 = ((pb[0] - pa[0]) * (pb[0] - pa[0])) + ((pb[1] - pa[1]) * (pb[1] - pa[1])) + ((pb[2] - pa[2]) * (pb[2] - pa[2]));
+			if (d2 > span) {
+				span = d2;
+				i0 = pmin[k];
+				i1 = pmax[k];
+			}
+		}
+		for (k = 0; k < 3; ++k) {
+			bounds.center[k] = (pPos[pVtx[i0]][k] + pPos[pVtx[i1]][k]) * 0.5f;
+		}
+		bounds.radius = hbinSqrtF(span) * 0.5f;
+		for (i = 0; i < pMeshlet->vtxCount; ++i) {
+			const float* p = pPos[pVtx[i]];
+			float d[3];
+			float dist;
+			for (k = 0; k < 3; ++k) {
+				d[k] = p[k] - bounds.center[k];
+			}
+			dist = hbinSqrtF((d[0] * d[0]) + (d[1] * d[1]) + (d[2] * d[2]));
+			if (dist > bounds.radius) {
+				float grow = (dist - bounds.radius) * 0.5f;
+				bounds.radius += grow;
+				for (k = 0; k < 3; ++k) {
+					bounds.center[k] += d[k] * (grow / dist);
+				}
+			}
+		}
+	}
+	/* normal cone; Houdini triangles are clockwise when front-facing, so n = cross(p2 - p0, p1 - p0) */
+	for (i = 0; i < pMeshlet->triCount; ++i) {
+		const float* p0 = pPos[pVtx[pTris[(i * 3)]]];
+		const float* p1 = pPos[pVtx[pTris[(i * 3) + 1]]];
+		const float* p2 = pPos[pVtx[pTris[(i * 3) + 2]]];
+		float e1[3], e2[3], n[3];
+		float nlen;
+		for (k = 0; k < 3; ++k) {
+			e1[k] = p2[k] - p0[k];
+			e2[k] = p1[k] - p0[k];
+		}
+		n[0] = (e1[1] * e2[2]) - (e1[2] * e2[1]);
+		n[1] = (e1[2] * e2[0]) - (e1[0] * e2[2]);
+		n[2] = (e1[0] * e2[1]) - (e1[1] * e2[0]);
+		nlen = hbinSqrtF((n[0] * n[0]) + (n[1] * n[1]) + (n[2] * n[2]));
+		if (nlen > 0.0f) {
+			for (k = 0; k < 3; ++k) {
+				axis[k] += n[k] / nlen;
+			}
+			++nvalid;
+		}
+	}
+	alen = hbinSqrtF((axis[0] * axis[0]) + (axis[1] * axis[1]) + (axis[2] * axis[2]));
+	if (nvalid == 0 || alen <= 0.0f) return bounds;
+	for (k = 0; k < 3; ++k) {
+		axis[k] /= alen;
+		bounds.coneAxis[k] = axis[k];
+	}
+	for (j = 0; j < 2; ++j) {
+		/* j == 0: widest angle, j == 1: apex offset */
+		for (i = 0; i < pMeshlet->triCount; ++i) {
+			const float* p0 = pPos[pVtx[pTris[(i * 3)]]];
+			const float* p1 = pPos[pVtx[pTris[(i * 3) + 1]]];
+			const float* p2 = pPos[pVtx[pTris[(i * 3) + 2]]];
+			float e1[3], e2[3], n[3];
+			float nlen, dp;
+			for (k = 0; k < 3; ++k) {
+				e1[k] = p2[k] - p0[k];
+				e2[k] = p1[k] - p0[k];
+			}
+			n[0] = (e1[1] * e2[2]) - (e1[2] * e2[1]);
+			n[1] = (e1[2] * e2[0]) - (e1[0] * e2[2]);
+			n[2] = (e1[0] * e2[1]) - (e1[1] * e2[0]);
+			nlen = hbinSqrtF((n[0] * n[0]) + (n[1] * n[1]) + (n[2] * n[2]));
+			if (nlen <= 0.0f) continue;
+			for (k = 0; k < 3; ++k) {
+				n[k] /= nlen;
+			}
+			dp = (n[0] * axis[0]) + (n[1] * axis[1]) + (n[2] * axis[2]);
+			if (j == 0) {
+				if (dp < mindp) {
+					mindp = dp;
+				}
+			} else {
+				float dc = ((bounds.center[0] - p0[0]) * n[0]) + ((bounds.center[1] - p0[1]) * n[1]) + ((bounds.center[2] - p0[2]) * n[2]);
+				float t = dc / dp;
+				if (t > maxt) {
+					maxt = t;
+				}
+			}
+		}
+		if (j == 0 && mindp <= 0.1f) {
+			/* cone is too wide to ever reject the meshlet */
+			for (k = 0; k < 3; ++k) {
+				bounds.coneApex[k] = bounds.center[k];
+			}
+			return bounds;
+		}
+	}
+	for (k = 0; k < 3; ++k) {
+		bounds.coneApex[k] = bounds.center[k] - (axis[k] * maxt);
+	}
+	bounds.coneCutoff = hbinSqrtF(1.0f - (mindp * mindp));
+	return bounds;
+}
+
+#define HBIN_SIMPLIFY_MAX_PASSES 64
+#define HBIN_SIMPLIFY_BORDER_WEIGHT 10.0f
+
+#define HBIN_VTX_FREE 0
+#define HBIN_VTX_BORDER 1
+#define HBIN_VTX_LOCKED 2
+
+static int32_t hbinSimplifyHashSize(const int32_t nvtx) {
+	int32_t size = 1;
+	while (size < nvtx * 2) {
+		size <<= 1;
+	}
+	return size;
+}
+
+static void hbinQuadricAdd(float* pQ, const float* pPlane, const float w) {
+	float a = pPlane[0];
+	float b = pPlane[1];
+	float c = pPlane[2];
+	float d = pPlane[3];
+	pQ[0] += a * a * w;
+	pQ[1] += b * b * w;
+	pQ[2] += c * c * w;
+	pQ[3] += a * b * w;
+	pQ[4] += a * c * w;
+	pQ[5] += b * c * w;
+	pQ[6] += a * d * w;
+	pQ[7] += b * d * w;
+	pQ[8] += c * d * w;
+	pQ[9] += d * d * w;
+	pQ[10] += w;
+}
+
+static float hbinQuadricError(const float* pQ, const float* p) {
+	float x = p[0];
+	float y = p[1];
+	float z = p[2];
+	float err = (pQ[0] * x * x) + (pQ[1] * y * y) + (pQ[2] * z * z)
+	          + 2.0f * ((pQ[3] * x * y) + (pQ[4] * x * z) + (pQ[5] * y * z))
+	          + 2.0f * ((pQ[6] * x) + (pQ[7] * y) + (pQ[8] * z))
+	          + pQ[9];
+	if (err < 0.0f) err = 0.0f;
+	return pQ[10] > 0.0f ? err / pQ[10] : err;
+}
+
+static int hbinTriDead(const uint32_t* pTri) {
+	return pTri[0] == pTri[1] || pTri[0] == pTri[2] || pTri[1] == pTri[2];
+}
+
+/* normalized position: (pos - org) * scale */
+static void hbinSimplifyPos(float* pDst, const HBIN_FLOAT3* pPos, const uint32_t vtxId, const float* pOrg, const float scale) {
+	int k;
+	for (k = 0; k < 3; ++k) {
+		pDst[k] = (pPos[vtxId][k] - pOrg[k]) * scale;
+	}
+}
+
+static void hbinTriNormal(float* pNrm, const float* p0, const float* p1, const float* p2) {
+	float e1[3], e2[3];
+	int k;
+	for (k = 0; k < 3; ++k) {
+		e1[k] = p1[k] - p0[k];
+		e2[k] = p2[k] - p0[k];
+	}
+	pNrm[0] = (e1[1] * e2[2]) - (e1[2] * e2[1]);
+	pNrm[1] = (e1[2] * e2[0]) - (e1[0] * e2[2]);
+	pNrm[2] = (e1[0] * e2[1]) - (e1[1] * e2[0]);
+}
+
+/* number of live triangles around a that also use b */
+static int32_t hbinEdgeTriCount(const uint32_t* pIdx, const int32_t* pAdjOrg, const int32_t* pAdj, const uint32_t a, const uint32_t b) {
+	int32_t i;
+	int32_t cnt = 0;
+	for (i = pAdjOrg[a]; i < pAdjOrg[a + 1]; ++i) {
+		const uint32_t* pTri = pIdx + (pAdj[i] * 3);
+		if (hbinTriDead(pTri)) continue;
+		if (pTri[0] == b || pTri[1] == b || pTri[2] == b) ++cnt;
+	}
+	return cnt;
+}
+
+static int hbinCollapseAllowed(const int32_t* pKind, const uint32_t* pIdx, const int32_t* pAdjOrg, const int32_t* pAdj, const uint32_t u, const uint32_t v) {
+	if (pKind[u] == HBIN_VTX_LOCKED) return 0;
+	if (pKind[u] == HBIN_VTX_BORDER) {
+		/* border vertices only slide along the border */
+		if (pKind[v] == HBIN_VTX_FREE) return 0;
+		if (hbinEdgeTriCount(pIdx, pAdjOrg, pAdj, u, v) != 1) return 0;
+	}
+	return 1;
+}
+
+static int hbinCollapseFlips(const uint32_t* pIdx, const int32_t* pAdjOrg, const int32_t* pAdj, const HBIN_FLOAT3* pPos, const uint32_t u, const uint32_t v) {
+	int32_t i, k;
+	for (i = pAdjOrg[u]; i < pAdjOrg[u + 1]; ++i) {
+		const uint32_t* pTri = pIdx + (pAdj[i] * 3);
+		float p[3][3];
+		float n0[3], n1[3];
+		float d, l0, l1;
+		if (hbinTriDead(pTri)) continue;
+		if (pTri[0] == v || pTri[1] == v || pTri[2] == v) continue;
+		for (k = 0; k < 3; ++k) {
+			p[k][0] = pPos[pTri[k]][0];
+			p[k][1] = pPos[pTri[k]][1];
+			p[k][2] = pPos[pTri[k]][2];
+		}
+		hbinTriNormal(n0, p[0], p[1], p[2]);
+		for (k = 0; k < 3; ++k) {
+			if (pTri[k] == u) {
+				p[k][0] = pPos[v][0];
+				p[k][1] = pPos[v][1];
+				p[k][2] = pPos[v][2];
+			}
+		}
+		hbinTriNormal(n1, p[0], p[1], p[2]);
+		d = (n0[0] * n1[0]) + (n0[1] * n1[1]) + (n0[2] * n1[2]);
+		l0 = hbinSqrtF((n0[0] * n0[0]) + (n0[1] * n0[1]) + (n0[2] * n0[2]));
+		l1 = hbinSqrtF((n1[0] * n1[0]) + (n1[1] * n1[1]) + (n1[2] * n1[2]));
+		if (l1 <= 0.0f || d < 0.25f * l0 * l1) return 1;
+	}
+	return 0;
+}
+
+HBIN_IFC(int32_t, SimplifyWorkSize)(const int32_t ntris, const int32_t nvtx) {
+	int32_t candSize = ntris * 15;
+	int32_t hashSize = hbinSimplifyHashSize(nvtx);
+	return (nvtx * 13) + 1 + (ntris * 3) + (candSize > hashSize ? candSize : hashSize);
+}
+
+HBIN_IFC(int32_t, Simplify)(
+	uint32_t* pDstIdx, int32_t* pDstMtlIds,
+	const uint32_t* pSrcIdx, const int32_t* pSrcMtlIds, const int32_t ntris,
+	const HBIN_FLOAT3* pPos, const int32_t nvtx, const uint8_t* pVtxLock,
+	const int32_t targetTris, const float targetError, float* pError,
+	int32_t* pWk)
+{
+	int32_t i, j, k;
+	int32_t* pKind;
+	int32_t* pStamp;
+	float* pQ;
+	int32_t* pAdjOrg;
+	int32_t* pAdj;
+	int32_t* pCandU;
+	int32_t* pCandV;
+	float* pCandCost;
+	int32_t* pSorted;
+	int32_t* pTmp;
+	int32_t* pHash;
+	int32_t hashSize;
+	int32_t ntri = 0;
+	int32_t npass;
+	float org[3], lim[3];
+	float ext = 0.0f;
+	float scale;
+	float maxErr2 = targetError * targetError;
+	float err2 = 0.0f;
+	if (pError) *pError = 0.0f;
+	if (!pDstIdx || !pSrcIdx || ntris <= 0 || !pPos || nvtx <= 0 || !pWk) return 0;
+	pKind = pWk;
+	pStamp = pKind + nvtx;
+	pQ = (float*)(pStamp + nvtx);
+	pAdjOrg = (int32_t*)(pQ + (nvtx * 11));
+	pAdj = pAdjOrg + nvtx + 1;
+	pCandU = pAdj + (ntris * 3);
+	pCandV = pCandU + (ntris * 3);
+	pCandCost = (float*)(pCandV + (ntris * 3));
+	pSorted = (int32_t*)(pCandCost + (ntris * 3));
+	pTmp = pSorted + (ntris * 3);
+	pHash = pCandU;
+	hashSize = hbinSimplifyHashSize(nvtx);
+	for (i = 0; i < ntris * 3; ++i) {
+		if (pSrcIdx[i] >= (uint32_t)nvtx) return -1;
+	}
+	for (i = 0; i < ntris * 3; ++i) {
+		pDstIdx[i] = pSrcIdx[i];
+	}
+	for (i = 0; i < ntris; ++i) {
+		if (!hbinTriDead(pDstIdx + (i * 3))) ++ntri;
+	}
+	/* mesh bounds, quadrics are built in normalized coordinates so that errors are relative to the mesh extent */
+	for (i = 0; i < nvtx; ++i) {
+		pKind[i] = -1; /* unreferenced */
+		pStamp[i] = 0;
+	}
+	for (i = 0; i < ntris * 3; ++i) {
+		pKind[pDstIdx[i]] = HBIN_VTX_FREE;
+	}
+	j = 0;
+	for (i = 0; i < nvtx; ++i) {
+		if (pKind[i] < 0) continue;
+		for (k = 0; k < 3; ++k) {
+			if (j == 0 || pPos[i][k] < org[k]) org[k] = pPos[i][k];
+			if (j == 0 || pPos[i][k] > lim[k]) lim[k] = pPos[i][k];
+		}
+		j = 1;
+	}
+	for (k = 0; k < 3; ++k) {
+		if (lim[k] - org[k] > ext) ext = lim[k] - org[k];
+	}
+	scale = ext > 0.0f ? 1.0f / ext : 1.0f;
+	/* points sharing a position with another point are UV/normal seams and stay put */
+	for (i = 0; i < hashSize; ++i) {
+		pHash[i] = -1;
+	}
+	for (i = 0; i < nvtx; ++i) {
+		uint32_t h = 2166136261U;
+		uint8_t bits[sizeof(float) * 3];
+		if (pKind[i] < 0) continue;
+		for (k = 0; k < 3; ++k) {
+			float f = pPos[i][k] == 0.0f ? 0.0f : pPos[i][k];
+			hbinMemCpy(&bits[k * sizeof(float)], &f, sizeof(float));
+		}
+		for (k = 0; k < (int32_t)sizeof(bits); ++k) {
+			h = (h ^ bits[k]) * 16777619U;
+		}
+		h &= (uint32_t)(hashSize - 1);
+		while (pHash[h] >= 0) {
+			int32_t other = pHash[h];
+			if (pPos[other][0] == pPos[i][0] && pPos[other][1] == pPos[i][1] && pPos[other][2] == pPos[i][2]) {
+				pKind[other] = HBIN_VTX_LOCKED;
+				pKind[i] = HBIN_VTX_LOCKED;
+				break;
+			}
+			h = (h + 1) & (uint32_t)(hashSize - 1);
+		}
+		if (pHash[h] < 0) {
+			pHash[h] = i;
+		}
+	}
+	if (pVtxLock) {
+		for (i = 0; i < nvtx; ++i) {
+			if (pVtxLock[i] && pKind[i] >= 0) pKind[i] = HBIN_VTX_LOCKED;
+		}
+	}
+	/* initial adjacency */
+	for (i = 0; i <= nvtx; ++i) {
+		pAdjOrg[i] = 0;
+	}
+	for (i = 0; i < ntris; ++i) {
+		const uint32_t* pTri = pDstIdx + (i * 3);
+		if (hbinTriDead(pTri)) continue;
+		for (k = 0; k < 3; ++k) {
+			++pAdjOrg[pTri[k] + 1];
+		}
+	}
+	for (i = 0; i < nvtx; ++i) {
+		pAdjOrg[i + 1] += pAdjOrg[i];
+	}
+	for (i = 0; i < ntris; ++i) {
+		const uint32_t* pTri = pDstIdx + (i * 3);
+		if (hbinTriDead(pTri)) continue;
+		for (k = 0; k < 3; ++k) {
+			pAdj[pAdjOrg[pTri[k]]++] = i;
+		}
+	}
+	for (i = nvtx; i > 0; --i) {
+		pAdjOrg[i] = pAdjOrg[i - 1];
+	}
+	pAdjOrg[0] = 0;
+	/* material boundaries are locked */
+	if (pSrcMtlIds) {
+		for (i = 0; i < nvtx; ++i) {
+			for (j = pAdjOrg[i] + 1; j < pAdjOrg[i + 1]; ++j) {
+				if (pSrcMtlIds[pAdj[j]] != pSrcMtlIds[pAdj[pAdjOrg[i]]]) {
+					pKind[i] = HBIN_VTX_LOCKED;
+					break;
+				}
+			}
+		}
+	}
+	/* face quadrics, plus plane constraints along open borders */
+	for (i = 0; i < nvtx * 11; ++i) {
+		pQ[i] = 0.0f;
+	}
+	for (i = 0; i < ntris; ++i) {
+		const uint32_t* pTri = pDstIdx + (i * 3);
+		float p[3][3];
+		float n[3];
+		float plane[4];
+		float len;
+		if (hbinTriDead(pTri)) continue;
+		for (k = 0; k < 3; ++k) {
+			hbinSimplifyPos(p[k], pPos, pTri[k], org, scale);
+		}
+		hbinTriNormal(n, p[0], p[1], p[2]);
+		len = hbinSqrtF((n[0] * n[0]) + (n[1] * n[1]) + (n[2] * n[2]));
+		if (len <= 0.0f) continue;
+		for (k = 0; k < 3; ++k) {
+			plane[k] = n[k] / len;
+		}
+		plane[3] = -((plane[0] * p[0][0]) + (plane[1] * p[0][1]) + (plane[2] * p[0][2]));
+		for (k = 0; k < 3; ++k) {
+			hbinQuadricAdd(pQ + (pTri[k] * 11), plane, len * 0.5f);
+		}
+		for (k = 0; k < 3; ++k) {
+			uint32_t a = pTri[k];
+			uint32_t b = pTri[(k + 1) % 3];
+			if (hbinEdgeTriCount(pDstIdx, pAdjOrg, pAdj, a, b) == 1) {
+				const float* pa = p[k];
+				const float* pb = p[(k + 1) % 3];
+				float e[3], bn[3];
+				float elen;
+				for (j = 0; j < 3; ++j) {
+					e[j] = pb[j] - pa[j];
+				}
+				bn[0] = (e[1] * plane[2]) - (e[2] * plane[1]);
+				bn[1] = (e[2] * plane[0]) - (e[0] * plane[2]);
+				bn[2] = (e[0] * plane[1]) - (e[1] * plane[0]);
+				elen = hbinSqrtF((bn[0] * bn[0]) + (bn[1] * bn[1]) + (bn[2] * bn[2]));
+				if (elen > 0.0f) {
+					float bplane[4];
+					for (j = 0; j < 3; ++j) {
+						bplane[j] = bn[j] / elen;
+					}
+					bplane[3] = -((bplane[0] * pa[0]) + (bplane[1] * pa[1]) + (bplane[2] * pa[2]));
+					hbinQuadricAdd(pQ + (a * 11), bplane, elen * elen * HBIN_SIMPLIFY_BORDER_WEIGHT);
+					hbinQuadricAdd(pQ + (b * 11), bplane, elen * elen * HBIN_SIMPLIFY_BORDER_WEIGHT);
+				}
+				if (pKind[a] == HBIN_VTX_FREE) pKind[a] = HBIN_VTX_BORDER;
+				if (pKind[b] == HBIN_VTX_FREE) pKind[b] = HBIN_VTX_BORDER;
+			}
+		}
+	}
+	for (npass = 0; npass < HBIN_SIMPLIFY_MAX_PASSES && ntri > targetTris; ++npass) {
+		int32_t ncand = 0;
+		int32_t ncollapsed = 0;
+		if (npass > 0) {
+			/* rebuild adjacency for the live triangles */
+			for (i = 0; i <= nvtx; ++i) {
+				pAdjOrg[i] = 0;
+			}
+			for (i = 0; i < ntris; ++i) {
+				const uint32_t* pTri = pDstIdx + (i * 3);
+				if (hbinTriDead(pTri)) continue;
+				for (k = 0; k < 3; ++k) {
+					++pAdjOrg[pTri[k] + 1];
+				}
+			}
+			for (i = 0; i < nvtx; ++i) {
+				pAdjOrg[i + 1] += pAdjOrg[i];
+			}
+			for (i = 0; i < ntris; ++i) {
+				const uint32_t* pTri = pDstIdx + (i * 3);
+				if (hbinTriDead(pTri)) continue;
+				for (k = 0; k < 3; ++k) {
+					pAdj[pAdjOrg[pTri[k]]++] = i;
+				}
+			}
+			for (i = nvtx; i > 0; --i) {
+				pAdjOrg[i] = pAdjOrg[i - 1];
+			}
+			pAdjOrg[0] = 0;
+		}
+		/* one candidate per edge, in its cheaper allowed direction */
+		for (i = 0; i < ntris; ++i) {
+			const uint32_t* pTri = pDstIdx + (i * 3);
+			if (hbinTriDead(pTri)) continue;
+			for (k = 0; k < 3; ++k) {
+				uint32_t a = pTri[k];
+				uint32_t b = pTri[(k + 1) % 3];
+				int okAB, okBA;
+				float costAB = 0.0f;
+				float costBA = 0.0f;
+				float pa[3], pb[3];
+				if (a > b && hbinEdgeTriCount(pDstIdx, pAdjOrg, pAdj, a, b) != 1) continue;
+				okAB = hbinCollapseAllowed(pKind, pDstIdx, pAdjOrg, pAdj, a, b);
+				okBA = hbinCollapseAllowed(pKind, pDstIdx, pAdjOrg, pAdj, b, a);
+				if (!okAB && !okBA) continue;
+				hbinSimplifyPos(pa, pPos, a, org, scale);
+				hbinSimplifyPos(pb, pPos, b, org, scale);
+				if (okAB) costAB = hbinQuadricError(pQ + (a * 11), pb);
+				if (okBA) costBA = hbinQuadricError(pQ + (b * 11), pa);
+				if (okAB && (!okBA || costAB <= costBA)) {
+					pCandU[ncand] = (int32_t)a;
+					pCandV[ncand] = (int32_t)b;
+					pCandCost[ncand] = costAB;
+				} else {
+					pCandU[ncand] = (int32_t)b;
+					pCandV[ncand] = (int32_t)a;
+					pCandCost[ncand] = costBA;
+				}
+				pSorted[ncand] = ncand;
+				++ncand;
+			}
+		}
+		hbinSortByKeys(pSorted, pTmp, pCandCost, ncand, 0);
+		for (i = 0; i < ncand && ntri > targetTris; ++i) {
+			int32_t c = pSorted[i];
+			uint32_t u = (uint32_t)pCandU[c];
+			uint32_t v = (uint32_t)pCandV[c];
+			if (pCandCost[c] > maxErr2) break;
+			if (pStamp[u] == npass + 1 || pStamp[v] == npass + 1) continue;
+			if (hbinCollapseFlips(pDstIdx, pAdjOrg, pAdj, pPos, u, v)) continue;
+			for (j = pAdjOrg[u]; j < pAdjOrg[u + 1]; ++j) {
+				uint32_t* pTri = pDstIdx + (pAdj[j] * 3);
+				if (hbinTriDead(pTri)) continue;
+				for (k = 0; k < 3; ++k) {
+					pStamp[pTri[k]] = npass + 1;
+				}
+				if (pTri[0] == v || pTri[1] == v || pTri[2] == v) {
+					--ntri;
+				}
+				for (k = 0; k < 3; ++k) {
+					if (pTri[k] == u) pTri[k] = v;
+				}
+			}
+			for (k = 0; k < 11; ++k) {
+				pQ[(v * 11) + k] += pQ[(u * 11) + k];
+			}
+			if (pCandCost[c] > err2) err2 = pCandCost[c];
+			++ncollapsed;
+		}
+		if (ncollapsed == 0) break;
+	}
+	j = 0;
+	for (i = 0; i < ntris; ++i) {
+		const uint32_t* pTri = pDstIdx + (i * 3);
+		if (hbinTriDead(pTri)) continue;
+		for (k = 0; k < 3; ++k) {
+			pDstIdx[(j * 3) + k] = pTri[k];
+		}
+		if (pDstMtlIds) {
+			pDstMtlIds[j] = pSrcMtlIds ? pSrcMtlIds[i] : 0;
+		}
+		++j;
+	}
+	if (pError) *pError = hbinSqrtF(err2);
+	return j;
+}
+
+static uint32_t hbinZigZag(const int32_t x) {
+	return ((uint32_t)x << 1) ^ (uint32_t)(x >> 31);
+}
+
+static int32_t hbinUnZigZag(const uint32_t x) {
+	return (int32_t)(x >> 1) ^ -(int32_t)(x & 1);
+}
+
+HBIN_IFC(int32_t, EncodeIndexBound)(const int32_t nidx) {
+	if (nidx <= 0 || nidx > 0x7FFFFFFF / 5) return 0;
+	return nidx * 5;
+}
+
+HBIN_IFC(int32_t, EncodeIndices)(uint8_t* pDst, const int32_t dstSize, const uint32_t* pIdx, const int32_t nidx) {
+	int32_t i;
+	int32_t size = 0;
+	uint32_t prev = 0;
+	if (!pDst || !pIdx || nidx <= 0) return 0;
+	for (i = 0; i < nidx; ++i) {
+		uint32_t code = hbinZigZag((int32_t)(pIdx[i] - prev));
+		prev = pIdx[i];
+		do {
+			uint8_t b = (uint8_t)(code & 0x7F);
+			code >>= 7;
+			if (code) b |= 0x80;
+			if (size >= dstSize) return -1;
+			pDst[size++] = b;
+		} while (code);
+	}
+	return size;
+}
+
+HBIN_IFC(int32_t, DecodeIndices)(uint32_t* pIdx, const int32_t nidx, const uint8_t* pSrc, const int32_t srcSize) {
+	int32_t i;
+	int32_t pos = 0;
+	uint32_t prev = 0;
+	if (!pIdx || !pSrc || nidx <= 0) return 0;
+	for (i = 0; i < nidx; ++i) {
+		uint32_t code = 0;
+		int shift = 0;
+		uint8_t b;
+		do {
+			if (pos >= srcSize || shift > 28) return -1;
+			b = pSrc[pos++];
+			code |= (uint32_t)(b & 0x7F) << shift;
+			shift += 7;
+		} while (b & 0x80);
+		prev += (uint32_t)hbinUnZigZag(code);
+		pIdx[i] = prev;
+	}
+	return pos;
+}
+
+/*
+	vertex stream layout, per component c and byte plane b (LSB first):
+	zigzag(word[v][c] - word[v-1][c]) byte b of each vertex, in groups of 8 vertices:
+	mask byte (bit i set: byte i is non-zero), then the non-zero bytes
+*/
+HBIN_IFC(int32_t, EncodeVertexBound)(const int32_t nvtx, const int32_t ncomp) {
+	uint32_t nblk;
+	if (nvtx <= 0 || ncomp <= 0 || ncomp > 0x7FFFFFFF / 4) return 0;
+	/* one header byte per 8 values of each 4-byte lane */
+	nblk = (uint32_t)nvtx + ((uint32_t)nvtx / 8) + (((uint32_t)nvtx & 7) ? 1 : 0);
+	if (nblk > (uint32_t)(0x7FFFFFFF / (ncomp * 4))) return 0;
+	return (int32_t)(nblk * (uint32_t)(ncomp * 4));
+}
+
+HBIN_IFC(int32_t, EncodeVertices)(uint8_t* pDst, const int32_t dstSize, const void* pVtx, const int32_t nvtx, const int32_t ncomp) {
+	int32_t c, b, i, j;
+	int32_t size = 0;
+	const uint8_t* pSrc = (const uint8_t*)pVtx;
+	if (!pDst || !pVtx || nvtx <= 0 || ncomp <= 0) return 0;
+	for (c = 0; c < ncomp; ++c) {
+		for (b = 0; b < 4; ++b) {
+			uint32_t prev = 0;
+			for (i = 0; i < nvtx; i += 8) {
+				int32_t n = nvtx - i < 8 ? nvtx - i : 8;
+				int32_t maskPos = size;
+				uint8_t mask = 0;
+				if (size >= dstSize) return -1;
+				++size;
+				for (j = 0; j < n; ++j) {
+					uint32_t word;
+					uint32_t code;
+					uint8_t val;
+					hbinMemCpy(&word, pSrc + ((((i + j) * ncomp) + c) * 4), 4);
+					if (i + j > 0) {
+						hbinMemCpy(&prev, pSrc + ((((i + j - 1) * ncomp) + c) * 4), 4);
+					}
+					code = hbinZigZag((int32_t)(word - prev));
+					val = (uint8_t)(code >> (b * 8));
+					if (val) {
+						if (size >= dstSize) return -1;
+						pDst[size++] = val;
+						mask |= (uint8_t)(1 << j);
+					}
+				}
+				pDst[maskPos] = mask;
+			}
+		}
+	}
+	return size;
+}
+
+HBIN_IFC(int32_t, DecodeVertices)(void* pVtx, const int32_t nvtx, const int32_t ncomp, const uint8_t* pSrc, const int32_t srcSize) {
+	int32_t c, b, i, j;
+	int32_t pos = 0;
+	uint8_t* pDst = (uint8_t*)pVtx;
+	if (!pVtx || !pSrc || nvtx <= 0 || ncomp <= 0) return 0;
+	for (c = 0; c < ncomp; ++c) {
+		for (i = 0; i < nvtx; ++i) {
+			uint32_t zero = 0;
+			hbinMemCpy(pDst + (((i * ncomp) + c) * 4), &zero, 4);
+		}
+		for (b = 0; b < 4; ++b) {
+			for (i = 0; i < nvtx; i += 8) {
+				int32_t n = nvtx - i < 8 ? nvtx - i : 8;
+				uint8_t mask;
+				if (pos >= srcSize) return -1;
+				mask = pSrc[pos++];
+				for (j = 0; j < n; ++j) {
+					if (mask & (1 << j)) {
+						uint8_t* pWord = pDst + ((((i + j) * ncomp) + c) * 4);
+						uint32_t code;
+						if (pos >= srcSize) return -1;
+						hbinMemCpy(&code, pWord, 4);
+						code |= (uint32_t)pSrc[pos++] << (b * 8);
+						hbinMemCpy(pWord, &code, 4);
+					}
+				}
+			}
+		}
+		/* undo zigzag and delta */
+		{
+			uint32_t prev = 0;
+			for (i = 0; i < nvtx; ++i) {
+				uint8_t* pWord = pDst + (((i * ncomp) + c) * 4);
+				uint32_t code;
+				hbinMemCpy(&code, pWord, 4);
+				prev += (uint32_t)hbinUnZigZag(code);
+				hbinMemCpy(pWord, &prev, 4);
+			}
+		}
+	}
+	return pos;
+}
+
+/* uv orientation of a triangle: 0 for counter-clockwise uv, 1 for mirrored, -1 for degenerate uv */
+static int hbinTangentSide(const uint32_t* pTri, const HBIN_FLOAT2* pUV) {
+	float s1 = pUV[pTri[1]][0] - pUV[pTri[0]][0];
+	float t1 = pUV[pTri[1]][1] - pUV[pTri[0]][1];
+	float s2 = pUV[pTri[2]][0] - pUV[pTri[0]][0];
+	float t2 = pUV[pTri[2]][1] - pUV[pTri[0]][1];
+	float areaST = (s1 * t2) - (t1 * s2);
+	return areaST == 0.0f ? -1 : (areaST < 0.0f ? 1 : 0);
+}
+
+HBIN_IFC(void, ComputeTangents)(
+	float* pTangents,
+	const uint32_t* pTriIdx, const int32_t ntris,
+	const HBIN_FLOAT3* pPos, const HBIN_FLOAT3* pNrm, const HBIN_FLOAT2* pUV, const int32_t nvtx,
+	float* pWk)
+{
+	int32_t i, j, k;
+	if (!pTangents || !pTriIdx || ntris <= 0 || !pPos || !pNrm || !pUV || nvtx <= 0 || !pWk) return;
+	/* per vertex and uv orientation: tangent sum, bitangent sum */
+	for (i = 0; i < nvtx * 12; ++i) {
+		pWk[i] = 0.0f;
+	}
+	for (i = 0; i < ntris; ++i) {
+		const uint32_t* pTri = pTriIdx + (i * 3);
+		float d1[3], d2[3], os[3], ot[3];
+		float s1, t1, s2, t2, areaST, sign, len;
+		int side;
+		if (pTri[0] >= (uint32_t)nvtx || pTri[1] >= (uint32_t)nvtx || pTri[2] >= (uint32_t)nvtx) continue;
+		for (k = 0; k < 3; ++k) {
+			d1[k] = pPos[pTri[1]][k] - pPos[pTri[0]][k];
+			d2[k] = pPos[pTri[2]][k] - pPos[pTri[0]][k];
+		}
+		s1 = pUV[pTri[1]][0] - pUV[pTri[0]][0];
+		t1 = pUV[pTri[1]][1] - pUV[pTri[0]][1];
+		s2 = pUV[pTri[2]][0] - pUV[pTri[0]][0];
+		t2 = pUV[pTri[2]][1] - pUV[pTri[0]][1];
+		areaST = (s1 * t2) - (t1 * s2);
+		/* degenerate uv mapping contributes nothing, as in MikkTSpace */
+		if (areaST == 0.0f) continue;
+		sign = areaST > 0.0f ? 1.0f : -1.0f;
+		side = areaST < 0.0f ? 1 : 0;
+		for (k = 0; k < 3; ++k) {
+			os[k] = (t2 * d1[k]) - (t1 * d2[k]);
+			ot[k] = (s1 * d2[k]) - (s2 * d1[k]);
+		}
+		len = hbinSqrtF((os[0] * os[0]) + (os[1] * os[1]) + (os[2] * os[2]));
+		if (len <= 0.0f) continue;
+		for (k = 0; k < 3; ++k) {
+			os[k] *= sign / len;
+		}
+		len = hbinSqrtF((ot[0] * ot[0]) + (ot[1] * ot[1]) + (ot[2] * ot[2]));
+		if (len > 0.0f) {
+			for (k = 0; k < 3; ++k) {
+				ot[k] *= sign / len;
+			}
+		}
+		for (j = 0; j < 3; ++j) {
+			uint32_t vtxId = pTri[j];
+			float* pAcc = pWk + (((size_t)vtxId * 2 + side) * 6);
+			const float* n = pNrm[vtxId];
+			const float* p0 = pPos[vtxId];
+			const float* p1 = pPos[pTri[(j + 1) % 3]];
+			const float* p2 = pPos[pTri[(j + 2) % 3]];
+			float e1[3], e2[3], vos[3], vot[3];
+			float dn, l1, l2, c, angle;
+			/* corner edges and face tangents projected onto the vertex normal plane */
+			for (k = 0; k < 3; ++k) {
+				e1[k] = p1[k] - p0[k];
+				e2[k] = p2[k] - p0[k];
+			}
+			dn = (n[0] * e1[0]) + (n[1] * e1[1]) + (n[2] * e1[2]);
+			for (k = 0; k < 3; ++k) {
+				e1[k] -= n[k] * dn;
+			}
+			dn = (n[0] * e2[0]) + (n[1] * e2[1]) + (n[2] * e2[2]);
+			for (k = 0; k < 3; ++k) {
+				e2[k] -= n[k] * dn;
+			}
+			l1 = hbinSqrtF((e1[0] * e1[0]) + (e1[1] * e1[1]) + (e1[2] * e1[2]));
+			l2 = hbinSqrtF((e2[0] * e2[0]) + (e2[1] * e2[1]) + (e2[2] * e2[2]));
+			if (l1 <= 0.0f || l2 <= 0.0f) continue;
+			c = ((e1[0] * e2[0]) + (e1[1] * e2[1]) + (e1[2] * e2[2])) / (l1 * l2);
+			angle = hbinAcosF(c < -1.0f ? -1.0f : (c > 1.0f ? 1.0f : c));
+			dn = (n[0] * os[0]) + (n[1] * os[1]) + (n[2] * os[2]);
+			for (k = 0; k < 3; ++k) {
+				vos[k] = os[k] - (n[k] * dn);
+			}
+			dn = (n[0] * ot[0]) + (n[1] * ot[1]) + (n[2] * ot[2]);
+			for (k = 0; k < 3; ++k) {
+				vot[k] = ot[k] - (n[k] * dn);
+			}
+			len = hbinSqrtF((vos[0] * vos[0]) + (vos[1] * vos[1]) + (vos[2] * vos[2]));
+			if (len > 0.0f) {
+				for (k = 0; k < 3; ++k) {
+					pAcc[k] += (vos[k] / len) * angle;
+				}
+			}
+			len = hbinSqrtF((vot[0] * vot[0]) + (vot[1] * vot[1]) + (vot[2] * vot[2]));
+			if (len > 0.0f) {
+				for (k = 0; k < 3; ++k) {
+					pAcc[3 + k] += (vot[k] / len) * angle;
+				}
+			}
+		}
+	}
+	for (i = 0; i < ntris; ++i) {
+		const uint32_t* pTri = pTriIdx + (i * 3);
+		int side;
+		if (pTri[0] >= (uint32_t)nvtx || pTri[1] >= (uint32_t)nvtx || pTri[2] >= (uint32_t)nvtx) {
+			for (k = 0; k < 3 * 4; ++k) {
+				pTangents[((size_t)i * 3 * 4) + k] = 0.0f;
+			}
+			continue;
+		}
+		side = hbinTangentSide(pTri, pUV);
+		for (j = 0; j < 3; ++j) {
+			float* pTan = pTangents + (((size_t)i * 3 + j) * 4);
+			const float* pAcc = pWk + ((size_t)pTri[j] * 2 * 6);
+			/* degenerate uv takes whichever orientation the vertex has, counter-clockwise first */
+			if (side > 0 || (side < 0 && pAcc[0] == 0.0f && pAcc[1] == 0.0f && pAcc[2] == 0.0f)) {
+				pAcc += 6;
+			}
+			const float* n = pNrm[pTri[j]];
+			const float* b = pAcc + 3;
+			float len = hbinSqrtF((pAcc[0] * pAcc[0]) + (pAcc[1] * pAcc[1]) + (pAcc[2] * pAcc[2]));
+			float nxt[3];
+			for (k = 0; k < 3; ++k) {
+				pTan[k] = len > 0.0f ? pAcc[k] / len : 0.0f;
+			}
+			/* w: bitangent = cross(N, T) * w */
+			nxt[0] = (n[1] * pTan[2]) - (n[2] * pTan[1]);
+			nxt[1] = (n[2] * pTan[0]) - (n[0] * pTan[2]);
+			nxt[2] = (n[0] * pTan[1]) - (n[1] * pTan[0]);
+			pTan[3] = ((nxt[0] * b[0]) + (nxt[1] * b[1]) + (nxt[2] * b[2])) < 0.0f ? -1.0f : 1.0f;
+		}
+	}
+}
+
+typedef struct _BGEO_POLYTRIS_WK {
+	const uint8_t* pPts;
+	int hostOrder;
+	int32_t pntRecSize;
+	int32_t npts;
+	uint16_t* pIdx16;
+	uint32_t* pIdx32;
+	int32_t* pMtlIds;
+	const int32_t* pCornerIds; /* per polygon vertex output ids, NULL for point ids */
+	int32_t* pEarWk; /* ear clipping lists, int32_t[bgeoPolyTrianglesWorkSize()] */
+	int32_t triCount;
+} BGEO_POLYTRIS_WK;
+
+static void bgeoPolyTriOut(BGEO_POLYTRIS_WK* pWk, const HBIN_PRIM prim, const int32_t mtlId, const int32_t vtx0, const int32_t vtx1, const int32_t vtx2) {
+	size_t idxOrg = (size_t)pWk->triCount * 3;
+	int32_t pnt0, pnt1, pnt2;
+	if (pWk->pCornerIds) {
+		pnt0 = pWk->pCornerIds[vtx0];
+		pnt1 = pWk->pCornerIds[vtx1];
+		pnt2 = pWk->pCornerIds[vtx2];
+	} else {
+		pnt0 = bgeoPrimVertexPntId(prim, vtx0);
+		pnt1 = bgeoPrimVertexPntId(prim, vtx1);
+		pnt2 = bgeoPrimVertexPntId(prim, vtx2);
+	}
+	if (pWk->pIdx16) {
+		pWk->pIdx16[idxOrg] = (uint16_t)pnt0;
+		pWk->pIdx16[idxOrg + 1] = (uint16_t)pnt1;
+		pWk->pIdx16[idxOrg + 2] = (uint16_t)pnt2;
+	}
+	if (pWk->pIdx32) {
+		pWk->pIdx32[idxOrg] = (uint32_t)pnt0;
+		pWk->pIdx32[idxOrg + 1] = (uint32_t)pnt1;
+		pWk->pIdx32[idxOrg + 2] = (uint32_t)pnt2;
+	}
+	if (pWk->pMtlIds) {
+		pWk->pMtlIds[pWk->triCount] = mtlId;
+	}
+	++pWk->triCount;
+}
+
+static void bgeoPolyTriPos(const BGEO_POLYTRIS_WK* pWk, const HBIN_PRIM prim, const int32_t vtx, float* pPos) {
+	int32_t pntId = bgeoPrimVertexPntId(prim, vtx);
+	int32_t i;
+	if ((uint32_t)pntId < (uint32_t)pWk->npts) {
+		const uint8_t* pRec = pWk->pPts + ((size_t)pntId * (size_t)pWk->pntRecSize);
+		for (i = 0; i < 3; ++i) {
+			pPos[i] = hbinRecF32(pRec + (i * 4), pWk->hostOrder);
+		}
+	} else {
+		pPos[0] = 0.0f;
+		pPos[1] = 0.0f;
+		pPos[2] = 0.0f;
+	}
+}
+
+static float bgeoCorner2D(const float* pX, const float* pY, const int32_t i0, const int32_t i1, const int32_t i2) {
+	return ((pX[i1] - pX[i0]) * (pY[i2] - pY[i1])) - ((pY[i1] - pY[i0]) * (pX[i2] - pX[i1]));
+}
+
+static int bgeoPolyTrisCB(const HBIN_PRIM prim, void* pUserData) {
+	int32_t i, j;
+	int32_t nvtx;
+	int32_t mtlId;
+	BGEO_POLYTRIS_WK* pWk = (BGEO_POLYTRIS_WK*)pUserData;
+	if (!pWk) return 0;
+	if (!bgeoPrimIsPoly(prim)) return 1;
+	nvtx = bgeoPrimNumVertices(prim);
+	if (nvtx < 3) return 1;
+	mtlId = bgeoPrimMaterialId(prim);
+	if (nvtx == 3) {
+		bgeoPolyTriOut(pWk, prim, mtlId, 0, 1, 2);
+	} else if (!pWk->pPts) {
+		for (i = 1; i < nvtx - 1; ++i) {
+			bgeoPolyTriOut(pWk, prim, mtlId, 0, i, i + 1);
+		}
+	} else {
+		int32_t* lst;
+		float* px;
+		float* py;
+		float pos[3];
+		float p0[3];
+		float p1[3];
+		float nrm[3];
+		float ax, ay, az;
+		float area = 0.0f;
+		float dir;
+		int convex = 1;
+		int32_t n;
+		if (!pWk->pEarWk) return 0;
+		lst = pWk->pEarWk;
+		px = (float*)(lst + nvtx);
+		py = px + nvtx;
+		/* Newell normal, project onto the plane of its dominant axis */
+		nrm[0] = 0.0f;
+		nrm[1] = 0.0f;
+		nrm[2] = 0.0f;
+		bgeoPolyTriPos(pWk, prim, nvtx - 1, p0);
+		for (i = 0; i < nvtx; ++i) {
+			bgeoPolyTriPos(pWk, prim, i, p1);
+			nrm[0] += (p0[1] - p1[1]) * (p0[2] + p1[2]);
+			nrm[1] += (p0[2] - p1[2]) * (p0[0] + p1[0]);
+			nrm[2] += (p0[0] - p1[0]) * (p0[1] + p1[1]);
+			for (j = 0; j < 3; ++j) {
+				p0[j] = p1[j];
+			}
+		}
+		ax = nrm[0] < 0.0f ? -nrm[0] : nrm[0];
+		ay = nrm[1] < 0.0f ? -nrm[1] : nrm[1];
+		az = nrm[2] < 0.0f ? -nrm[2] : nrm[2];
+		for (i = 0; i < nvtx; ++i) {
+			bgeoPolyTriPos(pWk, prim, i, pos);
+			if (ax >= ay && ax >= az) {
+				px[i] = pos[1];
+				py[i] = pos[2];
+			} else if (ay >= az) {
+				px[i] = pos[2];
+				py[i] = pos[0];
+			} else {
+				px[i] = pos[0];
+				py[i] = pos[1];
+			}
+		}
+		for (i = 0; i < nvtx; ++i) {
+			int32_t inext = (i + 1) % nvtx;
+			area += (px[i] * py[inext]) - (px[inext] * py[i]);
+		}
+		dir = area < 0.0f ? -1.0f : 1.0f;
+		for (i = 0; i < nvtx; ++i) {
+			if (bgeoCorner2D(px, py, (i + nvtx - 1) % nvtx, i, (i + 1) % nvtx) * dir < 0.0f) {
+				convex = 0;
+				break;
+			}
+		}
+		if (convex) {
+			for (i = 1; i < nvtx - 1; ++i) {
+				bgeoPolyTriOut(pWk, prim, mtlId, 0, i, i + 1);
+			}
+		} else {
+			n = nvtx;
+			for (i = 0; i < n; ++i) {
+				lst[i] = i;
+			}
+			while (n > 3) {
+				int32_t ear = -1;
+				for (i = 0; i < n && ear < 0; ++i) {
+					int32_t v0 = lst[(i + n - 1) % n];
+					int32_t v1 = lst[i];
+					int32_t v2 = lst[(i + 1) % n];
+					if (bgeoCorner2D(px, py, v0, v1, v2) * dir > 0.0f) {
+						int inside = 0;
+						for (j = 0; j < n; ++j) {
+							int32_t vt = lst[j];
+							if (vt == v0 || vt == v1 || vt == v2) continue;
+							if ((px[vt] == px[v0] && py[vt] == py[v0]) || (px[vt] == px[v1] && py[vt] == py[v1]) || (px[vt] == px[v2] && py[vt] == py[v2])) continue;
+							if (bgeoCorner2D(px, py, v0, v1, vt) * dir >= 0.0f && bgeoCorner2D(px, py, v1, v2, vt) * dir >= 0.0f && bgeoCorner2D(px, py, v2, v0, vt) * dir >= 0.0f) {
+								inside = 1;
+								break;
+							}
+						}
+						if (!inside) {
+							ear = i;
+						}
+					}
+				}
+				if (ear < 0) {
+					/* degenerate outline, clip the first corner */
+					ear = 0;
+				}
+				bgeoPolyTriOut(pWk, prim, mtlId, lst[(ear + n - 1) % n], lst[ear], lst[(ear + 1) % n]);
+				for (i = ear; i < n - 1; ++i) {
+					lst[i] = lst[i + 1];
+				}
+				--n;
+			}
+			bgeoPolyTriOut(pWk, prim, mtlId, lst[0], lst[1], lst[2]);
+		}
+	}
+	return 1;
+}
+
+static int bgeoCountPolyTrisCB(const HBIN_PRIM prim, void* pUserData) {
+	int32_t* pCnt = (int32_t*)pUserData;
+	if (!pCnt) return 0;
+	if (bgeoPrimIsPoly(prim)) {
+		int32_t nvtx = bgeoPrimNumVertices(prim);
+		if (nvtx >= 3) {
+			/* keep the index count (3 per triangle) within int32_t */
+			if (nvtx - 2 > 0x7FFFFFFF / 3 - *pCnt) {
+				*pCnt = -1;
+				return 0;
+			}
+			*pCnt += nvtx - 2;
+		}
+	}
+	return 1;
+}
+
+static int bgeoMaxPolyVtxCB(const HBIN_PRIM prim, void* pUserData) {
+	int32_t* pMax = (int32_t*)pUserData;
+	if (!pMax) return 0;
+	if (bgeoPrimIsPoly(prim)) {
+		int32_t nvtx = bgeoPrimNumVertices(prim);
+		if (nvtx > 3 && nvtx > *pMax) {
+			*pMax = nvtx;
+		}
+	}
+	return 1;
+}
+
+HBIN_BGEO_IFC(int32_t, PolyTrianglesWorkSize)(const HBIN_BGEO bgeo) {
+	int32_t maxVtx = 0;
+	int32_t nprim = HBIN_BGEO_FN(NumPrims)(bgeo);
+	if (nprim > 0) {
+		HBIN_BGEO_FN(ForEachPrim)(bgeo, bgeoMaxPolyVtxCB, &maxVtx);
+	}
+	return maxVtx * 3;
+}
+
+HBIN_BGEO_IFC(int32_t, CountPolyTriangles)(const HBIN_BGEO bgeo) {
+	return HBIN_BGEO_FN(CountPolyTrianglesInGroup)(bgeo, NULL);
+}
+
+HBIN_BGEO_IFC(int32_t, CountPolyTrianglesInGroup)(const HBIN_BGEO bgeo, const uint32_t* pPrimBits) {
+	int32_t ntri = 0;
+	int32_t nprim = HBIN_BGEO_FN(NumPrims)(bgeo);
+	if (nprim > 0) {
+		HBIN_BGEO_FN(ForEachPrimInGroup)(bgeo, pPrimBits, bgeoCountPolyTrisCB, &ntri);
+	}
+	return ntri;
+}
+
+HBIN_BGEO_IFC(int32_t, GetPolyTriangles)(
+	const HBIN_BGEO bgeo, uint16_t* pIdx16, uint32_t* pIdx32, int32_t* pMtlIds, int32_t* pWk)
+{
+	return HBIN_BGEO_FN(GetPolyTrianglesInGroup)(bgeo, NULL, pIdx16, pIdx32, pMtlIds, pWk);
+}
+
+HBIN_BGEO_IFC(int32_t, GetPolyTrianglesInGroup)(
+	const HBIN_BGEO bgeo, const uint32_t* pPrimBits, uint16_t* pIdx16, uint32_t* pIdx32, int32_t* pMtlIds, int32_t* pWk)
+{
+	int32_t ntris = 0;
+	int32_t nprim = HBIN_BGEO_FN(NumPrims)(bgeo);
+	if (pIdx16 && HBIN_BGEO_FN(TriangleIndexSize)(bgeo) != 2) return -1;
+	if (!pWk && HBIN_BGEO_FN(PolyTrianglesWorkSize)(bgeo) > 0) return -1;
+	if (nprim > 0) {
+		BGEO_POLYTRIS_WK wk;
+		wk.pPts = NULL;
+		wk.pntRecSize = bgeoCalcPntRecSize(bgeo, &wk.pPts);
+		wk.hostOrder = bgeoHostOrder(bgeo);
+		wk.npts = HBIN_BGEO_FN(NumPoints)(bgeo);
+		if (wk.pntRecSize <= 0) {
+			wk.pPts = NULL;
 		}
+		wk.pIdx16 = pIdx16;
+		wk.pIdx32 = pIdx32;
+		wk.pMtlIds = pMtlIds;
+		wk.pCornerIds = NULL;
+		wk.pEarWk = pWk;
+		wk.triCount = 0;
+		HBIN_BGEO_FN(ForEachPrimInGroup)(bgeo, pPrimBits, bgeoPolyTrisCB, &wk);
+		ntris = wk.triCount;
 	}
-	return capt;
+	return ntris;
 }
 
-HBIN_BGEO_IFC(int32_t, SkeletonNames)(const HBIN_BGEO bgeo, const char* pAttrName, HBIN_STRING* pNames) {
+static int bgeoCountPolyVtxCB(const HBIN_PRIM prim, void* pUserData) {
+	int32_t* pCnt = (int32_t*)pUserData;
+	if (!pCnt) return 0;
+	if (bgeoPrimIsPoly(prim)) {
+		int32_t nvtx = bgeoPrimNumVertices(prim);
+		if (nvtx > 0x7FFFFFFF - *pCnt) {
+			*pCnt = -1;
+			return 0;
+		}
+		*pCnt += nvtx;
+	}
+	return 1;
+}
+
+HBIN_BGEO_IFC(int32_t, CountPolyVertices)(const HBIN_BGEO bgeo) {
+	return HBIN_BGEO_FN(CountPolyVerticesInGroup)(bgeo, NULL);
+}
+
+HBIN_BGEO_IFC(int32_t, CountPolyVerticesInGroup)(const HBIN_BGEO bgeo, const uint32_t* pPrimBits) {
+	int32_t nvtx = 0;
+	int32_t nprim = HBIN_BGEO_FN(NumPrims)(bgeo);
+	if (nprim > 0) {
+		HBIN_BGEO_FN(ForEachPrimInGroup)(bgeo, pPrimBits, bgeoCountPolyVtxCB, &nvtx);
+	}
+	return nvtx;
+}
+
+/* big-endian point indices at the given stride; packed indices (no vertex attributes) get their own loops so they vectorize */
+static void bgeoDecodeIdx(int32_t* pDst, const uint8_t* pSrc, const int32_t n, const int32_t idxSize, const int32_t stride) {
+	int32_t i;
+	if (idxSize == 2) {
+		if (stride == 2) {
+			for (i = 0; i < n; ++i) {
+				pDst[i] = (int32_t)(((uint32_t)pSrc[i * 2] << 8) | pSrc[(i * 2) + 1]);
+			}
+		} else {
+			for (i = 0; i < n; ++i) {
+				const uint8_t* p = pSrc + (i * stride);
+				pDst[i] = (int32_t)(((uint32_t)p[0] << 8) | p[1]);
+			}
+		}
+	} else if (idxSize == 4) {
+		if (stride == 4) {
+			for (i = 0; i < n; ++i) {
+				const uint8_t* p = pSrc + (i * 4);
+				pDst[i] = (int32_t)(((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3]);
+			}
+		} else {
+			for (i = 0; i < n; ++i) {
+				pDst[i] = hbinI32(pSrc + (i * stride));
+			}
+		}
+	}
+}
+
+typedef struct _BGEO_CSR_WK {
+	int32_t* pPolOrg;
+	int32_t* pPolPnts;
+	int32_t* pMtlIds;
+	int32_t npol;
+	int32_t nvtx;
+} BGEO_CSR_WK;
+
+static int bgeoCSRCB(const HBIN_PRIM prim, void* pUserData) {
+	BGEO_CSR_WK* pWk = (BGEO_CSR_WK*)pUserData;
+	const HBIN_PRIM_S* pPrim = (const HBIN_PRIM_S*)prim;
+	if (!pWk) return 0;
+	if (!bgeoPrimIsPoly(prim)) return 1;
+	if (pWk->pPolOrg) {
+		pWk->pPolOrg[pWk->npol] = pWk->nvtx;
+	}
+	if (pWk->pPolPnts && pPrim->nvtx > 0) {
+		bgeoDecodeIdx(pWk->pPolPnts + pWk->nvtx, pPrim->pIdx, pPrim->nvtx, pPrim->idxSize, pPrim->idxSize + pPrim->vtxAttrsRecSize);
+	}
+	if (pWk->pMtlIds) {
+		pWk->pMtlIds[pWk->npol] = pPrim->mtlId;
+	}
+	pWk->nvtx += pPrim->nvtx;
+	++pWk->npol;
+	return 1;
+}
+
+HBIN_BGEO_IFC(int32_t, GetPolygonsCSR)(const HBIN_BGEO bgeo, int32_t* pPolOrg, int32_t* pPolPnts, int32_t* pMtlIds) {
+	return HBIN_BGEO_FN(GetPolygonsCSRInGroup)(bgeo, NULL, pPolOrg, pPolPnts, pMtlIds);
+}
+
+HBIN_BGEO_IFC(int32_t, GetPolygonsCSRInGroup)(const HBIN_BGEO bgeo, const uint32_t* pPrimBits, int32_t* pPolOrg, int32_t* pPolPnts, int32_t* pMtlIds) {
+	BGEO_CSR_WK wk;
+	wk.pPolOrg = pPolOrg;
+	wk.pPolPnts = pPolPnts;
+	wk.pMtlIds = pMtlIds;
+	wk.npol = 0;
+	wk.nvtx = 0;
+	if (HBIN_BGEO_FN(NumPrims)(bgeo) > 0) {
+		HBIN_BGEO_FN(ForEachPrimInGroup)(bgeo, pPrimBits, bgeoCSRCB, &wk);
+	}
+	if (pPolOrg) {
+		pPolOrg[wk.npol] = wk.nvtx;
+	}
+	return wk.npol;
+}
+
+HBIN_IFC(int32_t, HalfEdgeNext)(const int32_t* pPolOrg, const int32_t* pHEPol, const int32_t he) {
+	int32_t pol;
+	if (!pPolOrg || !pHEPol || he < 0) return -1;
+	pol = pHEPol[he];
+	return he + 1 < pPolOrg[pol + 1] ? he + 1 : pPolOrg[pol];
+}
+
+HBIN_IFC(int32_t, HalfEdgePrev)(const int32_t* pPolOrg, const int32_t* pHEPol, const int32_t he) {
+	int32_t pol;
+	if (!pPolOrg || !pHEPol || he < 0) return -1;
+	pol = pHEPol[he];
+	return he > pPolOrg[pol] ? he - 1 : pPolOrg[pol + 1] - 1;
+}
+
+static int32_t hbinHalfEdgeEnd(const int32_t* pPolOrg, const int32_t* pPolPnts, const int32_t* pHEPol, const int32_t he) {
+	return pPolPnts[HBIN_FN(HalfEdgeNext)(pPolOrg, pHEPol, he)];
+}
+
+/* undirected edge key: lo/hi point */
+static int32_t hbinHalfEdgeKey(const int32_t* pPolOrg, const int32_t* pPolPnts, const int32_t* pHEPol, const int32_t he, const int hi) {
+	int32_t a = pPolPnts[he];
+	int32_t b = hbinHalfEdgeEnd(pPolOrg, pPolPnts, pHEPol, he);
+	if (hi) {
+		return a > b ? a : b;
+	}
+	return a < b ? a : b;
+}
+
+/* one stable counting sort pass over point ids, pSrc NULL: identity order */
+static void hbinHalfEdgeSort(
+	int32_t* pDst, const int32_t* pSrc, const int32_t n,
+	const int32_t* pPolOrg, const int32_t* pPolPnts, const int32_t* pHEPol,
+	const int32_t npnt, const int hi, int32_t* pCount)
+{
+	int32_t i;
+	int32_t org = 0;
+	for (i = 0; i < npnt; ++i) {
+		pCount[i] = 0;
+	}
+	for (i = 0; i < n; ++i) {
+		++pCount[hbinHalfEdgeKey(pPolOrg, pPolPnts, pHEPol, pSrc ? pSrc[i] : i, hi)];
+	}
+	for (i = 0; i < npnt; ++i) {
+		int32_t cnt = pCount[i];
+		pCount[i] = org;
+		org += cnt;
+	}
+	for (i = 0; i < n; ++i) {
+		int32_t he = pSrc ? pSrc[i] : i;
+		pDst[pCount[hbinHalfEdgeKey(pPolOrg, pPolPnts, pHEPol, he, hi)]++] = he;
+	}
+}
+
+/* the lowest half-edge of a twin cycle stands for the undirected edge */
+static int hbinHalfEdgeIsRep(const int32_t* pTwin, const int32_t he) {
+	int32_t t = pTwin[he];
+	if (t < 0) return 1;
+	if (t == he) return 0;
+	while (t != he) {
+		if (t < he) return 0;
+		t = pTwin[t];
+	}
+	return 1;
+}
+
+HBIN_IFC(int32_t, HalfEdgesWorkSize)(const int32_t ncorners, const int32_t npnt) {
+	return (ncorners * 2) + npnt + 1;
+}
+
+HBIN_IFC(int32_t, BuildHalfEdges)(
+	int32_t* pTwin, int32_t* pHEPol,
+	const int32_t* pPolOrg, const int32_t* pPolPnts, const int32_t npol, const int32_t npnt,
+	int32_t* pWk)
+{
+	int32_t i, j, k;
+	int32_t ncorners;
+	int32_t* pOrder;
+	int32_t* pTmp;
+	int32_t nedges = 0;
+	if (!pTwin || !pHEPol || !pPolOrg || !pPolPnts || npol <= 0 || npnt <= 0 || !pWk) return 0;
+	ncorners = pPolOrg[npol];
+	for (i = 0; i < npol; ++i) {
+		for (j = pPolOrg[i]; j < pPolOrg[i + 1]; ++j) {
+			if (pPolPnts[j] < 0 || pPolPnts[j] >= npnt) return -1;
+			pHEPol[j] = i;
+		}
+	}
+	pOrder = pWk + npnt + 1;
+	pTmp = pOrder + ncorners;
+	/* radix order by (lo, hi): equal keys end up adjacent, each run in ascending half-edge order */
+	hbinHalfEdgeSort(pTmp, NULL, ncorners, pPolOrg, pPolPnts, pHEPol, npnt, 1, pWk);
+	hbinHalfEdgeSort(pOrder, pTmp, ncorners, pPolOrg, pPolPnts, pHEPol, npnt, 0, pWk);
+	i = 0;
+	while (i < ncorners) {
+		int32_t lo = hbinHalfEdgeKey(pPolOrg, pPolPnts, pHEPol, pOrder[i], 0);
+		int32_t hi = hbinHalfEdgeKey(pPolOrg, pPolPnts, pHEPol, pOrder[i], 1);
+		j = i + 1;
+		while (j < ncorners && hbinHalfEdgeKey(pPolOrg, pPolPnts, pHEPol, pOrder[j], 0) == lo && hbinHalfEdgeKey(pPolOrg, pPolPnts, pHEPol, pOrder[j], 1) == hi) {
+			++j;
+		}
+		if (lo == hi) {
+			for (k = i; k < j; ++k) {
+				pTwin[pOrder[k]] = pOrder[k];
+			}
+		} else {
+			if (j - i == 1) {
+				pTwin[pOrder[i]] = -1;
+			} else {
+				for (k = i; k < j; ++k) {
+					pTwin[pOrder[k]] = pOrder[k + 1 < j ? k + 1 : i];
+				}
+			}
+			++nedges;
+		}
+		i = j;
+	}
+	return nedges;
+}
+
+HBIN_IFC(int32_t, PointNeighbors)(
+	int32_t* pNbrOrg, int32_t* pNbrs,
+	const int32_t* pPolOrg, const int32_t* pPolPnts, const int32_t* pTwin, const int32_t* pHEPol,
+	const int32_t npol, const int32_t npnt)
+{
+	int32_t i, he;
+	int32_t ncorners;
+	if (!pNbrOrg || !pPolOrg || !pPolPnts || !pTwin || !pHEPol || npol <= 0 || npnt <= 0) return 0;
+	ncorners = pPolOrg[npol];
+	for (i = 0; i <= npnt; ++i) {
+		pNbrOrg[i] = 0;
+	}
+	for (he = 0; he < ncorners; ++he) {
+		if (hbinHalfEdgeIsRep(pTwin, he)) {
+			++pNbrOrg[pPolPnts[he] + 1];
+			++pNbrOrg[hbinHalfEdgeEnd(pPolOrg, pPolPnts, pHEPol, he) + 1];
+		}
+	}
+	for (i = 0; i < npnt; ++i) {
+		pNbrOrg[i + 1] += pNbrOrg[i];
+	}
+	if (pNbrs) {
+		/* pNbrOrg[p] is the fill cursor of p, then shifted back into place */
+		for (he = 0; he < ncorners; ++he) {
+			if (hbinHalfEdgeIsRep(pTwin, he)) {
+				int32_t a = pPolPnts[he];
+				int32_t b = hbinHalfEdgeEnd(pPolOrg, pPolPnts, pHEPol, he);
+				pNbrs[pNbrOrg[a]++] = b;
+				pNbrs[pNbrOrg[b]++] = a;
+			}
+		}
+		for (i = npnt; i > 0; --i) {
+			pNbrOrg[i] = pNbrOrg[i - 1];
+		}
+		pNbrOrg[0] = 0;
+	}
+	return pNbrOrg[npnt];
+}
+
+HBIN_IFC(int32_t, BoundaryLoops)(
+	int32_t* pLoopOrg, int32_t* pLoopHEs,
+	const int32_t* pPolOrg, const int32_t* pPolPnts, const int32_t* pTwin, const int32_t* pHEPol,
+	const int32_t npol, const int32_t npnt,
+	int32_t* pWk)
+{
+	int32_t i, k, he;
+	int32_t ncorners;
+	int32_t* pStart;
+	int32_t* pList;
+	int32_t nloops = 0;
 	int32_t n = 0;
-	const uint8_t* pAttrs = bgeoDetailAttrsTop(bgeo);
-	if (pAttrs && pAttrName) {
-		int32_t i;
-		const uint8_t* pTop = (const uint8_t*)bgeo;
-		uint32_t attrsOffs = (uint32_t)(pAttrs - pTop);
-		int32_t nattr = HBIN_BGEO_FN(NumDetailAttrs)(bgeo);
-		int32_t valOffs = 0;
-		int32_t attrType = 0;
-		int32_t attrSize = 0;
-		const uint8_t* pDescr = NULL;
-		int32_t attrId = bgeoFindAttrInfo(bgeo, nattr, attrsOffs, 0, pAttrName, NULL, &valOffs, &attrType, &attrSize, &pDescr);
-		if (attrId >= 0 && attrType == 4 && pDescr) {
-			n = hbinI32(pDescr);
-			if (n > 0 && pNames) {
-				pDescr += 4;
-				for (i = 0; i < n; ++i) {
-					pNames[i].len = hbinU16(pDescr);
-					pDescr += 2;
-					if (pNames[i].len == 0xFFFF) {
-						pNames[i].len = hbinI32(pDescr);
-						pDescr += 4;
+	if (!pPolOrg || !pPolPnts || !pTwin || !pHEPol || npol <= 0 || npnt <= 0 || !pWk) return 0;
+	ncorners = pPolOrg[npol];
+	/* outgoing boundary half-edges of each point */
+	pStart = pWk;
+	pList = pWk + npnt + 1;
+	for (i = 0; i <= npnt; ++i) {
+		pStart[i] = 0;
+	}
+	for (he = 0; he < ncorners; ++he) {
+		if (pTwin[he] < 0) {
+			++pStart[pPolPnts[he] + 1];
+		}
+	}
+	for (i = 0; i < npnt; ++i) {
+		pStart[i + 1] += pStart[i];
+	}
+	for (he = 0; he < ncorners; ++he) {
+		if (pTwin[he] < 0) {
+			pList[pStart[pPolPnts[he]]++] = he;
+		}
+	}
+	for (i = npnt; i > 0; --i) {
+		pStart[i] = pStart[i - 1];
+	}
+	pStart[0] = 0;
+	for (i = 0; i < npnt; ++i) {
+		for (k = pStart[i]; k < pStart[i + 1]; ++k) {
+			he = pList[k];
+			if (he < 0) continue;
+			pList[k] = -1;
+			if (pLoopOrg) {
+				pLoopOrg[nloops] = n;
+			}
+			while (he >= 0) {
+				int32_t pnt = hbinHalfEdgeEnd(pPolOrg, pPolPnts, pHEPol, he);
+				int32_t j;
+				if (pLoopHEs) {
+					pLoopHEs[n] = he;
+				}
+				++n;
+				he = -1;
+				for (j = pStart[pnt]; j < pStart[pnt + 1]; ++j) {
+					if (pList[j] >= 0) {
+						he = pList[j];
+						pList[j] = -1;
+						break;
 					}
-					pNames[i].pChars = (const char*)pDescr;
-					pDescr += pNames[i].len;
 				}
 			}
+			++nloops;
 		}
 	}
-	return n;
+	if (pLoopOrg) {
+		pLoopOrg[nloops] = n;
+	}
+	return nloops;
 }
 
-HBIN_BGEO_IFC(int32_t, SkeletonParents)(const HBIN_BGEO bgeo, const char* pAttrName, int32_t* pParents) {
-	int32_t n = 0;
-	const uint8_t* pAttrs = bgeoDetailAttrsTop(bgeo);
-	if (pAttrs && pAttrName) {
-		int32_t i;
-		const uint8_t* pTop = (const uint8_t*)bgeo;
-		uint32_t attrsOffs = (uint32_t)(pAttrs - pTop);
-		int32_t nattr = HBIN_BGEO_FN(NumDetailAttrs)(bgeo);
-		int32_t valOffs = 0;
-		int32_t attrType = 0;
-		int32_t attrSize = 0;
-		const uint8_t* pDescr = NULL;
-		int32_t attrId = bgeoFindAttrInfo(bgeo, nattr, attrsOffs, 0, pAttrName, NULL, &valOffs, &attrType, &attrSize, &pDescr);
-		if (attrId >= 0 && attrType == 1 && pDescr) {
-			n = attrSize;
-			if (n > 0 && pParents) {
-				const uint8_t* pVals = NULL;
-				bgeoCalcItemRecSize(bgeo, nattr, attrsOffs, 0, &pVals);
-				if (pVals) {
-					for (i = 0; i < n; ++i) {
-						pParents[i] = hbinI32(pVals + valOffs + (i * 4));
+HBIN_IFC(int32_t, ConnectedComponents)(
+	int32_t* pPolComp,
+	const int32_t* pPolOrg, const int32_t* pTwin, const int32_t* pHEPol, const int32_t npol,
+	int32_t* pWk)
+{
+	int32_t i, he;
+	int32_t ncomp = 0;
+	if (!pPolComp || !pPolOrg || !pTwin || !pHEPol || npol <= 0 || !pWk) return 0;
+	for (i = 0; i < npol; ++i) {
+		pPolComp[i] = -1;
+	}
+	for (i = 0; i < npol; ++i) {
+		int32_t nstk = 0;
+		if (pPolComp[i] >= 0) continue;
+		pPolComp[i] = ncomp;
+		pWk[nstk++] = i;
+		while (nstk > 0) {
+			int32_t pol = pWk[--nstk];
+			for (he = pPolOrg[pol]; he < pPolOrg[pol + 1]; ++he) {
+				int32_t t = pTwin[he];
+				if (t < 0) continue;
+				while (t != he) {
+					int32_t nbr = pHEPol[t];
+					if (pPolComp[nbr] < 0) {
+						pPolComp[nbr] = ncomp;
+						pWk[nstk++] = nbr;
 					}
+					t = pTwin[t];
 				}
 			}
 		}
+		++ncomp;
 	}
-	return n;
+	return ncomp;
 }
 
-HBIN_BGEO_IFC(int32_t, SkeletonTransforms)(const HBIN_BGEO bgeo, const char* pAttrName, float* pXforms) {
-	int32_t n = 0;
-	const uint8_t* pAttrs = bgeoDetailAttrsTop(bgeo);
-	if (pAttrs && pAttrName) {
+static int32_t hbinCleanTblSize(const int32_t n) {
+	int32_t size = 16;
+	while (size < n * 2) {
+		size <<= 1;
+	}
+	return size;
+}
+
+static uint32_t hbinHash3(const uint32_t a, const uint32_t b, const uint32_t c) {
+	return (a * 73856093U) ^ (b * 19349663U) ^ (c * 83492791U);
+}
+
+/* grid cell of a coordinate: floor(x / tol), clamped; exact float bits (-0 as +0) when tol <= 0 */
+static int32_t hbinWeldCell(const float x, const float invTol) {
+	if (invTol > 0.0f) {
+		double d = (double)x * (double)invTol;
 		int32_t i;
-		const uint8_t* pTop = (const uint8_t*)bgeo;
-		uint32_t attrsOffs = (uint32_t)(pAttrs - pTop);
-		int32_t nattr = HBIN_BGEO_FN(NumDetailAttrs)(bgeo);
-		int32_t valOffs = 0;
-		int32_t attrType = 0;
-		int32_t attrSize = 0;
-		const uint8_t* pDescr = NULL;
-		int32_t attrId = bgeoFindAttrInfo(bgeo, nattr, attrsOffs, 0, pAttrName, NULL, &valOffs, &attrType, &attrSize, &pDescr);
-		if (attrId >= 0 && attrType == 0 && pDescr) {
-			n = attrSize;
-			if (n > 0 && pXforms) {
-				const uint8_t* pVals = NULL;
-				bgeoCalcItemRecSize(bgeo, nattr, attrsOffs, 0, &pVals);
-				if (pVals) {
-					for (i = 0; i < n; ++i) {
-						pXforms[i] = hbinF32(pVals + valOffs + (i * 4));
+		if (d < -1.0e9) d = -1.0e9;
+		if (d > 1.0e9) d = 1.0e9;
+		i = (int32_t)d;
+		if (d < (double)i) --i;
+		return i;
+	} else {
+		float f = x + 0.0f;
+		int32_t i;
+		hbinMemCpy(&i, &f, sizeof(int32_t));
+		return i;
+	}
+}
+
+HBIN_IFC(int32_t, WeldPositionsWorkSize)(const int32_t nvtx) {
+	return hbinCleanTblSize(nvtx) + nvtx;
+}
+
+HBIN_IFC(int32_t, WeldPositions)(
+	int32_t* pRemap,
+	const HBIN_FLOAT3* pPos, const int32_t nvtx, const float tol,
+	const void* pAttrs, const int32_t attrStride, const int32_t attrSize,
+	int32_t* pWk)
+{
+	int32_t i, k;
+	int32_t tblSize;
+	uint32_t tblMask;
+	int32_t* pHeads;
+	int32_t* pNext;
+	/* cells slightly larger than tol: matches at exactly tol stay within the adjacent cells despite rounding */
+	float invTol = tol > 0.0f ? 1.0f / (tol * 1.001f) : 0.0f;
+	float tolSq = tol > 0.0f ? tol * tol : 0.0f;
+	int32_t range = tol > 0.0f ? 1 : 0;
+	const uint8_t* pAttrTop = (const uint8_t*)pAttrs;
+	int32_t nmerged = 0;
+	if (!pRemap || !pPos || nvtx <= 0 || !pWk) return 0;
+	tblSize = hbinCleanTblSize(nvtx);
+	tblMask = (uint32_t)(tblSize - 1);
+	pHeads = pWk;
+	pNext = pWk + tblSize;
+	for (i = 0; i < tblSize; ++i) {
+		pHeads[i] = -1;
+	}
+	for (i = 0; i < nvtx; ++i) {
+		int32_t cell[3];
+		int32_t dx, dy, dz;
+		int32_t rep = -1;
+		uint32_t slot;
+		for (k = 0; k < 3; ++k) {
+			cell[k] = hbinWeldCell(pPos[i][k], invTol);
+		}
+		/* only representatives are in the grid, so each vertex maps to the first match in vertex order */
+		for (dz = -range; dz <= range && rep < 0; ++dz) {
+			for (dy = -range; dy <= range && rep < 0; ++dy) {
+				for (dx = -range; dx <= range && rep < 0; ++dx) {
+					int32_t j;
+					slot = hbinHash3((uint32_t)(cell[0] + dx), (uint32_t)(cell[1] + dy), (uint32_t)(cell[2] + dz)) & tblMask;
+					for (j = pHeads[slot]; j >= 0; j = pNext[j]) {
+						float distSq = 0.0f;
+						int same = 1;
+						for (k = 0; k < 3; ++k) {
+							float d = pPos[j][k] - pPos[i][k];
+							distSq += d * d;
+							if (pPos[j][k] != pPos[i][k]) same = 0;
+						}
+						if (tol > 0.0f ? distSq > tolSq : !same) continue;
+						if (pAttrTop && attrSize > 0) {
+							if (hbinMemCmp(pAttrTop + ((size_t)i * (size_t)attrStride), pAttrTop + ((size_t)j * (size_t)attrStride), (size_t)attrSize) != 0) continue;
+						}
+						rep = j;
+						break;
 					}
 				}
 			}
 		}
+		if (rep >= 0) {
+			pRemap[i] = rep;
+			++nmerged;
+		} else {
+			pRemap[i] = i;
+			slot = hbinHash3((uint32_t)cell[0], (uint32_t)cell[1], (uint32_t)cell[2]) & tblMask;
+			pNext[i] = pHeads[slot];
+			pHeads[slot] = i;
+		}
+	}
+	return nmerged;
+}
+
+/* rotated so that the lowest index comes first, winding is kept */
+static void hbinTriCanonical(uint32_t* pDst, const uint32_t* pTri) {
+	int32_t first = 0;
+	int32_t k;
+	if (pTri[1] < pTri[first]) first = 1;
+	if (pTri[2] < pTri[first]) first = 2;
+	for (k = 0; k < 3; ++k) {
+		pDst[k] = pTri[(first + k) % 3];
+	}
+}
+
+HBIN_IFC(int32_t, CleanTrianglesWorkSize)(const int32_t ntris) {
+	return hbinCleanTblSize(ntris);
+}
+
+HBIN_IFC(int32_t, CleanTriangles)(
+	uint32_t* pIdx, int32_t* pMtlIds, const int32_t ntris,
+	const int32_t* pRemap, const HBIN_FLOAT3* pPos, const float minArea,
+	HBIN_TRI_CLEANUP* pStats,
+	int32_t* pWk)
+{
+	int32_t i, k;
+	int32_t tblSize;
+	uint32_t tblMask;
+	int32_t ndegenerate = 0;
+	int32_t nduplicate = 0;
+	int32_t nkept = 0;
+	float crossLim = minArea > 0.0f ? minArea * 2.0f : 0.0f;
+	if (pStats) {
+		pStats->degenerate = 0;
+		pStats->duplicate = 0;
+	}
+	if (!pIdx || ntris <= 0 || !pWk) return 0;
+	tblSize = hbinCleanTblSize(ntris);
+	tblMask = (uint32_t)(tblSize - 1);
+	for (i = 0; i < tblSize; ++i) {
+		pWk[i] = -1;
+	}
+	for (i = 0; i < ntris; ++i) {
+		uint32_t tri[3];
+		uint32_t key[3];
+		uint32_t slot;
+		int dup = 0;
+		for (k = 0; k < 3; ++k) {
+			tri[k] = pIdx[(i * 3) + k];
+			if (pRemap) {
+				tri[k] = (uint32_t)pRemap[tri[k]];
+			}
+		}
+		if (hbinTriDead(tri)) {
+			++ndegenerate;
+			continue;
+		}
+		if (pPos) {
+			float nrm[3];
+			float lenSq;
+			hbinTriNormal(nrm, pPos[tri[0]], pPos[tri[1]], pPos[tri[2]]);
+			lenSq = (nrm[0] * nrm[0]) + (nrm[1] * nrm[1]) + (nrm[2] * nrm[2]);
+			if (lenSq <= crossLim * crossLim) {
+				++ndegenerate;
+				continue;
+			}
+		}
+		hbinTriCanonical(key, tri);
+		slot = hbinHash3(key[0], key[1], key[2]) & tblMask;
+		while (pWk[slot] >= 0) {
+			uint32_t other[3];
+			hbinTriCanonical(other, &pIdx[pWk[slot] * 3]);
+			if (other[0] == key[0] && other[1] == key[1] && other[2] == key[2]) {
+				dup = 1;
+				break;
+			}
+			slot = (slot + 1) & tblMask;
+		}
+		if (dup) {
+			++nduplicate;
+			continue;
+		}
+		pWk[slot] = nkept;
+		for (k = 0; k < 3; ++k) {
+			pIdx[(nkept * 3) + k] = tri[k];
+		}
+		if (pMtlIds) {
+			pMtlIds[nkept] = pMtlIds[i];
+		}
+		++nkept;
+	}
+	if (pStats) {
+		pStats->degenerate = ndegenerate;
+		pStats->duplicate = nduplicate;
+	}
+	return nkept;
+}
+
+static int32_t bgeoWeldTblSize(const int32_t ncorners) {
+	int32_t size = 16;
+	while (size < ncorners * 2) {
+		size <<= 1;
+	}
+	return size;
+}
+
+HBIN_BGEO_IFC(int32_t, WeldWorkSize)(const HBIN_BGEO bgeo) {
+	int32_t ncorners = HBIN_BGEO_FN(CountPolyVertices)(bgeo);
+	return ncorners > 0 ? bgeoWeldTblSize(ncorners) + (ncorners * 2) : 0;
+}
+
+typedef struct _BGEO_WELD_WK {
+	const uint8_t* pTop;
+	int32_t* pCornerVtx;
+	int32_t* pVtxPnts;
+	int32_t* pTbl; /* open addressing: GPU vertex or -1 */
+	uint32_t* pVtxRecs; /* GPU vertex -> offset of its first polygon vertex record, lo/hi pairs */
+	uint32_t tblMask;
+	int32_t ncorners;
+	int32_t nvtx;
+} BGEO_WELD_WK;
+
+static size_t bgeoWeldRecOffs(const BGEO_WELD_WK* pWk, const int32_t vtxId) {
+	uint64_t offs = ((uint64_t)pWk->pVtxRecs[(vtxId * 2) + 1] << 32) | pWk->pVtxRecs[vtxId * 2];
+	return (size_t)offs;
+}
+
+static int bgeoWeldCB(const HBIN_PRIM prim, void* pUserData) {
+	int32_t i, j;
+	int32_t nvtx;
+	BGEO_WELD_WK* pWk = (BGEO_WELD_WK*)pUserData;
+	const HBIN_PRIM_S* pPrim = (const HBIN_PRIM_S*)prim;
+	if (!pWk) return 0;
+	if (!bgeoPrimIsPoly(prim)) return 1;
+	nvtx = pPrim->nvtx;
+	for (i = 0; i < nvtx; ++i) {
+		const uint8_t* pRec = pPrim->pIdx + (i * (pPrim->idxSize + pPrim->vtxAttrsRecSize));
+		int32_t pntId = bgeoPrimVertexPntId(prim, i);
+		const uint8_t* pAttrs = pRec + pPrim->idxSize;
+		uint32_t h = 2166136261U;
+		uint32_t slot;
+		int32_t vtxId = -1;
+		h = (h ^ (uint32_t)(pntId & 0xFF)) * 16777619U;
+		h = (h ^ (uint32_t)((pntId >> 8) & 0xFF)) * 16777619U;
+		h = (h ^ (uint32_t)((pntId >> 16) & 0xFF)) * 16777619U;
+		h = (h ^ (uint32_t)((pntId >> 24) & 0xFF)) * 16777619U;
+		for (j = 0; j < pPrim->vtxAttrsRecSize; ++j) {
+			h = (h ^ pAttrs[j]) * 16777619U;
+		}
+		slot = h & pWk->tblMask;
+		while (pWk->pTbl[slot] >= 0) {
+			int32_t tblVtx = pWk->pTbl[slot];
+			const uint8_t* pTblRec = pWk->pTop + bgeoWeldRecOffs(pWk, tblVtx);
+			if (pWk->pVtxPnts[tblVtx] == pntId && (pPrim->vtxAttrsRecSize == 0 || hbinMemCmp(pTblRec + pPrim->idxSize, pAttrs, pPrim->vtxAttrsRecSize) == 0)) {
+				vtxId = tblVtx;
+				break;
+			}
+			slot = (slot + 1) & pWk->tblMask;
+		}
+		if (vtxId < 0) {
+			vtxId = pWk->nvtx++;
+			pWk->pTbl[slot] = vtxId;
+			pWk->pVtxPnts[vtxId] = pntId;
+			pWk->pVtxRecs[vtxId * 2] = (uint32_t)((uint64_t)(pRec - pWk->pTop) & 0xFFFFFFFFU);
+			pWk->pVtxRecs[(vtxId * 2) + 1] = (uint32_t)((uint64_t)(pRec - pWk->pTop) >> 32);
+		}
+		pWk->pCornerVtx[pWk->ncorners++] = vtxId;
+	}
+	return 1;
+}
+
+HBIN_BGEO_IFC(int32_t, WeldVertices)(const HBIN_BGEO bgeo, int32_t* pCornerVtx, int32_t* pVtxPnts, int32_t* pWk) {
+	int32_t i;
+	int32_t ncorners;
+	int32_t tblSize;
+	BGEO_WELD_WK wk;
+	if (!pCornerVtx || !pVtxPnts || !pWk) return 0;
+	ncorners = HBIN_BGEO_FN(CountPolyVertices)(bgeo);
+	if (ncorners <= 0) return 0;
+	tblSize = bgeoWeldTblSize(ncorners);
+	wk.pTop = (const uint8_t*)bgeo;
+	wk.pCornerVtx = pCornerVtx;
+	wk.pVtxPnts = pVtxPnts;
+	wk.pTbl = pWk;
+	wk.pVtxRecs = (uint32_t*)(pWk + tblSize);
+	wk.tblMask = (uint32_t)(tblSize - 1);
+	wk.ncorners = 0;
+	wk.nvtx = 0;
+	for (i = 0; i < tblSize; ++i) {
+		wk.pTbl[i] = -1;
+	}
+	HBIN_BGEO_FN(ForEachPrim)(bgeo, bgeoWeldCB, &wk);
+	return wk.nvtx;
+}
+
+typedef struct _BGEO_WELD_TRIS_WK {
+	BGEO_POLYTRIS_WK tris;
+	const int32_t* pCornerVtx;
+	int32_t corner;
+} BGEO_WELD_TRIS_WK;
+
+static int bgeoWeldTrisCB(const HBIN_PRIM prim, void* pUserData) {
+	BGEO_WELD_TRIS_WK* pWk = (BGEO_WELD_TRIS_WK*)pUserData;
+	if (!pWk) return 0;
+	if (bgeoPrimIsPoly(prim)) {
+		pWk->tris.pCornerIds = pWk->pCornerVtx + pWk->corner;
+		if (!bgeoPolyTrisCB(prim, &pWk->tris)) return 0;
+		pWk->corner += bgeoPrimNumVertices(prim);
+	}
+	return 1;
+}
+
+HBIN_BGEO_IFC(int32_t, GetWeldedTriangles)(const HBIN_BGEO bgeo, const int32_t* pCornerVtx, uint32_t* pIdx, int32_t* pMtlIds, int32_t* pWk) {
+	int32_t ntris = 0;
+	int32_t nprim = HBIN_BGEO_FN(NumPrims)(bgeo);
+	if (!pWk && HBIN_BGEO_FN(PolyTrianglesWorkSize)(bgeo) > 0) return -1;
+	if (nprim > 0 && pCornerVtx) {
+		BGEO_WELD_TRIS_WK wk;
+		wk.tris.pPts = NULL;
+		wk.tris.pntRecSize = bgeoCalcPntRecSize(bgeo, &wk.tris.pPts);
+		wk.tris.hostOrder = bgeoHostOrder(bgeo);
+		wk.tris.npts = HBIN_BGEO_FN(NumPoints)(bgeo);
+		if (wk.tris.pntRecSize <= 0) {
+			wk.tris.pPts = NULL;
+		}
+		wk.tris.pIdx16 = NULL;
+		wk.tris.pIdx32 = pIdx;
+		wk.tris.pMtlIds = pMtlIds;
+		wk.tris.pCornerIds = NULL;
+		wk.tris.pEarWk = pWk;
+		wk.tris.triCount = 0;
+		wk.pCornerVtx = pCornerVtx;
+		wk.corner = 0;
+		HBIN_BGEO_FN(ForEachPrim)(bgeo, bgeoWeldTrisCB, &wk);
+		ntris = wk.tris.triCount;
+	}
+	return ntris;
+}
+
+typedef struct _BGEO_WELD_VB_WK {
+	HBIN_BGEO bgeo;
+	const int32_t* pCornerVtx;
+	const HBIN_FLOAT3* pNrm;
+	uint8_t* pMem;
+	int32_t stride;
+	int32_t posOffs;
+	int32_t nrmOffs;
+	int32_t rgbOffs;
+	int32_t texOffs;
+	int32_t wgtOffs;
+	int32_t idxOffs;
+	int32_t maxWghts;
+	int32_t numVtxCapts;
+	int32_t vtxNrm;
+	int32_t vtxRGB;
+	int32_t vtxUV;
+	int32_t corner;
+	int32_t nvtx;
+} BGEO_WELD_VB_WK;
+
+static int bgeoWeldVBCB(const HBIN_PRIM prim, void* pUserData) {
+	int32_t i;
+	BGEO_WELD_VB_WK* pWk = (BGEO_WELD_VB_WK*)pUserData;
+	if (!pWk) return 0;
+	if (!bgeoPrimIsPoly(prim)) return 1;
+	for (i = 0; i < bgeoPrimNumVertices(prim); ++i) {
+		/* GPU vertices are numbered in order of first use */
+		if (pWk->pCornerVtx[pWk->corner++] == pWk->nvtx) {
+			uint8_t* pVtx = pWk->pMem + ((size_t)pWk->nvtx * (size_t)pWk->stride);
+			int32_t pntId = bgeoPrimVertexPntId(prim, i);
+			if ((uint32_t)pntId < (uint32_t)HBIN_BGEO_FN(NumPoints)(pWk->bgeo)) {
+				bgeoWriteVertex(pWk->bgeo, pntId, pVtx, pWk->posOffs, pWk->nrmOffs, pWk->rgbOffs, pWk->texOffs, pWk->wgtOffs, pWk->idxOffs, pWk->maxWghts, pWk->numVtxCapts, pWk->pNrm);
+			}
+			if (pWk->nrmOffs >= 0 && pWk->vtxNrm) {
+				HBIN_BGEO_FN(PrimVertexVecAttr)(*(HBIN_FLOAT3*)(pVtx + pWk->nrmOffs), prim, "N", i);
+			}
+			if (pWk->rgbOffs >= 0 && pWk->vtxRGB) {
+				HBIN_BGEO_FN(PrimVertexVecAttr)(*(HBIN_FLOAT3*)(pVtx + pWk->rgbOffs), prim, "Cd", i);
+			}
+			if (pWk->texOffs >= 0 && pWk->vtxUV) {
+				HBIN_FLOAT3 uvw;
+				float* pTex = (float*)(pVtx + pWk->texOffs);
+				HBIN_BGEO_FN(PrimVertexVecAttr)(uvw, prim, "uv", i);
+				pTex[0] = uvw[0];
+				pTex[1] = 1.0f - uvw[1];
+			}
+			++pWk->nvtx;
+		}
 	}
-	return n;
+	return 1;
 }
 
-HBIN_BGEO_IFC(void, MakeVertexBuffer)(
-	const HBIN_BGEO bgeo,
+HBIN_BGEO_IFC(void, MakeWeldedVertexBuffer)(
+	const HBIN_BGEO bgeo, const int32_t* pCornerVtx,
 	void* pMem, const int32_t stride,
 	const int32_t posOffs, const int32_t nrmOffs,
 	const int32_t rgbOffs, const int32_t texOffs,
 	const int32_t wgtOffs, const int32_t idxOffs,
-	const int32_t maxWghts, int32_t* pInflCounts)
+	const int32_t maxWghts, const HBIN_FLOAT3* pNrm)
 {
-	int32_t i, j;
-	int32_t numVtxCapts = 0;
-	int32_t maxCapts = 0;
-	int32_t nvtx = 0;
-	int32_t numCaptNodes = 0;
+	BGEO_WELD_VB_WK wk;
 	if (!HBIN_BGEO_FN(Valid)(bgeo)) return;
-	if (!pMem) return;
+	if (!pCornerVtx || !pMem) return;
 	if (stride <= 0) return;
-	nvtx = HBIN_BGEO_FN(NumPoints)(bgeo);
-	if (nvtx < 1) return;
-	if (maxWghts > 0 && wgtOffs > 0 && idxOffs > 0) {
-		maxCapts = HBIN_BGEO_FN(MaxCapturesPerPoint)(bgeo);
+	wk.bgeo = bgeo;
+	wk.pCornerVtx = pCornerVtx;
+	wk.pNrm = pNrm;
+	wk.pMem = (uint8_t*)pMem;
+	wk.stride = stride;
+	wk.posOffs = posOffs;
+	wk.nrmOffs = nrmOffs;
+	wk.rgbOffs = rgbOffs;
+	wk.texOffs = texOffs;
+	wk.wgtOffs = wgtOffs;
+	wk.idxOffs = idxOffs;
+	wk.maxWghts = maxWghts;
+	wk.numVtxCapts = 0;
+	if (wgtOffs > 0 && idxOffs > 0) {
+		wk.numVtxCapts = bgeoNumVertexCaptures(bgeo, maxWghts);
 	}
-	if (maxCapts > 0) {
-		if (maxWghts < maxCapts) {
-			numVtxCapts = maxWghts;
-		} else {
-			numVtxCapts = maxCapts;
-		}
+	wk.corner = 0;
+	wk.nvtx = 0;
+	wk.vtxNrm = HBIN_BGEO_FN(FindVertexAttr)(bgeo, "N") >= 0;
+	wk.vtxRGB = HBIN_BGEO_FN(FindVertexAttr)(bgeo, "Cd") >= 0;
+	wk.vtxUV = HBIN_BGEO_FN(FindVertexAttr)(bgeo, "uv") >= 0;
+	HBIN_BGEO_FN(ForEachPrim)(bgeo, bgeoWeldVBCB, &wk);
+}
+
+HBIN_BGEO_IFC(int32_t, TriangleIndexSize)(const HBIN_BGEO bgeo) {
+	int32_t npts = HBIN_BGEO_FN(NumPoints)(bgeo);
+	return npts > 0 ? bgeoIdxSize(npts) : 0;
+}
+
+HBIN_BGEO_IFC(int32_t, GetTriangleIndices)(const HBIN_BGEO bgeo, void* pIdx, int32_t* pMtlIds) {
+	int32_t idxSize = HBIN_BGEO_FN(TriangleIndexSize)(bgeo);
+	if (idxSize == 2) {
+		return HBIN_BGEO_FN(GetTriangles)(bgeo, (uint16_t*)pIdx, NULL, pMtlIds);
+	} else if (idxSize == 4) {
+		return HBIN_BGEO_FN(GetTriangles)(bgeo, NULL, (uint32_t*)pIdx, pMtlIds);
 	}
-	if (pInflCounts) {
-		numCaptNodes = bgeoNumCaptureNodes(bgeo);
-		for (i = 0; i < numCaptNodes; ++i) {
-			pInflCounts[i] = 0;
-		}
+	return 0;
+}
+
+HBIN_IFC(int32_t, SplitIndices16)(
+	const uint32_t* pTriIdx, const int32_t ntris, const int32_t nvtx, const int32_t maxChunkVtx,
+	HBIN_MESH_CHUNK* pChunks, uint16_t* pChunkIdx, int32_t* pChunkVtx,
+	int32_t* pWk)
+{
+	int32_t i, j;
+	int32_t nchunk = 0;
+	int32_t maxVtx = maxChunkVtx;
+	int32_t* pStamp;
+	int32_t* pLocal;
+	HBIN_MESH_CHUNK chunk;
+	if (!pTriIdx || ntris <= 0 || nvtx <= 0 || !pWk) return 0;
+	if (maxVtx <= 0 || maxVtx > 0xFFFF) {
+		maxVtx = 0xFFFF;
 	}
+	if (maxVtx < 3) return 0;
+	pStamp = pWk;
+	pLocal = pWk + nvtx;
 	for (i = 0; i < nvtx; ++i) {
-		uint8_t* pVtx = (uint8_t*)pMem + (i * stride);
-		if (posOffs >= 0) {
-			HBIN_BGEO_FN(PointPos)(*(HBIN_FLOAT3*)(pVtx + posOffs), bgeo, i);
-		}
-		if (nrmOffs >= 0) {
-			HBIN_BGEO_FN(PointNrm)(*(HBIN_FLOAT3*)(pVtx + nrmOffs), bgeo, i);
-		}
-		if (rgbOffs >= 0) {
-			HBIN_BGEO_FN(PointRGB)(*(HBIN_FLOAT3*)(pVtx + rgbOffs), bgeo, i);
+		pStamp[i] = 0;
+	}
+	chunk.triOrg = 0;
+	chunk.triCount = 0;
+	chunk.vtxOrg = 0;
+	chunk.vtxCount = 0;
+	for (i = 0; i < ntris; ++i) {
+		const uint32_t* pTri = pTriIdx + (i * 3);
+		int32_t numNew = 0;
+		for (j = 0; j < 3; ++j) {
+			if (pTri[j] >= (uint32_t)nvtx) return -1;
+			if (pStamp[pTri[j]] != nchunk + 1) {
+				if (j == 0 || (pTri[j] != pTri[0] && (j == 1 || pTri[j] != pTri[1]))) {
+					++numNew;
+				}
+			}
 		}
-		if (texOffs >= 0) {
-			HBIN_FLOAT2* pTex = (HBIN_FLOAT2*)(pVtx + texOffs);
-			HBIN_BGEO_FN(PointUV)(*pTex, bgeo, i);
-			(*pTex)[1] = 1.0f - (*pTex)[1];
+		if (chunk.vtxCount + numNew > maxVtx) {
+			if (pChunks) {
+				pChunks[nchunk] = chunk;
+			}
+			++nchunk;
+			chunk.triOrg += chunk.triCount;
+			chunk.vtxOrg += chunk.vtxCount;
+			chunk.triCount = 0;
+			chunk.vtxCount = 0;
 		}
-		if (wgtOffs >= 0 || idxOffs >= 0) {
-			float* pWgt = wgtOffs < 0 ? NULL : (float*)(pVtx + wgtOffs);
-			int32_t* pIdx = idxOffs < 0 ? NULL : (int32_t*)(pVtx + idxOffs);
-			if (pWgt) {
-				for (j = 0; j < maxWghts; ++j) {
-					pWgt[j] = 0.0f;
-				}
-				if (maxWghts > 0) {
-					pWgt[0] = 1.0f;
+		for (j = 0; j < 3; ++j) {
+			uint32_t vtxId = pTri[j];
+			if (pStamp[vtxId] != nchunk + 1) {
+				pStamp[vtxId] = nchunk + 1;
+				pLocal[vtxId] = chunk.vtxCount;
+				if (pChunkVtx) {
+					pChunkVtx[chunk.vtxOrg + chunk.vtxCount] = (int32_t)vtxId;
 				}
+				++chunk.vtxCount;
 			}
-			if (pIdx) {
-				for (j = 0; j < maxWghts; ++j) {
-					pIdx[j] = 0;
-				}
+			if (pChunkIdx) {
+				pChunkIdx[(i * 3) + j] = (uint16_t)pLocal[vtxId];
 			}
-			for (j = 0; j < numVtxCapts; ++j) {
-				HBIN_CAPTURE capt = HBIN_BGEO_FN(PointCapture)(bgeo, i, j);
-				if (pWgt) {
-					pWgt[j] = capt.wght;
-				}
-				if (pIdx) {
-					pIdx[j] = capt.node;
+		}
+		++chunk.triCount;
+	}
+	if (chunk.triCount > 0) {
+		if (pChunks) {
+			pChunks[nchunk] = chunk;
+		}
+		++nchunk;
+	}
+	return nchunk;
+}
+
+typedef struct _BGEO_CAPT_INFO {
+	const uint8_t* pPts;
+	int hostOrder;
+	int32_t recSize;
+	int32_t valOffs;
+	int32_t nwgt;
+} BGEO_CAPT_INFO;
+
+static int bgeoGetCaptInfo(const HBIN_BGEO bgeo, BGEO_CAPT_INFO* pInfo) {
+	int32_t nattr = HBIN_BGEO_FN(NumPointAttrs)(bgeo);
+	pInfo->pPts = NULL;
+	pInfo->hostOrder = bgeoHostOrder(bgeo);
+	pInfo->recSize = 0;
+	pInfo->valOffs = 0;
+	pInfo->nwgt = 0;
+	if (nattr > 0) {
+		int32_t attrType = 0;
+		int32_t attrSize = 0;
+		int32_t attrId = bgeoFindAttrInfo(bgeo, nattr, 0x29, 4 * 4, s_pBgeoCaptAttrName, NULL, &pInfo->valOffs, &attrType, &attrSize, NULL);
+		if (attrId >= 0 && attrType == 0x10000) {
+			pInfo->nwgt = attrSize / 2;
+			pInfo->recSize = bgeoCalcPntRecSize(bgeo, &pInfo->pPts);
+		}
+	}
+	return (pInfo->nwgt > 0 && pInfo->recSize > 0 && pInfo->pPts);
+}
+
+static HBIN_CAPTURE bgeoCaptFromInfo(const BGEO_CAPT_INFO* pInfo, const int32_t pntId, const int32_t wgtId) {
+	HBIN_CAPTURE capt;
+	const uint8_t* pWgt = pInfo->pPts + ((size_t)pntId * (size_t)pInfo->recSize) + pInfo->valOffs + (wgtId * 8);
+	capt.node = (int32_t)hbinRecF32(pWgt, pInfo->hostOrder);
+	capt.wght = hbinRecF32(pWgt + 4, pInfo->hostOrder);
+	return capt;
+}
+
+HBIN_BGEO_IFC(int32_t, SkinBatchesWorkSize)(const HBIN_BGEO bgeo) {
+	int32_t npts = HBIN_BGEO_FN(NumPoints)(bgeo);
+	int32_t nnodes = HBIN_BGEO_FN(NumCaptureNodes)(bgeo);
+	if (npts < 0) npts = 0;
+	if (nnodes < 0) nnodes = 0;
+	return (nnodes * 3) + (npts * 2);
+}
+
+HBIN_BGEO_IFC(int32_t, SkinBatches)(
+	const HBIN_BGEO bgeo, const uint32_t* pTriIdx, const int32_t ntris,
+	const int32_t maxPalSize, const int32_t maxWghts,
+	HBIN_SKIN_BATCH* pBatches, uint32_t* pBatchIdx, int32_t* pBatchPnts, int32_t* pPalNodes,
+	int32_t* pBatchCapts, int32_t* pWk)
+{
+	int32_t i, j, k;
+	int32_t nbatch = 0;
+	int32_t npts = HBIN_BGEO_FN(NumPoints)(bgeo);
+	int32_t nnodes = HBIN_BGEO_FN(NumCaptureNodes)(bgeo);
+	int32_t numVtxCapts = bgeoNumVertexCaptures(bgeo, maxWghts);
+	int32_t* pNodeStamp;
+	int32_t* pNodeLocal;
+	int32_t* pNodeTri;
+	int32_t* pPntStamp;
+	int32_t* pPntLocal;
+	BGEO_CAPT_INFO capt;
+	HBIN_SKIN_BATCH batch;
+	if (!pTriIdx || ntris <= 0 || !pWk || maxPalSize <= 0) return 0;
+	if (npts <= 0 || nnodes <= 0) return 0;
+	if (!bgeoGetCaptInfo(bgeo, &capt)) {
+		numVtxCapts = 0;
+	}
+	pNodeStamp = pWk;
+	pNodeLocal = pNodeStamp + nnodes;
+	pNodeTri = pNodeLocal + nnodes;
+	pPntStamp = pNodeTri + nnodes;
+	pPntLocal = pPntStamp + npts;
+	for (i = 0; i < nnodes; ++i) {
+		pNodeStamp[i] = 0;
+		pNodeTri[i] = 0;
+	}
+	for (i = 0; i < npts; ++i) {
+		pPntStamp[i] = 0;
+	}
+	batch.triOrg = 0;
+	batch.triCount = 0;
+	batch.vtxOrg = 0;
+	batch.vtxCount = 0;
+	batch.palOrg = 0;
+	batch.palCount = 0;
+	for (i = 0; i < ntris; ++i) {
+		const uint32_t* pTri = pTriIdx + (i * 3);
+		int32_t numNew = 0;
+		for (j = 0; j < 3; ++j) {
+			if (pTri[j] >= (uint32_t)npts) return -1;
+			for (k = 0; k < numVtxCapts; ++k) {
+				HBIN_CAPTURE c = bgeoCaptFromInfo(&capt, (int32_t)pTri[j], k);
+				if (c.node >= 0 && c.node < nnodes && c.wght > 0.0f) {
+					if (pNodeStamp[c.node] != nbatch + 1 && pNodeTri[c.node] != i + 1) {
+						pNodeTri[c.node] = i + 1;
+						++numNew;
+					}
 				}
 			}
-			for (j = 0; j < numVtxCapts; ++j) {
-				if (pIdx[j] < 0) {
-					pWgt[j] = 0.0f;
-				}
-				if (pWgt[j] <= 0.0f) {
-					pIdx[j] = 0;
-					pWgt[j] = 0.0f;
-				}
+		}
+		if (batch.palCount + numNew > maxPalSize && batch.triCount > 0) {
+			if (pBatches) {
+				pBatches[nbatch] = batch;
 			}
-			if (pInflCounts) {
-				for (j = 0; j < numVtxCapts; ++j) {
-					if (pWgt[j] > 0.0f) {
-						++pInflCounts[pIdx[j]];
+			++nbatch;
+			batch.triOrg += batch.triCount;
+			batch.vtxOrg += batch.vtxCount;
+			batch.palOrg += batch.palCount;
+			batch.triCount = 0;
+			batch.vtxCount = 0;
+			batch.palCount = 0;
+			/* every node of this triangle is new to the fresh palette */
+			numNew = 0;
+			for (j = 0; j < 3; ++j) {
+				for (k = 0; k < numVtxCapts; ++k) {
+					HBIN_CAPTURE c = bgeoCaptFromInfo(&capt, (int32_t)pTri[j], k);
+					if (c.node >= 0 && c.node < nnodes && c.wght > 0.0f) {
+						if (pNodeTri[c.node] != -(i + 1)) {
+							pNodeTri[c.node] = -(i + 1);
+							++numNew;
+						}
 					}
 				}
 			}
 		}
-	}
-}
-
-typedef struct _BGEO_GETTRIS_WK {
-	uint16_t* pIdx16;
-	uint32_t* pIdx32;
-	int32_t* pMtlIds;
-	int32_t triCount;
-} BGEO_GETTRIS_WK;
-
-static int bgeoGetTrisCB(const HBIN_PRIM prim, void* pUserData) {
-	int32_t i;
-	BGEO_GETTRIS_WK* pWk = (BGEO_GETTRIS_WK*)pUserData;
-	if (!pWk) return 0;
-	if (bgeoPrimIsPoly(prim)) {
-		int32_t nvtx = bgeoPrimNumVertices(prim);
-		if (nvtx == 3) {
-			if (pWk->pIdx16) {
-				int idxOrg = pWk->triCount * 3;
-				for (i = 0; i < 3; ++i) {
-					pWk->pIdx16[idxOrg + i] = (uint16_t)bgeoPrimVertexPntId(prim, i);
+		if (numNew > maxPalSize) return -1;
+		for (j = 0; j < 3; ++j) {
+			int32_t pntId = (int32_t)pTri[j];
+			for (k = 0; k < numVtxCapts; ++k) {
+				HBIN_CAPTURE c = bgeoCaptFromInfo(&capt, pntId, k);
+				if (c.node >= 0 && c.node < nnodes && c.wght > 0.0f) {
+					if (pNodeStamp[c.node] != nbatch + 1) {
+						pNodeStamp[c.node] = nbatch + 1;
+						pNodeLocal[c.node] = batch.palCount;
+						if (pPalNodes) {
+							pPalNodes[batch.palOrg + batch.palCount] = c.node;
+						}
+						++batch.palCount;
+					}
 				}
 			}
-			if (pWk->pIdx32) {
-				int idxOrg = pWk->triCount * 3;
-				for (i = 0; i < 3; ++i) {
-					pWk->pIdx32[idxOrg + i] = (uint32_t)bgeoPrimVertexPntId(prim, i);
+			if (pPntStamp[pntId] != nbatch + 1) {
+				pPntStamp[pntId] = nbatch + 1;
+				pPntLocal[pntId] = batch.vtxCount;
+				if (pBatchPnts) {
+					pBatchPnts[batch.vtxOrg + batch.vtxCount] = pntId;
+				}
+				if (pBatchCapts && maxWghts > 0) {
+					int32_t* pLoc = pBatchCapts + ((size_t)(batch.vtxOrg + batch.vtxCount) * (size_t)maxWghts);
+					for (k = 0; k < maxWghts; ++k) {
+						pLoc[k] = -1;
+					}
+					for (k = 0; k < numVtxCapts; ++k) {
+						HBIN_CAPTURE c = bgeoCaptFromInfo(&capt, pntId, k);
+						if (c.node >= 0 && c.node < nnodes && c.wght > 0.0f) {
+							pLoc[k] = pNodeLocal[c.node];
+						}
+					}
 				}
+				++batch.vtxCount;
 			}
-			if (pWk->pMtlIds) {
-				pWk->pMtlIds[pWk->triCount] = bgeoPrimMaterialId(prim);
+			if (pBatchIdx) {
+				pBatchIdx[(i * 3) + j] = (uint32_t)pPntLocal[pntId];
 			}
-			++pWk->triCount;
 		}
+		++batch.triCount;
 	}
-	return 1;
+	if (batch.triCount > 0) {
+		if (pBatches) {
+			pBatches[nbatch] = batch;
+		}
+		++nbatch;
+	}
+	return nbatch;
 }
 
-HBIN_BGEO_IFC(int32_t, GetTriangles)(
-	const HBIN_BGEO bgeo, uint16_t* pIdx16, uint32_t* pIdx32, int32_t* pMtlIds)
+HBIN_BGEO_IFC(void, MakeSkinBatchVertexBuffer)(
+	const HBIN_BGEO bgeo, const HBIN_SKIN_BATCH* pBatch,
+	const int32_t* pBatchPnts, const int32_t* pPalNodes,
+	void* pMem, const int32_t stride,
+	const int32_t posOffs, const int32_t nrmOffs,
+	const int32_t rgbOffs, const int32_t texOffs,
+	const int32_t wgtOffs, const int32_t idxOffs,
+	const int32_t maxWghts, const HBIN_FLOAT3* pNrm)
 {
-	int32_t ntris = 0;
-	int32_t nprim = HBIN_BGEO_FN(NumPrims)(bgeo);
-	if (nprim > 0) {
-		BGEO_GETTRIS_WK wk;
-		wk.pIdx16 = pIdx16;
-		wk.pIdx32 = pIdx32;
-		wk.pMtlIds = pMtlIds;
-		wk.triCount = 0;
-		HBIN_BGEO_FN(ForEachPrim)(bgeo, bgeoGetTrisCB, &wk);
-		ntris = wk.triCount;
+	int32_t i, j, k;
+	int32_t numVtxCapts = 0;
+	int32_t npts = HBIN_BGEO_FN(NumPoints)(bgeo);
+	const int32_t* pPnts;
+	const int32_t* pPal;
+	if (!HBIN_BGEO_FN(Valid)(bgeo)) return;
+	if (!pBatch || !pBatchPnts || !pMem) return;
+	if (stride <= 0) return;
+	if (wgtOffs > 0 && idxOffs > 0) {
+		numVtxCapts = bgeoNumVertexCaptures(bgeo, maxWghts);
+	}
+	pPnts = pBatchPnts + pBatch->vtxOrg;
+	pPal = pPalNodes ? pPalNodes + pBatch->palOrg : NULL;
+	for (i = 0; i < pBatch->vtxCount; ++i) {
+		uint8_t* pVtx = (uint8_t*)pMem + ((size_t)i * (size_t)stride);
+		if ((uint32_t)pPnts[i] >= (uint32_t)npts) continue;
+		bgeoWriteVertex(bgeo, pPnts[i], pVtx, posOffs, nrmOffs, rgbOffs, texOffs, wgtOffs, idxOffs, maxWghts, numVtxCapts, pNrm);
+		if (idxOffs >= 0 && numVtxCapts > 0) {
+			float* pWgt = (float*)(pVtx + wgtOffs);
+			int32_t* pIdx = (int32_t*)(pVtx + idxOffs);
+			for (j = 0; j < numVtxCapts; ++j) {
+				int32_t loc = 0;
+				if (pWgt[j] > 0.0f && pPal) {
+					for (k = 0; k < pBatch->palCount; ++k) {
+						if (pPal[k] == pIdx[j]) {
+							loc = k;
+							break;
+						}
+					}
+				}
+				pIdx[j] = loc;
+			}
+		}
 	}
-	return ntris;
 }
 
 
@@ -1420,113 +5581,120 @@ HBIN_BCLIP_IFC(int, Valid)(const HBIN_BCLIP bclip) {
 	int valid = 0;
 	const uint8_t* pTop = (const uint8_t*)bclip;
 	if (pTop) {
-		static const char* pSig = "bclp";
-		if (hbinMemCmp(pTop, pSig, 4) == 0) {
-			valid = 1;
+		static const char* pSig = "bcl";
+		if (hbinMemCmp(pTop, pSig, 3) == 0) {
+			if (pTop[3] == 'p' || pTop[3] == 'P') {
+				valid = 1;
+			}
 		}
 	}
 	return valid;
 }
 
-static const uint8_t* bclipFindPacket(const HBIN_BCLIP bclip, const int32_t pktTag) {
-	const uint8_t* pPkt = NULL;
-	if (HBIN_BCLIP_FN(Valid)(bclip)) {
-		const uint8_t* pTop = (const uint8_t*)bclip;
-		const uint8_t* pMem = pTop + 4;
-		while (1) {
-			int32_t pktSize = hbinI32(pMem);
-			if (pktSize > 0) {
-				uint16_t tag = hbinU16(pMem + 4);
-				if (tag != 0xF) {
-					break;
-				}
-				tag = hbinU16(pMem + 6);
-				if (tag == pktTag) {
-					pPkt = pMem;
-					break;
-				}
-				if (tag == 0) {
-					/* END */
-					break;
-				}
-				pMem += pktSize;
-			} else {
-				break;
-			}
+/* 'P': track samples are in host order, see bclipNormalize */
+static int bclipHostOrder(const HBIN_BCLIP bclip) {
+	return ((const uint8_t*)bclip)[3] == 'P';
+}
+
+/* header packet offsets by tag, 0 if missing */
+typedef struct _BCLIP_DIR {
+	size_t pkt[0x10];
+} BCLIP_DIR;
+
+/* one pass over the header packets, checked against size; stops at the track packets or END */
+static void bclipScanDir(BCLIP_DIR* pDir, const uint8_t* pTop, const size_t size) {
+	int32_t i;
+	size_t offs = 4;
+	for (i = 0; i < 0x10; ++i) {
+		pDir->pkt[i] = 0;
+	}
+	while (offs <= size && size - offs >= 0xC) {
+		int32_t pktSize = hbinI32(pTop + offs);
+		uint16_t tag;
+		if (pktSize <= 0 || hbinU16(pTop + offs + 4) != 0xF) break;
+		tag = hbinU16(pTop + offs + 6);
+		if (tag < 0x10 && !pDir->pkt[tag]) {
+			pDir->pkt[tag] = offs;
 		}
+		if (tag == 0 || (size_t)pktSize > size - offs) break;
+		offs += (size_t)pktSize;
 	}
-	return pPkt;
 }
 
-HBIN_BCLIP_IFC(int32_t, Version)(const HBIN_BCLIP bclip) {
-	int32_t ver = 0;
-	const uint8_t* pVer = bclipFindPacket(bclip, 9);
-	if (pVer) {
-		ver = hbinI32(pVer + 8);
+/* unchecked scan for the accessors that are not given a size */
+static int bclipDir(BCLIP_DIR* pDir, const HBIN_BCLIP bclip) {
+	int32_t i;
+	if (!HBIN_BCLIP_FN(Valid)(bclip)) {
+		for (i = 0; i < 0x10; ++i) {
+			pDir->pkt[i] = 0;
+		}
+		return 0;
 	}
-	return ver;
+	bclipScanDir(pDir, (const uint8_t*)bclip, ~(size_t)0);
+	return 1;
 }
 
-static int bclipIsInfoF64(const HBIN_BCLIP bclip) {
-	int isDbl = 0;
-	const uint8_t* pTyp = bclipFindPacket(bclip, 0xA);
-	if (pTyp) {
-		isDbl = pTyp[8];
+/* packet payload offset if the packet exists and holds at least n payload bytes within size, 0 otherwise */
+static size_t bclipDirData(const uint8_t* pTop, const size_t size, const BCLIP_DIR* pDir, const int32_t tag, const size_t n) {
+	size_t offs = pDir->pkt[tag];
+	if (offs) {
+		int32_t pktSize = hbinI32(pTop + offs);
+		if ((size_t)pktSize > size - offs || (size_t)pktSize < 8 + n) {
+			offs = 0;
+		}
 	}
-	return isDbl;
+	return offs ? offs + 8 : 0;
 }
 
-HBIN_BCLIP_IFC(double, SampleRate)(const HBIN_BCLIP bclip) {
-	double rate = 0.0;
-	const uint8_t* pRate = bclipFindPacket(bclip, 1);
-	if (pRate) {
-		if (bclipIsInfoF64(bclip)) {
-			rate = hbinF64(pRate + 8);
+static int32_t bclipDirI32(const uint8_t* pTop, const BCLIP_DIR* pDir, const int32_t tag) {
+	return pDir->pkt[tag] ? hbinI32(pTop + pDir->pkt[tag] + 8) : 0;
+}
+
+static int bclipDirFlag(const uint8_t* pTop, const BCLIP_DIR* pDir, const int32_t tag) {
+	return pDir->pkt[tag] ? pTop[pDir->pkt[tag] + 8] : 0;
+}
+
+/* rate/start: float or double as selected by packet 0xA */
+static double bclipDirInfo(const uint8_t* pTop, const BCLIP_DIR* pDir, const int32_t tag) {
+	double val = 0.0;
+	if (pDir->pkt[tag]) {
+		if (bclipDirFlag(pTop, pDir, 0xA)) {
+			val = hbinF64(pTop + pDir->pkt[tag] + 8);
 		} else {
-			rate = hbinF32(pRate + 8);
+			val = hbinF32(pTop + pDir->pkt[tag] + 8);
 		}
 	}
-	return rate;
+	return val;
+}
+
+HBIN_BCLIP_IFC(int32_t, Version)(const HBIN_BCLIP bclip) {
+	BCLIP_DIR dir;
+	bclipDir(&dir, bclip);
+	return bclipDirI32((const uint8_t*)bclip, &dir, 9);
+}
+
+HBIN_BCLIP_IFC(double, SampleRate)(const HBIN_BCLIP bclip) {
+	BCLIP_DIR dir;
+	bclipDir(&dir, bclip);
+	return bclipDirInfo((const uint8_t*)bclip, &dir, 1);
 }
 
 HBIN_BCLIP_IFC(double, StartIndex)(const HBIN_BCLIP bclip) {
-	double start = 0.0;
-	const uint8_t* pStart = bclipFindPacket(bclip, 2);
-	if (pStart) {
-		if (bclipIsInfoF64(bclip)) {
-			start = hbinF64(pStart + 8);
-		} else {
-			start = hbinF32(pStart + 8);
-		}
-	}
-	return start;
+	BCLIP_DIR dir;
+	bclipDir(&dir, bclip);
+	return bclipDirInfo((const uint8_t*)bclip, &dir, 2);
 }
 
 HBIN_BCLIP_IFC(int32_t, TrackLength)(const HBIN_BCLIP bclip) {
-	int32_t len = 0;
-	const uint8_t* pLen = bclipFindPacket(bclip, 3);
-	if (pLen) {
-		len = hbinI32(pLen + 8);
-	}
-	return len;
+	BCLIP_DIR dir;
+	bclipDir(&dir, bclip);
+	return bclipDirI32((const uint8_t*)bclip, &dir, 3);
 }
 
 HBIN_BCLIP_IFC(int32_t, NumTracks)(const HBIN_BCLIP bclip) {
-	int n = 0;
-	const uint8_t* pTracks = bclipFindPacket(bclip, 5);
-	if (pTracks) {
-		n = hbinI32(pTracks + 8);
-	}
-	return n;
-}
-
-static int bclipIsTrackF64(const HBIN_BCLIP bclip) {
-	int isDbl = 0;
-	const uint8_t* pTyp = bclipFindPacket(bclip, 8);
-	if (pTyp) {
-		isDbl = pTyp[8];
-	}
-	return isDbl;
+	BCLIP_DIR dir;
+	bclipDir(&dir, bclip);
+	return bclipDirI32((const uint8_t*)bclip, &dir, 5);
 }
 
 HBIN_BCLIP_IFC(void, AllTracks)(const HBIN_BCLIP bclip, float* pSmps /* [numTracks][trackLen] */, HBIN_STRING* pNames /* [numTracks] */) {
@@ -1534,14 +5702,17 @@ HBIN_BCLIP_IFC(void, AllTracks)(const HBIN_BCLIP bclip, float* pSmps /* [numTrac
 	int isDbl = 0;
 	int32_t ntrk = 0;
 	int32_t nsmp = 0;
+	int hostOrder = 0;
+	const uint8_t* pTop = (const uint8_t*)bclip;
 	const uint8_t* pTrk = NULL;
-	if (!HBIN_BCLIP_FN(Valid)(bclip)) return;
-	ntrk = HBIN_BCLIP_FN(NumTracks)(bclip);
-	nsmp = HBIN_BCLIP_FN(TrackLength)(bclip);
-	isDbl = bclipIsTrackF64(bclip);
-	pTrk = bclipFindPacket(bclip, 5);
-	if (!pTrk) return;
-	pTrk += 0xC;
+	BCLIP_DIR dir;
+	if (!bclipDir(&dir, bclip)) return;
+	ntrk = bclipDirI32(pTop, &dir, 5);
+	nsmp = bclipDirI32(pTop, &dir, 3);
+	isDbl = bclipDirFlag(pTop, &dir, 8);
+	hostOrder = bclipHostOrder(bclip);
+	if (!dir.pkt[5]) return;
+	pTrk = pTop + dir.pkt[5] + 0xC;
 	for (i = 0; i < ntrk; ++i) {
 		while (1) {
 			int32_t pktLen = hbinI32(pTrk);
@@ -1564,13 +5735,13 @@ HBIN_BCLIP_IFC(void, AllTracks)(const HBIN_BCLIP bclip, float* pSmps /* [numTrac
 					const uint8_t* pSrc = pTrk + 8;
 					if (isDbl) {
 						for (j = 0; j < nsmp; ++j) {
-							*pDst = (float)hbinF64(pSrc);
+							*pDst = (float)hbinRecF64(pSrc, hostOrder);
 							++pDst;
 							pSrc += 8;
 						}
 					} else {
 						for (j = 0; j < nsmp; ++j) {
-							*pDst = hbinF32(pSrc);
+							*pDst = hbinRecF32(pSrc, hostOrder);
 							++pDst;
 							pSrc += 4;
 						}
@@ -1584,3 +5755,158 @@ HBIN_BCLIP_IFC(void, AllTracks)(const HBIN_BCLIP bclip, float* pSmps /* [numTrac
 		}
 	}
 }
+
+/* the track packet walk of bclipAllTracks, checked against size: records names and sample pointers in pTracks (may be NULL), swaps sample packets if swap != 0 */
+static int bclipWalkTracks(
+	uint8_t* pTop, const size_t size, const BCLIP_DIR* pDir,
+	const int32_t ntrk, const int32_t nsmp, const int32_t smpSize,
+	HBIN_CLIP_TRACK* pTracks, const int swap)
+{
+	int32_t i;
+	size_t offs;
+	if (!pDir->pkt[5] || nsmp < 0 || ntrk < 0) return 0;
+	offs = pDir->pkt[5] + 0xC;
+	for (i = 0; i < ntrk; ++i) {
+		if (pTracks) {
+			pTracks[i].name.pChars = NULL;
+			pTracks[i].name.len = 0;
+			pTracks[i].pSmps = NULL;
+		}
+		while (1) {
+			int32_t pktLen;
+			int32_t pktTag;
+			if (offs > size || size - offs < 8) return 0;
+			pktLen = hbinI32(pTop + offs);
+			if (pktLen < 8 || (size_t)pktLen > size - offs) return 0;
+			if (hbinU16(pTop + offs + 4) != 0x10) return 0;
+			pktTag = hbinU16(pTop + offs + 6);
+			if (pktTag == 1 && pTracks) {
+				size_t nameOrg = 0xA;
+				size_t nameLen;
+				if (pktLen < 0xA) return 0;
+				nameLen = hbinU16(pTop + offs + 8);
+				if (nameLen == 0xFFFF) {
+					if (pktLen < 0xE) return 0;
+					nameLen = hbinU32(pTop + offs + 0xA);
+					nameOrg = 0xE;
+				}
+				if (nameLen > (size_t)pktLen - nameOrg) return 0;
+				pTracks[i].name.pChars = (const char*)(pTop + offs + nameOrg);
+				pTracks[i].name.len = nameLen;
+			} else if (pktTag == 2) {
+				if ((size_t)(pktLen - 8) / (size_t)smpSize < (size_t)nsmp) return 0;
+				if (pTracks) {
+					pTracks[i].pSmps = pTop + offs + 8;
+				}
+				if (swap) {
+					if (smpSize == 8) {
+						hbinSwap64(pTop + offs + 8, (size_t)nsmp);
+					} else {
+						hbinSwap32(pTop + offs + 8, (size_t)nsmp);
+					}
+				}
+			}
+			offs += (size_t)pktLen;
+			if (pktTag == 0) { /* END */
+				break;
+			}
+		}
+	}
+	return 1;
+}
+
+/* track count, length and sample size from a checked directory; 0 if the packets are missing or short */
+static int bclipDirTracks(const uint8_t* pTop, const size_t size, const BCLIP_DIR* pDir, int32_t* pNumTrk, int32_t* pNumSmp, int32_t* pSmpSize) {
+	if (!bclipDirData(pTop, size, pDir, 3, 4) || !bclipDirData(pTop, size, pDir, 5, 4)) return 0;
+	*pNumSmp = bclipDirI32(pTop, pDir, 3);
+	*pNumTrk = bclipDirI32(pTop, pDir, 5);
+	*pSmpSize = (bclipDirData(pTop, size, pDir, 8, 1) && bclipDirFlag(pTop, pDir, 8)) ? 8 : 4;
+	return *pNumSmp >= 0 && *pNumTrk >= 0;
+}
+
+HBIN_BCLIP_IFC(int, Normalize)(HBIN_BCLIP bclip, const size_t size) {
+	uint8_t* pTop = (uint8_t*)bclip;
+	BCLIP_DIR dir;
+	int32_t ntrk, nsmp, smpSize;
+	if (!pTop || size < 4 || !HBIN_BCLIP_FN(Valid)(bclip)) return 0;
+	if (bclipHostOrder(bclip)) return 1;
+	bclipScanDir(&dir, pTop, size);
+	if (!bclipDirTracks(pTop, size, &dir, &ntrk, &nsmp, &smpSize)) return 0;
+	if (!bclipWalkTracks(pTop, size, &dir, ntrk, nsmp, smpSize, NULL, 0)) return 0;
+	if (hbinHostLE()) {
+		bclipWalkTracks(pTop, size, &dir, ntrk, nsmp, smpSize, NULL, 1);
+	}
+	pTop[3] = 'P';
+	return 1;
+}
+
+HBIN_BCLIP_IFC(int, IsNormalized)(const HBIN_BCLIP bclip) {
+	return HBIN_BCLIP_FN(Valid)(bclip) && bclipHostOrder(bclip);
+}
+
+HBIN_BCLIP_IFC(int32_t, SampleSize)(const HBIN_BCLIP bclip) {
+	BCLIP_DIR dir;
+	bclipDir(&dir, bclip);
+	return bclipDirFlag((const uint8_t*)bclip, &dir, 8) ? 8 : 4;
+}
+
+HBIN_BCLIP_IFC(int, Open)(HBIN_CLIP* pClip, const HBIN_BCLIP bclip, const size_t size, HBIN_CLIP_TRACK* pTracks) {
+	uint8_t* pTop = (uint8_t*)bclip;
+	BCLIP_DIR dir;
+	int32_t ntrk, nsmp, smpSize;
+	size_t infoSize;
+	if (!pClip) return 0;
+	pClip->bclip = NULL;
+	pClip->rate = 0.0;
+	pClip->start = 0.0;
+	pClip->version = 0;
+	pClip->nsmp = 0;
+	pClip->ntrk = 0;
+	pClip->smpSize = 4;
+	pClip->hostOrder = 0;
+	pClip->pTracks = NULL;
+	if (!pTop || size < 4 || !HBIN_BCLIP_FN(Valid)(bclip)) return 0;
+	bclipScanDir(&dir, pTop, size);
+	if (!bclipDirTracks(pTop, size, &dir, &ntrk, &nsmp, &smpSize)) return 0;
+	if (pTracks && !bclipWalkTracks(pTop, size, &dir, ntrk, nsmp, smpSize, pTracks, 0)) return 0;
+	infoSize = (bclipDirData(pTop, size, &dir, 0xA, 1) && bclipDirFlag(pTop, &dir, 0xA)) ? 8 : 4;
+	if (bclipDirData(pTop, size, &dir, 1, infoSize)) {
+		pClip->rate = bclipDirInfo(pTop, &dir, 1);
+	}
+	if (bclipDirData(pTop, size, &dir, 2, infoSize)) {
+		pClip->start = bclipDirInfo(pTop, &dir, 2);
+	}
+	if (bclipDirData(pTop, size, &dir, 9, 4)) {
+		pClip->version = bclipDirI32(pTop, &dir, 9);
+	}
+	pClip->bclip = bclip;
+	pClip->nsmp = nsmp;
+	pClip->ntrk = ntrk;
+	pClip->smpSize = smpSize;
+	pClip->hostOrder = bclipHostOrder(bclip);
+	pClip->pTracks = pTracks;
+	return 1;
+}
+
+HBIN_BCLIP_IFC(const void*, TrackSamples)(const HBIN_CLIP* pClip, const int32_t trkId) {
+	if (!pClip || !pClip->hostOrder || !pClip->pTracks || (uint32_t)trkId >= (uint32_t)pClip->ntrk) return NULL;
+	return pClip->pTracks[trkId].pSmps;
+}
+
+HBIN_BCLIP_IFC(int, ReadTrack)(const HBIN_CLIP* pClip, const int32_t trkId, float* pSmps) {
+	int32_t i;
+	const uint8_t* pSrc;
+	if (!pClip || !pClip->pTracks || !pSmps || (uint32_t)trkId >= (uint32_t)pClip->ntrk) return 0;
+	pSrc = pClip->pTracks[trkId].pSmps;
+	if (!pSrc) return 0;
+	if (pClip->smpSize == 8) {
+		for (i = 0; i < pClip->nsmp; ++i) {
+			pSmps[i] = (float)hbinRecF64(pSrc + ((size_t)i * 8), pClip->hostOrder);
+		}
+	} else {
+		for (i = 0; i < pClip->nsmp; ++i) {
+			pSmps[i] = hbinRecF32(pSrc + ((size_t)i * 4), pClip->hostOrder);
+		}
+	}
+	return 1;
+}
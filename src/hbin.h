@@ -33,6 +33,18 @@ typedef void* HBIN_BCLIP;
 typedef float HBIN_FLOAT3[3];
 typedef float HBIN_FLOAT2[2];
 
+#define HBIN_NRM_WEIGHT_AREA 0
+#define HBIN_NRM_WEIGHT_ANGLE 1
+#define HBIN_NRM_WEIGHT_ANGLE_AREA 2
+
+/* attribute value types as stored in the file */
+#define HBIN_ATTRTYPE_FLOAT 0
+#define HBIN_ATTRTYPE_INT 1
+#define HBIN_ATTRTYPE_STRING 4 /* per-item index into the attribute string table */
+#define HBIN_ATTRTYPE_VECTOR 5
+
+#define HBIN_BIT_TEST(_pBits, _i) (((_pBits)[(_i) >> 5] >> ((_i) & 31)) & 1U)
+
 typedef void* HBIN_PRIM;
 typedef int (*HBIN_PRIM_CB)(const HBIN_PRIM prim, void* pUserData);
 
@@ -41,19 +53,257 @@ typedef struct _HBIN_STRING {
 	size_t len;
 } HBIN_STRING;
 
+/* attribute value layout for typed access (see hbin.hpp) */
+typedef struct _HBIN_ATTR_DATA {
+	const uint8_t* pRecs; /* first record; NULL for primitive attributes, see bgeoPrimAttrRecord */
+	int32_t stride; /* bytes between records, 0 for detail attributes */
+	int32_t offs; /* value offset within a record */
+	int32_t count; /* number of records */
+	int32_t type; /* HBIN_ATTRTYPE_* */
+	int32_t size; /* 32-bit values per record */
+	int32_t hostOrder; /* values are in host byte order, see bgeoNormalize */
+} HBIN_ATTR_DATA;
+
+typedef struct _HBIN_CLIP_TRACK {
+	HBIN_STRING name;
+	const uint8_t* pSmps; /* [nsmp] values of smpSize bytes */
+} HBIN_CLIP_TRACK;
+
+/* bclip packet directory, see bclipOpen */
+typedef struct _HBIN_CLIP {
+	HBIN_BCLIP bclip;
+	double rate;
+	double start;
+	int32_t version;
+	int32_t nsmp; /* samples per track */
+	int32_t ntrk;
+	int32_t smpSize; /* 4: float, 8: double */
+	int32_t hostOrder; /* samples are in host byte order, see bclipNormalize */
+	HBIN_CLIP_TRACK* pTracks; /* [ntrk], NULL if opened without tracks */
+} HBIN_CLIP;
+
 typedef struct _HBIN_CAPTURE {
 	int32_t node;
 	float wght;
 } HBIN_CAPTURE;
 
+typedef struct _HBIN_SKIN_BATCH {
+	int32_t triOrg; /* first triangle in the batch index list */
+	int32_t triCount;
+	int32_t vtxOrg; /* first entry in the batch point list */
+	int32_t vtxCount;
+	int32_t palOrg; /* first entry in the palette node list */
+	int32_t palCount;
+} HBIN_SKIN_BATCH;
+
+typedef struct _HBIN_MESH_CHUNK {
+	int32_t triOrg;
+	int32_t triCount;
+	int32_t vtxOrg;
+	int32_t vtxCount;
+} HBIN_MESH_CHUNK;
+
+typedef struct _HBIN_VCACHE_STATS {
+	float acmr; /* misses per triangle */
+	float atvr; /* misses per referenced vertex */
+	int32_t misses;
+} HBIN_VCACHE_STATS;
+
+typedef struct _HBIN_MESHLET {
+	int32_t vtxOrg;
+	int32_t vtxCount;
+	int32_t triOrg;
+	int32_t triCount;
+} HBIN_MESHLET;
+
+typedef struct _HBIN_MESHLET_BOUNDS {
+	float center[3];
+	float radius;
+	float coneApex[3];
+	float coneAxis[3];
+	float coneCutoff; /* backfacing when dot(normalize(coneApex - eye), coneAxis) >= coneCutoff; front faces are clockwise (Houdini) */
+} HBIN_MESHLET_BOUNDS;
+
+typedef struct _HBIN_MTL_RANGE {
+	int32_t mtlId; /* -1: no material */
+	int32_t idxOrg;
+	int32_t idxCount;
+} HBIN_MTL_RANGE;
+
+typedef struct _HBIN_SUBMESH {
+	int32_t mtlId;
+	int32_t triOrg;
+	int32_t triCount;
+	int32_t vtxOrg;
+	int32_t vtxCount;
+	float bboxMin[3];
+	float bboxMax[3];
+} HBIN_SUBMESH;
+
+typedef struct _HBIN_TRI_CLEANUP {
+	int32_t degenerate; /* repeated vertex or area <= minArea */
+	int32_t duplicate; /* same vertices in the same winding as an earlier triangle */
+} HBIN_TRI_CLEANUP;
+
 HBIN_IFC(HBIN_STRING, NameFromPath)(HBIN_STRING path);
 HBIN_IFC(int, StringsEqual)(HBIN_STRING str1, HBIN_STRING str2);
 HBIN_IFC(int, StringsEqualC)(HBIN_STRING str, const char* pCStr);
 HBIN_IFC(HBIN_STRING, StringAtIdx)(const void* pMem, const int32_t idx);
 HBIN_IFC(void, PrintString)(HBIN_STRING str);
 
+/* pWk: int32_t[nvtx * 2]; maxChunkVtx <= 0 selects 0xFFFF (0xFFFF itself is kept free for primitive restart) */
+HBIN_IFC(int32_t, SplitIndices16)(
+	const uint32_t* pTriIdx, const int32_t ntris, const int32_t nvtx, const int32_t maxChunkVtx,
+	HBIN_MESH_CHUNK* pChunks, uint16_t* pChunkIdx /* [ntris*3] */, int32_t* pChunkVtx,
+	int32_t* pWk
+);
+
+/* pWk: int32_t[nvtx] */
+HBIN_IFC(HBIN_VCACHE_STATS, VertexCacheStats)(
+	const uint32_t* pTriIdx, const int32_t ntris, const int32_t nvtx, const int32_t cacheSize,
+	int32_t* pWk
+);
+/* pTriOrder: [ntris] new -> old; pClusters: [ntris+1] or NULL; pWk: int32_t[hbinVertexCacheWorkSize()]; returns the number of clusters */
+HBIN_IFC(int32_t, VertexCacheWorkSize)(const int32_t ntris, const int32_t nvtx);
+HBIN_IFC(int32_t, OptimizeVertexCache)(
+	int32_t* pTriOrder, int32_t* pClusters,
+	const uint32_t* pTriIdx, const int32_t ntris, const int32_t nvtx, const int32_t cacheSize,
+	int32_t* pWk
+);
+/* reorders clusters of pTriOrder; pWk: int32_t[hbinOverdrawWorkSize()]; pTriOrder is left unchanged if an index is out of range */
+HBIN_IFC(int32_t, OverdrawWorkSize)(const int32_t ntris, const int32_t nvtx);
+HBIN_IFC(void, OptimizeOverdraw)(
+	int32_t* pTriOrder, const int32_t* pClusters, const int32_t nclusters,
+	const uint32_t* pTriIdx, const int32_t ntris,
+	const HBIN_FLOAT3* pPos, const int32_t nvtx,
+	const int32_t cacheSize, const float threshold,
+	int32_t* pWk
+);
+/* pMeshletVtx: [ntris*3] max, pMeshletTris: [ntris*3] meshlet-local; maxVtx <= 256; pWk: int32_t[nvtx * 2] */
+HBIN_IFC(int32_t, BuildMeshlets)(
+	HBIN_MESHLET* pMeshlets, uint32_t* pMeshletVtx, uint8_t* pMeshletTris,
+	const uint32_t* pTriIdx, const int32_t ntris, const int32_t nvtx,
+	const int32_t maxVtx, const int32_t maxTris,
+	int32_t* pWk
+);
+HBIN_IFC(HBIN_MESHLET_BOUNDS, MeshletBounds)(
+	const HBIN_MESHLET* pMeshlet, const uint32_t* pMeshletVtx, const uint8_t* pMeshletTris,
+	const HBIN_FLOAT3* pPos, const int32_t nvtx
+);
+HBIN_IFC(int32_t, SimplifyWorkSize)(const int32_t ntris, const int32_t nvtx);
+/* pDstIdx: [ntris*3], may be pSrcIdx; mtl ids, pVtxLock may be NULL; targetError and *pError are relative to the mesh extent; returns the number of triangles left, or -1 without writing pDstIdx if an index is not below nvtx */
+HBIN_IFC(int32_t, Simplify)(
+	uint32_t* pDstIdx, int32_t* pDstMtlIds,
+	const uint32_t* pSrcIdx, const int32_t* pSrcMtlIds, const int32_t ntris,
+	const HBIN_FLOAT3* pPos, const int32_t nvtx, const uint8_t* pVtxLock,
+	const int32_t targetTris, const float targetError, float* pError,
+	int32_t* pWk
+);
+/* stable counting sort, pDstIdx != pSrcIdx; pRanges: [nmtl + 1], pWk: int32_t[nmtl + 1] */
+HBIN_IFC(void, SortTrianglesByMaterial)(
+	uint32_t* pDstIdx, int32_t* pDstMtlIds, HBIN_MTL_RANGE* pRanges,
+	const uint32_t* pSrcIdx, const int32_t* pSrcMtlIds, const int32_t ntris, const int32_t nmtl,
+	int32_t* pWk
+);
+/* one submesh per run of equal material ids (see SortTrianglesByMaterial); pSubIdx: [ntris*3] submesh-local, pSubPnts: [ntris*3] max;
+   submesh vertex buffers: bgeoGatherVertexBuffer(bgeo, pSubPnts + vtxOrg, vtxCount, ...); pPos may be NULL; pWk: int32_t[nvtx * 2] */
+HBIN_IFC(int32_t, SplitSubmeshes)(
+	const uint32_t* pTriIdx, const int32_t* pMtlIds, const int32_t ntris,
+	const HBIN_FLOAT3* pPos, const int32_t nvtx,
+	HBIN_SUBMESH* pSubmeshes, uint32_t* pSubIdx, int32_t* pSubPnts,
+	int32_t* pWk
+);
+/* lossless codecs; encoders return the number of bytes written (-1: pDst too small), decoders the number of bytes read (-1: bad data); bounds are 0 when the size doesn't fit in int32_t */
+HBIN_IFC(int32_t, EncodeIndexBound)(const int32_t nidx);
+HBIN_IFC(int32_t, EncodeIndices)(uint8_t* pDst, const int32_t dstSize, const uint32_t* pIdx, const int32_t nidx);
+HBIN_IFC(int32_t, DecodeIndices)(uint32_t* pIdx, const int32_t nidx, const uint8_t* pSrc, const int32_t srcSize);
+/* pVtx: ncomp 32-bit values per vertex */
+HBIN_IFC(int32_t, EncodeVertexBound)(const int32_t nvtx, const int32_t ncomp);
+HBIN_IFC(int32_t, EncodeVertices)(uint8_t* pDst, const int32_t dstSize, const void* pVtx, const int32_t nvtx, const int32_t ncomp);
+HBIN_IFC(int32_t, DecodeVertices)(void* pVtx, const int32_t nvtx, const int32_t ncomp, const uint8_t* pSrc, const int32_t srcSize);
+/* MikkTSpace-style angle-weighted tangents per triangle corner: corners of a vertex share a tangent only if their uv orientation matches,
+   so mirrored uv splits; index welded vertices (bgeoGetWeldedTriangles) to split at uv seams too;
+   pTangents: float[ntris * 3 * 4], w is the bitangent sign: B = cross(N, T) * w; pWk: float[nvtx * 12] */
+HBIN_IFC(void, ComputeTangents)(
+	float* pTangents,
+	const uint32_t* pTriIdx, const int32_t ntris,
+	const HBIN_FLOAT3* pPos, const HBIN_FLOAT3* pNrm, const HBIN_FLOAT2* pUV, const int32_t nvtx,
+	float* pWk
+);
+/* pRemap: [nvtx] old -> new in order of first use, -1 for unreferenced vertices; returns the number of used vertices */
+HBIN_IFC(int32_t, VertexFetchRemap)(int32_t* pRemap, const uint32_t* pIdx, const int32_t nidx, const int32_t nvtx);
+/* pRemap: [nvtx]; indices not below nvtx become (uint32_t)-1, as do unreferenced vertices */
+HBIN_IFC(void, RemapIndices)(uint32_t* pIdx, const int32_t nidx, const int32_t* pRemap, const int32_t nvtx);
+HBIN_IFC(void, ReorderTriangles)(uint32_t* pDstIdx, const uint32_t* pSrcIdx, const int32_t* pTriOrder, const int32_t ntris);
+/* half-edges over CSR polygons (see bgeoGetPolygonsCSR): half-edge h starts at corner h and runs to the next corner of its polygon;
+   pTwin: [ncorners] half-edge on the other side of the edge, -1 on boundaries, h itself if both ends are the same point;
+   edges shared by more than two half-edges link them in a cycle; pHEPol: [ncorners] polygon of each half-edge;
+   pWk: int32_t[hbinHalfEdgesWorkSize()]; returns the number of edges, -1 if a point index is out of range */
+HBIN_IFC(int32_t, HalfEdgesWorkSize)(const int32_t ncorners, const int32_t npnt);
+HBIN_IFC(int32_t, BuildHalfEdges)(
+	int32_t* pTwin, int32_t* pHEPol,
+	const int32_t* pPolOrg, const int32_t* pPolPnts, const int32_t npol, const int32_t npnt,
+	int32_t* pWk
+);
+HBIN_IFC(int32_t, HalfEdgeNext)(const int32_t* pPolOrg, const int32_t* pHEPol, const int32_t he);
+HBIN_IFC(int32_t, HalfEdgePrev)(const int32_t* pPolOrg, const int32_t* pHEPol, const int32_t he);
+/* points sharing an edge: neighbors of p are pNbrs[pNbrOrg[p] .. pNbrOrg[p + 1]); pNbrOrg: [npnt + 1], pNbrs: [edges * 2] or NULL; returns the number of entries */
+HBIN_IFC(int32_t, PointNeighbors)(
+	int32_t* pNbrOrg, int32_t* pNbrs,
+	const int32_t* pPolOrg, const int32_t* pPolPnts, const int32_t* pTwin, const int32_t* pHEPol,
+	const int32_t npol, const int32_t npnt
+);
+/* chains of boundary half-edges, closed unless the boundary is non-manifold; pLoopOrg: [boundary half-edges + 1] max, pLoopHEs: [boundary half-edges], either may be NULL;
+   pWk: int32_t[npnt + 1 + ncorners]; returns the number of loops */
+HBIN_IFC(int32_t, BoundaryLoops)(
+	int32_t* pLoopOrg, int32_t* pLoopHEs,
+	const int32_t* pPolOrg, const int32_t* pPolPnts, const int32_t* pTwin, const int32_t* pHEPol,
+	const int32_t npol, const int32_t npnt,
+	int32_t* pWk
+);
+/* polygons connected through shared edges; pPolComp: [npol] component ids in order of first polygon, pWk: int32_t[npol]; returns the number of components */
+HBIN_IFC(int32_t, ConnectedComponents)(
+	int32_t* pPolComp,
+	const int32_t* pPolOrg, const int32_t* pTwin, const int32_t* pHEPol, const int32_t npol,
+	int32_t* pWk
+);
+/* pRemap: [nvtx] vertex -> earlier vertex within tol whose attribute bytes are identical (itself if none), found through a hashed grid of tol-sized cells;
+   tol <= 0 merges exact positions only; pAttrs: attrSize bytes every attrStride bytes, or NULL; pWk: int32_t[hbinWeldPositionsWorkSize()]; returns the number of merged vertices */
+HBIN_IFC(int32_t, WeldPositionsWorkSize)(const int32_t nvtx);
+HBIN_IFC(int32_t, WeldPositions)(
+	int32_t* pRemap,
+	const HBIN_FLOAT3* pPos, const int32_t nvtx, const float tol,
+	const void* pAttrs, const int32_t attrStride, const int32_t attrSize,
+	int32_t* pWk
+);
+/* in place: indices go through pRemap (may be NULL), then degenerate and duplicate triangles are dropped; pPos may be NULL (no area test), pMtlIds, pStats may be NULL;
+   pWk: int32_t[hbinCleanTrianglesWorkSize()]; returns the number of triangles kept */
+HBIN_IFC(int32_t, CleanTrianglesWorkSize)(const int32_t ntris);
+HBIN_IFC(int32_t, CleanTriangles)(
+	uint32_t* pIdx, int32_t* pMtlIds, const int32_t ntris,
+	const int32_t* pRemap, const HBIN_FLOAT3* pPos, const float minArea,
+	HBIN_TRI_CLEANUP* pStats,
+	int32_t* pWk
+);
+
 HBIN_BGEO_IFC(int, Valid)(const HBIN_BGEO bgeo);
+/* validates every section of a size-byte buffer once: descriptors, records, point indices, groups, detail record;
+   returns pMem as a handle that the accessors can read without further checks, HBIN_NONE if anything would read past the end;
+   an attribute of unknown type is accepted, and like the accessors the check stops there */
+HBIN_BGEO_IFC(HBIN_BGEO, Open)(const void* pMem, const size_t size);
+/* bgeoOpen, then converts the attribute values of a writable buffer (point, vertex, primitive and detail records)
+   to host byte order in place (signature becomes "Bgeov"); indices, group records and descriptors stay as stored;
+   accessors detect this, bgeoPointRecords hands out the point records directly, and HBIN_ATTR_DATA::hostOrder is set */
+HBIN_BGEO_IFC(int, Normalize)(HBIN_BGEO bgeo, const size_t size);
+HBIN_BGEO_IFC(int, IsNormalized)(const HBIN_BGEO bgeo);
+/* normalized buffers only, NULL otherwise; position xyzw at offset 0 */
+HBIN_BGEO_IFC(const void*, PointRecords)(const HBIN_BGEO bgeo, int32_t* pStride);
+/* byte offset of an attribute value within a point record, -1 if there is no such attribute */
+HBIN_BGEO_IFC(int32_t, PointAttrOffset)(const HBIN_BGEO bgeo, const char* pAttrName);
 HBIN_BGEO_IFC(int32_t, Version)(const HBIN_BGEO bgeo);
+/* counts are int32_t throughout: bgeoOpen refuses headers with 2^31 or more points or primitives,
+   and the polygon triangle/corner totals below return -1 past that limit;
+   record offsets are computed in size_t, so blocks that end past 4GB are still addressed */
 HBIN_BGEO_IFC(int32_t, NumPoints)(const HBIN_BGEO bgeo);
 HBIN_BGEO_IFC(int32_t, NumPrims)(const HBIN_BGEO bgeo);
 HBIN_BGEO_IFC(int32_t, NumPointGroups)(const HBIN_BGEO bgeo);
@@ -63,6 +313,8 @@ HBIN_BGEO_IFC(int32_t, NumVertexAttrs)(const HBIN_BGEO bgeo);
 HBIN_BGEO_IFC(int32_t, NumPrimAttrs)(const HBIN_BGEO bgeo);
 HBIN_BGEO_IFC(int32_t, NumDetailAttrs)(const HBIN_BGEO bgeo);
 HBIN_BGEO_IFC(void, PointPos)(HBIN_FLOAT3 pos, const HBIN_BGEO bgeo, const int32_t pntId);
+HBIN_BGEO_IFC(int32_t, GetPointPositions)(const HBIN_BGEO bgeo, HBIN_FLOAT3* pPos);
+HBIN_BGEO_IFC(int32_t, FindPointAttr)(const HBIN_BGEO bgeo, const char* pAttrName);
 HBIN_BGEO_IFC(void, PointNrm)(HBIN_FLOAT3 nrm, const HBIN_BGEO bgeo, const int32_t pntId);
 HBIN_BGEO_IFC(void, PointRGB)(HBIN_FLOAT3 rgb, const HBIN_BGEO bgeo, const int32_t pntId);
 HBIN_BGEO_IFC(void, PointUVW)(HBIN_FLOAT3 uvw, const HBIN_BGEO bgeo, const int32_t pntId);
@@ -75,18 +327,58 @@ HBIN_BGEO_IFC(int32_t, FindPointByCStrAttr)(const HBIN_BGEO bgeo, const char* pA
 HBIN_BGEO_IFC(HBIN_STRING, PointAttrName)(const HBIN_BGEO bgeo, const int32_t attrId);
 HBIN_BGEO_IFC(int, PointAttrIsVec)(const HBIN_BGEO bgeo, const int32_t attrId);
 HBIN_BGEO_IFC(int, PointAttrIsStr)(const HBIN_BGEO bgeo, const int32_t attrId);
+/* point normals from polygon topology; pNrm: [bgeoNumPoints()], weighting: HBIN_NRM_WEIGHT_* */
+HBIN_BGEO_IFC(int32_t, ComputePointNormals)(const HBIN_BGEO bgeo, HBIN_FLOAT3* pNrm, const int32_t weighting);
 HBIN_BGEO_IFC(int32_t, CountTriangles)(const HBIN_BGEO bgeo);
 HBIN_BGEO_IFC(int32_t, CountPolygons)(const HBIN_BGEO bgeo);
 HBIN_BGEO_IFC(void, ForEachPrim)(const HBIN_BGEO bgeo, HBIN_PRIM_CB callback, void* pUserData);
+HBIN_BGEO_IFC(int32_t, PrimId)(const HBIN_PRIM prim);
+/* groups: bit i of pBits[i / 32] is set for members, see HBIN_BIT_TEST; *InGroup functions take NULL for all primitives */
+HBIN_BGEO_IFC(HBIN_STRING, PointGroupName)(const HBIN_BGEO bgeo, const int32_t grpId);
+HBIN_BGEO_IFC(HBIN_STRING, PrimGroupName)(const HBIN_BGEO bgeo, const int32_t grpId);
+HBIN_BGEO_IFC(int32_t, FindPointGroup)(const HBIN_BGEO bgeo, const char* pGrpName);
+HBIN_BGEO_IFC(int32_t, FindPrimGroup)(const HBIN_BGEO bgeo, const char* pGrpName);
+/* pBits: uint32_t[(bgeoNumPoints() + 31) / 32]; returns the number of members */
+HBIN_BGEO_IFC(int32_t, GetPointGroupBits)(const HBIN_BGEO bgeo, const int32_t grpId, uint32_t* pBits);
+/* pBits: uint32_t[(bgeoNumPrims() + 31) / 32]; returns the number of members */
+HBIN_BGEO_IFC(int32_t, GetPrimGroupBits)(const HBIN_BGEO bgeo, const int32_t grpId, uint32_t* pBits);
+/* ordered groups: members in selection order, pIdx: int32_t[number of members] or NULL; returns the count, 0 for unordered groups */
+HBIN_BGEO_IFC(int32_t, GetPointGroupOrder)(const HBIN_BGEO bgeo, const int32_t grpId, int32_t* pIdx);
+HBIN_BGEO_IFC(int32_t, GetPrimGroupOrder)(const HBIN_BGEO bgeo, const int32_t grpId, int32_t* pIdx);
+HBIN_BGEO_IFC(void, ForEachPrimInGroup)(const HBIN_BGEO bgeo, const uint32_t* pPrimBits, HBIN_PRIM_CB callback, void* pUserData);
+HBIN_BGEO_IFC(int32_t, CountTrianglesInGroup)(const HBIN_BGEO bgeo, const uint32_t* pPrimBits);
+HBIN_BGEO_IFC(int32_t, CountPolygonsInGroup)(const HBIN_BGEO bgeo, const uint32_t* pPrimBits);
 HBIN_BGEO_IFC(const HBIN_BGEO, PrimBgeo)(const HBIN_PRIM prim);
 HBIN_BGEO_IFC(int32_t, PrimIsPoly)(const HBIN_PRIM prim);
 HBIN_BGEO_IFC(int32_t, PrimIsSphere)(const HBIN_PRIM prim);
 HBIN_BGEO_IFC(int32_t, PrimNumVertices)(const HBIN_PRIM prim);
 HBIN_BGEO_IFC(int32_t, PrimVertexPntId)(const HBIN_PRIM prim, const int32_t vtxId);
 HBIN_BGEO_IFC(int32_t, PrimMaterialId)(const HBIN_PRIM prim);
+HBIN_BGEO_IFC(HBIN_STRING, VertexAttrName)(const HBIN_BGEO bgeo, const int32_t attrId);
+HBIN_BGEO_IFC(int32_t, FindVertexAttr)(const HBIN_BGEO bgeo, const char* pAttrName);
+HBIN_BGEO_IFC(int, VertexAttrIsVec)(const HBIN_BGEO bgeo, const int32_t attrId);
+HBIN_BGEO_IFC(void, PrimVertexVecAttr)(HBIN_FLOAT3 vec, const HBIN_PRIM prim, const char* pAttrName, const int32_t vtxId);
 HBIN_BGEO_IFC(int32_t, NumMaterials)(const HBIN_BGEO bgeo);
 HBIN_BGEO_IFC(HBIN_STRING, MaterialPath)(const HBIN_BGEO bgeo, const int32_t mtlId);
+HBIN_BGEO_IFC(HBIN_STRING, PrimAttrName)(const HBIN_BGEO bgeo, const int32_t attrId);
+HBIN_BGEO_IFC(int32_t, FindPrimAttr)(const HBIN_BGEO bgeo, const char* pAttrName);
+/* HBIN_ATTRTYPE_*, -1 if there is no such attribute */
+HBIN_BGEO_IFC(int32_t, PrimAttrType)(const HBIN_BGEO bgeo, const int32_t attrId);
+/* values per primitive */
+HBIN_BGEO_IFC(int32_t, PrimAttrSize)(const HBIN_BGEO bgeo, const int32_t attrId);
+HBIN_BGEO_IFC(int32_t, PrimAttrNumStrs)(const HBIN_BGEO bgeo, const int32_t attrId);
+HBIN_BGEO_IFC(HBIN_STRING, PrimAttrStr)(const HBIN_BGEO bgeo, const int32_t attrId, const int32_t strId);
+/* columnar: pVals[bgeoNumPrims()][bgeoPrimAttrSize()], converted to the requested type (float to int truncates and saturates, NaN reads as 0);
+   returns the number of primitives read, primitives without an attribute record read as 0 */
+HBIN_BGEO_IFC(int32_t, GetPrimAttrFloats)(const HBIN_BGEO bgeo, const int32_t attrId, float* pVals);
+HBIN_BGEO_IFC(int32_t, GetPrimAttrInts)(const HBIN_BGEO bgeo, const int32_t attrId, int32_t* pVals);
 HBIN_BGEO_IFC(HBIN_STRING, DetailStrAttr)(const HBIN_BGEO bgeo, const char* pAttrName);
+/* "P" selects point positions (4 floats at offset 0); return 0 if there is no such attribute */
+HBIN_BGEO_IFC(int, PointAttrData)(const HBIN_BGEO bgeo, const char* pAttrName, HBIN_ATTR_DATA* pData);
+HBIN_BGEO_IFC(int, PrimAttrData)(const HBIN_BGEO bgeo, const char* pAttrName, HBIN_ATTR_DATA* pData);
+HBIN_BGEO_IFC(int, DetailAttrData)(const HBIN_BGEO bgeo, const char* pAttrName, HBIN_ATTR_DATA* pData);
+/* start of the primitive's attribute record, values at HBIN_ATTR_DATA::offs */
+HBIN_BGEO_IFC(const uint8_t*, PrimAttrRecord)(const HBIN_PRIM prim);
 HBIN_BGEO_IFC(int32_t, NumCaptureNodes)(const HBIN_BGEO bgeo);
 HBIN_BGEO_IFC(HBIN_STRING, CaptureNodePath)(const HBIN_BGEO bgeo, const int32_t nodeId);
 HBIN_BGEO_IFC(int32_t, MaxCapturesPerPoint)(const HBIN_BGEO bgeo);
@@ -103,9 +395,93 @@ HBIN_BGEO_IFC(void, MakeVertexBuffer)(
 	const int32_t wgtOffs, const int32_t idxOffs,
 	const int32_t maxWghts, int32_t* pInflCounts
 );
+/* pNrm: [bgeoNumPoints()] normals to use instead of the N attribute, or NULL */
+HBIN_BGEO_IFC(void, MakeVertexBufferNrm)(
+	const HBIN_BGEO bgeo,
+	void* pMem, const int32_t stride,
+	const int32_t posOffs, const int32_t nrmOffs,
+	const int32_t rgbOffs, const int32_t texOffs,
+	const int32_t wgtOffs, const int32_t idxOffs,
+	const int32_t maxWghts, int32_t* pInflCounts,
+	const HBIN_FLOAT3* pNrm
+);
+/* vertex i is made from point pPntIds[i]; pNrm as in bgeoMakeVertexBufferNrm */
+HBIN_BGEO_IFC(void, GatherVertexBuffer)(
+	const HBIN_BGEO bgeo,
+	const int32_t* pPntIds, const int32_t nvtx,
+	void* pMem, const int32_t stride,
+	const int32_t posOffs, const int32_t nrmOffs,
+	const int32_t rgbOffs, const int32_t texOffs,
+	const int32_t wgtOffs, const int32_t idxOffs,
+	const int32_t maxWghts, const HBIN_FLOAT3* pNrm
+);
+/* returns -1 without writing anything if pIdx16 is given but point indices don't fit in 16 bits, see bgeoTriangleIndexSize */
 HBIN_BGEO_IFC(int32_t, GetTriangles)(
 	const HBIN_BGEO bgeo, uint16_t* pIdx16, uint32_t* pIdx32, int32_t* pMtlIds
 );
+HBIN_BGEO_IFC(int32_t, GetTrianglesInGroup)(
+	const HBIN_BGEO bgeo, const uint32_t* pPrimBits, uint16_t* pIdx16, uint32_t* pIdx32, int32_t* pMtlIds
+);
+/* grouped by material (stable); pRanges: [bgeoNumMaterials() + 1], pWk: int32_t[bgeoNumMaterials() + 1]; pIdx16 as in bgeoGetTriangles */
+HBIN_BGEO_IFC(int32_t, GetTrianglesByMaterial)(
+	const HBIN_BGEO bgeo, uint16_t* pIdx16, uint32_t* pIdx32, int32_t* pMtlIds,
+	HBIN_MTL_RANGE* pRanges, int32_t* pWk
+);
+/* all polygons: convex ones as fans, concave ones by ear clipping; pIdx16 as in bgeoGetTriangles;
+   pWk: int32_t[bgeoPolyTrianglesWorkSize()], may be NULL only if that is 0, else -1 is returned without writing anything */
+HBIN_BGEO_IFC(int32_t, PolyTrianglesWorkSize)(const HBIN_BGEO bgeo);
+/* -1 if 3 * the triangle count would not fit in int32_t */
+HBIN_BGEO_IFC(int32_t, CountPolyTriangles)(const HBIN_BGEO bgeo);
+HBIN_BGEO_IFC(int32_t, GetPolyTriangles)(
+	const HBIN_BGEO bgeo, uint16_t* pIdx16, uint32_t* pIdx32, int32_t* pMtlIds, int32_t* pWk
+);
+HBIN_BGEO_IFC(int32_t, CountPolyTrianglesInGroup)(const HBIN_BGEO bgeo, const uint32_t* pPrimBits);
+HBIN_BGEO_IFC(int32_t, GetPolyTrianglesInGroup)(
+	const HBIN_BGEO bgeo, const uint32_t* pPrimBits, uint16_t* pIdx16, uint32_t* pIdx32, int32_t* pMtlIds, int32_t* pWk
+);
+HBIN_BGEO_IFC(int32_t, TriangleIndexSize)(const HBIN_BGEO bgeo);
+/* polygon vertices (corners) in primitive order; -1 if the total does not fit in int32_t */
+HBIN_BGEO_IFC(int32_t, CountPolyVertices)(const HBIN_BGEO bgeo);
+HBIN_BGEO_IFC(int32_t, CountPolyVerticesInGroup)(const HBIN_BGEO bgeo, const uint32_t* pPrimBits);
+/* polygon topology in CSR form: polygon i uses pPolPnts[pPolOrg[i] .. pPolOrg[i + 1]);
+   pPolOrg: [bgeoCountPolygons() + 1], pPolPnts: [bgeoCountPolyVertices()], pMtlIds: [bgeoCountPolygons()]; any may be NULL; returns the number of polygons */
+HBIN_BGEO_IFC(int32_t, GetPolygonsCSR)(const HBIN_BGEO bgeo, int32_t* pPolOrg, int32_t* pPolPnts, int32_t* pMtlIds);
+HBIN_BGEO_IFC(int32_t, GetPolygonsCSRInGroup)(const HBIN_BGEO bgeo, const uint32_t* pPrimBits, int32_t* pPolOrg, int32_t* pPolPnts, int32_t* pMtlIds);
+/* unique GPU vertices keyed on (point, vertex attribute values); pCornerVtx: [bgeoCountPolyVertices()] corner -> GPU vertex, pVtxPnts: [bgeoCountPolyVertices()] GPU vertex -> point, pWk: int32_t[bgeoWeldWorkSize()]; returns the number of GPU vertices */
+HBIN_BGEO_IFC(int32_t, WeldWorkSize)(const HBIN_BGEO bgeo);
+HBIN_BGEO_IFC(int32_t, WeldVertices)(const HBIN_BGEO bgeo, int32_t* pCornerVtx, int32_t* pVtxPnts, int32_t* pWk);
+/* bgeoGetPolyTriangles indexing GPU vertices from bgeoWeldVertices; pWk as in bgeoGetPolyTriangles */
+HBIN_BGEO_IFC(int32_t, GetWeldedTriangles)(const HBIN_BGEO bgeo, const int32_t* pCornerVtx, uint32_t* pIdx, int32_t* pMtlIds, int32_t* pWk);
+/* point attributes with vertex N, Cd and uv taking precedence; pNrm: [bgeoNumPoints()] or NULL */
+HBIN_BGEO_IFC(void, MakeWeldedVertexBuffer)(
+	const HBIN_BGEO bgeo, const int32_t* pCornerVtx,
+	void* pMem, const int32_t stride,
+	const int32_t posOffs, const int32_t nrmOffs,
+	const int32_t rgbOffs, const int32_t texOffs,
+	const int32_t wgtOffs, const int32_t idxOffs,
+	const int32_t maxWghts, const HBIN_FLOAT3* pNrm
+);
+HBIN_BGEO_IFC(int32_t, GetTriangleIndices)(const HBIN_BGEO bgeo, void* pIdx /* uint16_t or uint32_t */, int32_t* pMtlIds);
+
+/* pBatchCapts: int32_t[nvtx * maxWghts] or NULL, palette-local node per batch vertex capture, -1 for unused slots */
+/* pWk: int32_t[bgeoSkinBatchesWorkSize()]; returns the number of batches, -1 if a triangle doesn't fit into maxPalSize */
+HBIN_BGEO_IFC(int32_t, SkinBatchesWorkSize)(const HBIN_BGEO bgeo);
+HBIN_BGEO_IFC(int32_t, SkinBatches)(
+	const HBIN_BGEO bgeo, const uint32_t* pTriIdx, const int32_t ntris,
+	const int32_t maxPalSize, const int32_t maxWghts,
+	HBIN_SKIN_BATCH* pBatches, uint32_t* pBatchIdx, int32_t* pBatchPnts, int32_t* pPalNodes,
+	int32_t* pBatchCapts, int32_t* pWk
+);
+/* node indices are local to the batch palette; pNrm as in bgeoMakeVertexBufferNrm */
+HBIN_BGEO_IFC(void, MakeSkinBatchVertexBuffer)(
+	const HBIN_BGEO bgeo, const HBIN_SKIN_BATCH* pBatch,
+	const int32_t* pBatchPnts, const int32_t* pPalNodes,
+	void* pMem, const int32_t stride,
+	const int32_t posOffs, const int32_t nrmOffs,
+	const int32_t rgbOffs, const int32_t texOffs,
+	const int32_t wgtOffs, const int32_t idxOffs,
+	const int32_t maxWghts, const HBIN_FLOAT3* pNrm
+);
 
 
 HBIN_BCLIP_IFC(int, Valid)(const HBIN_BCLIP bclip);
@@ -115,6 +491,19 @@ HBIN_BCLIP_IFC(double, StartIndex)(const HBIN_BCLIP bclip);
 HBIN_BCLIP_IFC(int32_t, TrackLength)(const HBIN_BCLIP bclip);
 HBIN_BCLIP_IFC(int32_t, NumTracks)(const HBIN_BCLIP bclip);
 HBIN_BCLIP_IFC(void, AllTracks)(const HBIN_BCLIP bclip, float* pSmps /* [numTracks][trackLen] */, HBIN_STRING* pNames /* [numTracks] */);
+/* converts track samples of a writable buffer to host byte order in place (signature becomes "bclP"), checking packets against size */
+HBIN_BCLIP_IFC(int, Normalize)(HBIN_BCLIP bclip, const size_t size);
+HBIN_BCLIP_IFC(int, IsNormalized)(const HBIN_BCLIP bclip);
+/* 4: float, 8: double */
+HBIN_BCLIP_IFC(int32_t, SampleSize)(const HBIN_BCLIP bclip);
+/* parses the packets once, checked against size; pTracks: [bclipNumTracks()] name and sample pointers, or NULL to read the header only;
+   returns 0 if the clip is invalid or truncated */
+HBIN_BCLIP_IFC(int, Open)(HBIN_CLIP* pClip, const HBIN_BCLIP bclip, const size_t size, HBIN_CLIP_TRACK* pTracks);
+/* pSmps: [pClip->nsmp]; returns 0 if the track is out of range or the clip was opened without tracks */
+HBIN_BCLIP_IFC(int, ReadTrack)(const HBIN_CLIP* pClip, const int32_t trkId, float* pSmps);
+/* the track's samples in place: [pClip->nsmp] values of pClip->smpSize bytes;
+   NULL unless the clip was normalized before bclipOpen and opened with tracks */
+HBIN_BCLIP_IFC(const void*, TrackSamples)(const HBIN_CLIP* pClip, const int32_t trkId);
 
 #ifdef __cplusplus
 }
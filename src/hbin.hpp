@@ -0,0 +1,211 @@
+/* SPDX-License-Identifier: MIT */
+/* SPDX-FileCopyrightText: 2020 Sergey Chaban <sergey.chaban@gmail.com> */
+
+/*
+	typed views over bgeo attribute records, header-only on top of hbin.h:
+	values are decoded on access, BgeoAttrView<float, 3> nrm = bgeo_point_attr<float, 3>(bgeo, "N");
+	for (BgeoVec<float, 3> n : nrm) { ... }
+	T is the stored type, float or int32_t: a view doesn't bind to attributes stored as the other one
+*/
+
+#ifndef HBIN_HPP
+#define HBIN_HPP
+
+#include "hbin.h"
+
+#include <string.h>
+#include <iterator>
+#include <vector>
+
+template<typename T, int N> struct BgeoVec {
+	T v[N];
+
+	T& operator[](int i) { return v[i]; }
+	const T& operator[](int i) const { return v[i]; }
+};
+
+template<typename T> struct BgeoAttrStore;
+
+template<> struct BgeoAttrStore<float> {
+	static bool match(const int32_t type) { return type == HBIN_ATTRTYPE_FLOAT || type == HBIN_ATTRTYPE_VECTOR; }
+};
+
+template<> struct BgeoAttrStore<int32_t> {
+	static bool match(const int32_t type) { return type == HBIN_ATTRTYPE_INT; }
+};
+
+/* swapMask: all ones to swap big-endian file values, 0 for values already in host order */
+inline uint32_t bgeo_attr_swap_mask(const bool hostOrder) {
+	const uint32_t one = 1;
+	uint8_t lo;
+	::memcpy(&lo, &one, 1);
+	return hostOrder || lo == 0 ? 0U : ~0U;
+}
+
+template<typename T> inline T bgeo_attr_val(const uint8_t* pVal, const uint32_t swapMask) {
+	uint32_t u;
+	::memcpy(&u, pVal, sizeof(uint32_t));
+	uint32_t s = (u >> 24) | ((u >> 8) & 0xFF00U) | ((u << 8) & 0xFF0000U) | (u << 24);
+	u ^= (u ^ s) & swapMask;
+	T val;
+	::memcpy(&val, &u, sizeof(T));
+	return val;
+}
+
+template<typename T, int N> inline BgeoVec<T, N> bgeo_attr_vec(const uint8_t* pVal, const uint32_t swapMask) {
+	BgeoVec<T, N> vec;
+	for (int i = 0; i < N; ++i) {
+		vec.v[i] = bgeo_attr_val<T>(pVal + (i * 4), swapMask);
+	}
+	return vec;
+}
+
+/* items are decoded into values, so there is no reference to hand out: an input iterator that also does index arithmetic */
+template<typename VIEW> struct BgeoViewIterator {
+	typedef std::input_iterator_tag iterator_category;
+	typedef typename VIEW::value_type value_type;
+	typedef ptrdiff_t difference_type;
+	typedef void pointer;
+	typedef value_type reference;
+
+	const VIEW* pView;
+	ptrdiff_t idx;
+
+	value_type operator*() const { return (*pView)[size_t(idx)]; }
+	value_type operator[](ptrdiff_t n) const { return (*pView)[size_t(idx + n)]; }
+	BgeoViewIterator& operator++() { ++idx; return *this; }
+	BgeoViewIterator operator++(int) { BgeoViewIterator it = *this; ++idx; return it; }
+	BgeoViewIterator& operator--() { --idx; return *this; }
+	BgeoViewIterator operator--(int) { BgeoViewIterator it = *this; --idx; return it; }
+	BgeoViewIterator& operator+=(ptrdiff_t n) { idx += n; return *this; }
+	BgeoViewIterator& operator-=(ptrdiff_t n) { idx -= n; return *this; }
+	BgeoViewIterator operator+(ptrdiff_t n) const { BgeoViewIterator it = *this; it.idx += n; return it; }
+	BgeoViewIterator operator-(ptrdiff_t n) const { BgeoViewIterator it = *this; it.idx -= n; return it; }
+	ptrdiff_t operator-(const BgeoViewIterator& it) const { return idx - it.idx; }
+	bool operator==(const BgeoViewIterator& it) const { return idx == it.idx; }
+	bool operator!=(const BgeoViewIterator& it) const { return idx != it.idx; }
+	bool operator<(const BgeoViewIterator& it) const { return idx < it.idx; }
+	bool operator>(const BgeoViewIterator& it) const { return idx > it.idx; }
+	bool operator<=(const BgeoViewIterator& it) const { return idx <= it.idx; }
+	bool operator>=(const BgeoViewIterator& it) const { return idx >= it.idx; }
+
+	static BgeoViewIterator at(const VIEW* pView, const ptrdiff_t idx) {
+		BgeoViewIterator it;
+		it.pView = pView;
+		it.idx = idx;
+		return it;
+	}
+};
+
+/* records at a fixed stride: point attributes, or a detail array viewed as count/N items */
+template<typename T, int N> struct BgeoAttrView {
+	typedef BgeoVec<T, N> value_type;
+	typedef BgeoViewIterator<BgeoAttrView> iterator;
+
+	const uint8_t* pData; /* first value */
+	size_t stride;
+	size_t count;
+	uint32_t swapMask;
+
+	void reset() {
+		pData = nullptr;
+		stride = 0;
+		count = 0;
+		swapMask = 0;
+	}
+
+	void init(const HBIN_ATTR_DATA& data, const int32_t item = 0) {
+		reset();
+		if (!data.pRecs || data.size < N || !BgeoAttrStore<T>::match(data.type)) return;
+		pData = data.pRecs + data.offs + (item * 4);
+		swapMask = bgeo_attr_swap_mask(data.hostOrder != 0);
+		if (data.stride > 0) {
+			stride = size_t(data.stride);
+			count = size_t(data.count);
+		} else {
+			/* detail: one record, split into N-value items */
+			stride = N * 4;
+			count = size_t((data.size - item) / N);
+		}
+	}
+
+	bool valid() const { return pData != nullptr; }
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+
+	value_type operator[](size_t i) const { return bgeo_attr_vec<T, N>(pData + (i * stride), swapMask); }
+	T get(size_t i, int j) const { return bgeo_attr_val<T>(pData + (i * stride) + (j * 4), swapMask); }
+
+	iterator begin() const { return iterator::at(this, 0); }
+	iterator end() const { return iterator::at(this, ptrdiff_t(count)); }
+};
+
+/* primitive records vary in size, so the view keeps one attribute record pointer per primitive */
+template<typename T, int N> struct BgeoPrimAttrView {
+	typedef BgeoVec<T, N> value_type;
+	typedef BgeoViewIterator<BgeoPrimAttrView> iterator;
+
+	std::vector<const uint8_t*> recs;
+	int32_t offs;
+	uint32_t swapMask;
+	bool bound;
+
+	static int add_rec_cb(const HBIN_PRIM prim, void* pMem) {
+		BgeoPrimAttrView* pView = (BgeoPrimAttrView*)pMem;
+		pView->recs.push_back(bgeoPrimAttrRecord(prim));
+		return 1;
+	}
+
+	bool init(const HBIN_BGEO bgeo, const char* pAttrName) {
+		HBIN_ATTR_DATA data;
+		recs.clear();
+		offs = 0;
+		swapMask = 0;
+		bound = false;
+		if (!bgeoPrimAttrData(bgeo, pAttrName, &data) || data.size < N || !BgeoAttrStore<T>::match(data.type)) return false;
+		offs = data.offs;
+		swapMask = bgeo_attr_swap_mask(data.hostOrder != 0);
+		bound = true;
+		recs.reserve(size_t(data.count));
+		bgeoForEachPrim(bgeo, add_rec_cb, this);
+		return true;
+	}
+
+	bool valid() const { return bound; }
+	size_t size() const { return recs.size(); }
+	bool empty() const { return recs.empty(); }
+
+	value_type operator[](size_t i) const { return bgeo_attr_vec<T, N>(recs[i] + offs, swapMask); }
+
+	iterator begin() const { return iterator::at(this, 0); }
+	iterator end() const { return iterator::at(this, ptrdiff_t(recs.size())); }
+};
+
+template<typename T, int N> inline BgeoAttrView<T, N> bgeo_point_attr(const HBIN_BGEO bgeo, const char* pAttrName) {
+	BgeoAttrView<T, N> view;
+	HBIN_ATTR_DATA data;
+	view.reset();
+	if (bgeoPointAttrData(bgeo, pAttrName, &data)) {
+		view.init(data);
+	}
+	return view;
+}
+
+/* e.g. bgeo_detail_attr<float, 16>(bgeo, "xforms") views a flat float array as 4x4 matrices */
+template<typename T, int N> inline BgeoAttrView<T, N> bgeo_detail_attr(const HBIN_BGEO bgeo, const char* pAttrName) {
+	BgeoAttrView<T, N> view;
+	HBIN_ATTR_DATA data;
+	view.reset();
+	if (bgeoDetailAttrData(bgeo, pAttrName, &data)) {
+		view.init(data);
+	}
+	return view;
+}
+
+template<typename T, int N> inline BgeoPrimAttrView<T, N> bgeo_prim_attr(const HBIN_BGEO bgeo, const char* pAttrName) {
+	BgeoPrimAttrView<T, N> view;
+	view.init(bgeo, pAttrName);
+	return view;
+}
+
+#endif
@@ -81,6 +81,16 @@ int main(int argc, char* argv[]) {
 
 	if (nxApp::get_args_count() < 1) {
 		nxCore::dbg_msg("nbin2json <path>\n");
+	} else if (nxApp::get_bool_opt("info", false)) {
+		int npaths = nxApp::get_args_count();
+		const char** ppPaths = (const char**)nxCore::mem_alloc(npaths * sizeof(const char*), "info:paths");
+		if (ppPaths) {
+			for (int i = 0; i < npaths; ++i) {
+				ppPaths[i] = nxApp::get_arg(i);
+			}
+			info_scan(ppPaths, npaths);
+			nxCore::mem_free(ppPaths);
+		}
 	} else {
 		const char* pSrcPath = nxApp::get_arg(0);
 		if (nxCore::str_ends_with(pSrcPath, ".bhclassic") || nxCore::str_ends_with(pSrcPath, ".bgeo")) {
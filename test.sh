@@ -0,0 +1,104 @@
+#!/bin/sh
+
+# builds and runs the checks in test/:
+#   bgeo_4g   - >4GB bgeo round trip, writes a ~4.8GB sparse file to tmp/ (SKIP_4G=1 to skip)
+#   fuzz_bgeo - bgeo reader under ASan/UBSan; libFuzzer if the compiler has it, file replay otherwise
+# ./test.sh [seed .bgeo files or directories]
+# FUZZ_RUNS: libFuzzer runs, or mutated copies per seed file in replay mode (default 2000)
+
+SYS_NAME="`uname -s`"
+
+PROG_DIR=prog
+SRC_DIR=src
+TEST_DIR=test
+TMP_DIR=tmp
+
+if [ "$SYS_NAME" = "FreeBSD" ]; then
+	NO_FMT=""
+fi
+
+FMT_BOLD=${NO_FMT-"\e[1m"}
+FMT_B_RED=${NO_FMT-"\e[91m"}
+FMT_B_GREEN=${NO_FMT-"\e[92m"}
+FMT_B_MAGENTA=${NO_FMT-"\e[95m"}
+FMT_OFF=${NO_FMT-"\e[0m"}
+
+if [ ! -d $PROG_DIR ]; then
+	mkdir -p $PROG_DIR
+fi
+if [ ! -d $TMP_DIR ]; then
+	mkdir -p $TMP_DIR
+fi
+
+DEF_CXX="g++"
+case $SYS_NAME in
+	OpenBSD|FreeBSD)
+		DEF_CXX="clang++"
+	;;
+esac
+CXX=${CXX:-$DEF_CXX}
+FUZZ_RUNS=${FUZZ_RUNS:-2000}
+
+NFAIL=0
+
+report() {
+	if [ $1 -eq 0 ]; then
+		printf "$FMT_B_GREEN""-> $2: OK""$FMT_OFF\n"
+	else
+		printf "$FMT_B_RED""-> $2: FAILED""$FMT_OFF\n"
+		NFAIL=$(($NFAIL + 1))
+	fi
+}
+
+if [ "${SKIP_4G:-0}" = "0" ]; then
+	printf "Compiling \"$FMT_BOLD$FMT_B_MAGENTA$PROG_DIR/bgeo_4g$FMT_OFF\" with $FMT_BOLD$CXX$FMT_OFF.\n"
+	$CXX -std=c++11 -O2 -I $SRC_DIR $TEST_DIR/bgeo_4g.cpp $SRC_DIR/hbin.cpp -o $PROG_DIR/bgeo_4g
+	RES=$?
+	if [ $RES -eq 0 ]; then
+		$PROG_DIR/bgeo_4g $TMP_DIR/bgeo_4g.bgeo
+		RES=$?
+	fi
+	report $RES bgeo_4g
+fi
+
+SEEDS=""
+for arg in "$@"; do
+	if [ -d "$arg" ]; then
+		SEEDS="$SEEDS `find "$arg" -type f -name '*.bgeo'`"
+	else
+		SEEDS="$SEEDS $arg"
+	fi
+done
+
+SAN_FLAGS="-fsanitize=address,undefined -fno-sanitize-recover=undefined"
+FUZZ_PROG=$PROG_DIR/fuzz_bgeo
+FUZZ_SRCS="$TEST_DIR/fuzz_bgeo.cpp $SRC_DIR/hbin.cpp"
+printf "Compiling \"$FMT_BOLD$FMT_B_MAGENTA$FUZZ_PROG$FMT_OFF\" with $FMT_BOLD$CXX$FMT_OFF.\n"
+rm -f $FUZZ_PROG
+if $CXX -std=c++11 -g -O1 -fsanitize=fuzzer,address,undefined -fno-sanitize-recover=undefined -I $SRC_DIR $FUZZ_SRCS -o $FUZZ_PROG 2>/dev/null; then
+	if [ -z "$SEEDS" ]; then
+		printf "$FMT_B_RED""   no seed files, fuzzing from scratch""$FMT_OFF\n"
+	fi
+	FUZZ_CORPUS=$TMP_DIR/fuzz_corpus
+	mkdir -p $FUZZ_CORPUS
+	for seed in $SEEDS; do
+		cp "$seed" $FUZZ_CORPUS/
+	done
+	ASAN_OPTIONS=detect_leaks=0 $FUZZ_PROG -runs=$FUZZ_RUNS $FUZZ_CORPUS
+	report $? fuzz_bgeo
+else
+	$CXX -std=c++11 -g -O1 $SAN_FLAGS -DFUZZ_BGEO_REPLAY -I $SRC_DIR $FUZZ_SRCS -o $FUZZ_PROG
+	RES=$?
+	if [ $RES -eq 0 ]; then
+		if [ -z "$SEEDS" ]; then
+			printf "$FMT_B_RED""   no seed files, the replay driver needs at least one .bgeo""$FMT_OFF\n"
+			RES=1
+		else
+			ASAN_OPTIONS=detect_leaks=0 $FUZZ_PROG $FUZZ_RUNS $SEEDS
+			RES=$?
+		fi
+	fi
+	report $RES "fuzz_bgeo (replay)"
+fi
+
+exit $NFAIL
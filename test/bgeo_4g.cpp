@@ -0,0 +1,251 @@
+/*
+	>4GB bgeo check: writes a sparse classic bgeo whose point block ends past
+	the 4GB offset, maps it and reads the tail points, vertex attributes and
+	polygons back through the size_t offset paths (point records, the weld record
+	offsets, triangle index output).
+
+	g++ -std=c++11 -O2 -I src test/bgeo_4g.cpp src/hbin.cpp -o bgeo_4g
+	./bgeo_4g [path]    (default path: bgeo_4g.bgeo, removed on success)
+	test.sh builds and runs it along with the fuzz target.
+
+	Needs a 64-bit POSIX system and a filesystem with sparse file support.
+*/
+
+#include "hbin.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* 16-byte P records only: 300M points put the block end at ~4.8GB */
+static const int64_t c_npts = 300000000;
+static const int c_ntail = 5;
+
+/* tail points A..E, polygons ABC and ACDE; A shares a non-zero uv (the hole reads as zeros), C gets a different one */
+static const float c_pos[c_ntail][3] = {
+	{ 0.0f, 0.0f, 0.0f },
+	{ 1.0f, 0.0f, 0.0f },
+	{ 1.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ -1.0f, 0.5f, 0.0f }
+};
+static const int c_tri[3] = { 0, 1, 2 };
+static const float c_triUV[3][3] = { { 0.25f, 0.75f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 0.0f } };
+static const int c_quad[4] = { 0, 2, 3, 4 };
+static const float c_quadUV[4][3] = { { 0.25f, 0.75f, 0.0f }, { 2.0f, 2.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { -1.0f, 0.5f, 0.0f } };
+/* corners: 3 + 4, GPU vertices: A, B, C, C', D, E */
+static const int c_ncorners = 7;
+static const int c_nvtx = 6;
+
+static int s_nfail = 0;
+
+static void check(bool cond, const char* pWhat) {
+	if (!cond) {
+		::printf("FAIL: %s\n", pWhat);
+		++s_nfail;
+	}
+}
+
+struct BeWriter {
+	FILE* pFile;
+
+	void bytes(const void* pSrc, size_t n) { ::fwrite(pSrc, 1, n, pFile); }
+
+	void u8(uint32_t val) {
+		uint8_t b = (uint8_t)val;
+		bytes(&b, 1);
+	}
+
+	void u16(uint32_t val) {
+		u8(val >> 8);
+		u8(val);
+	}
+
+	void u32(uint32_t val) {
+		u16(val >> 16);
+		u16(val);
+	}
+
+	void f32(float val) {
+		uint32_t bits;
+		::memcpy(&bits, &val, sizeof(bits));
+		u32(bits);
+	}
+
+	void str(const char* pStr) {
+		size_t len = ::strlen(pStr);
+		u16((uint32_t)len);
+		bytes(pStr, len);
+	}
+
+	void poly(const int* pPnts, const float (*pUV)[3], int nvtx) {
+		u32(1); /* polygon */
+		u32(nvtx);
+		u8(1); /* closed */
+		for (int i = 0; i < nvtx; ++i) {
+			/* npts > 0xFFFF: 32-bit point ids */
+			u32((uint32_t)(c_npts - c_ntail + pPnts[i]));
+			for (int j = 0; j < 3; ++j) {
+				f32(pUV[i][j]);
+			}
+		}
+	}
+};
+
+static bool write_bgeo(const char* pPath) {
+	BeWriter w;
+	w.pFile = ::fopen(pPath, "wb");
+	if (!w.pFile) return false;
+	w.bytes("BgeoV", 5);
+	w.u32(5); /* version */
+	w.u32((uint32_t)c_npts);
+	w.u32(2); /* nprims */
+	w.u32(0); /* point groups */
+	w.u32(0); /* prim groups */
+	w.u32(0); /* point attrs */
+	w.u32(1); /* vertex attrs */
+	w.u32(0); /* prim attrs */
+	w.u32(0); /* detail attrs */
+	/* leave all but the tail points as a hole */
+	off_t tailOffs = (off_t)(5 + 9 * 4) + (off_t)(c_npts - c_ntail) * 16;
+	::fflush(w.pFile);
+	if (::fseeko(w.pFile, tailOffs, SEEK_SET) != 0) {
+		::fclose(w.pFile);
+		return false;
+	}
+	for (int i = 0; i < c_ntail; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			w.f32(c_pos[i][j]);
+		}
+		w.f32(1.0f);
+	}
+	w.str("uv");
+	w.u16(3);
+	w.u32(0); /* float */
+	for (int j = 0; j < 3; ++j) {
+		w.f32(0.0f);
+	}
+	w.poly(c_tri, c_triUV, 3);
+	w.poly(c_quad, c_quadUV, 4);
+	bool res = ::ferror(w.pFile) == 0;
+	res &= ::fclose(w.pFile) == 0;
+	return res;
+}
+
+static bool pnt_eq(const float* pPos, int tailId) {
+	for (int j = 0; j < 3; ++j) {
+		if (pPos[j] != c_pos[tailId][j]) return false;
+	}
+	return true;
+}
+
+static int tail_id(uint32_t pntId) {
+	return pntId >= (uint32_t)(c_npts - c_ntail) && pntId < (uint32_t)c_npts ? int(pntId - (uint32_t)(c_npts - c_ntail)) : -1;
+}
+
+static void check_bgeo(HBIN_BGEO bgeo, size_t size) {
+	check(size > 0x100000000ULL, "file size past 4GB");
+	check(bgeoNumPoints(bgeo) == c_npts, "bgeoNumPoints");
+	check(bgeoNumPrims(bgeo) == 2, "bgeoNumPrims");
+
+	HBIN_FLOAT3 pos;
+	for (int i = 0; i < c_ntail; ++i) {
+		bgeoPointPos(pos, bgeo, (int32_t)(c_npts - c_ntail + i));
+		check(pnt_eq(pos, i), "bgeoPointPos tail point");
+	}
+	bgeoPointPos(pos, bgeo, 0);
+	check(pos[0] == 0.0f && pos[1] == 0.0f && pos[2] == 0.0f, "bgeoPointPos first point");
+
+	/* triangle index math: every index lands on a tail point */
+	int ntri = bgeoCountPolyTriangles(bgeo);
+	check(ntri == 3, "bgeoCountPolyTriangles");
+	uint32_t idx[3 * 3];
+	int32_t mtlIds[3];
+	/* ear clipping lists for the quad */
+	int32_t earWk[4 * 3];
+	check(bgeoPolyTrianglesWorkSize(bgeo) == 4 * 3, "bgeoPolyTrianglesWorkSize");
+	if (ntri == 3) {
+		check(bgeoGetPolyTriangles(bgeo, nullptr, idx, mtlIds, earWk) == 3, "bgeoGetPolyTriangles");
+		uint16_t idx16[3 * 3];
+		check(bgeoGetPolyTriangles(bgeo, idx16, nullptr, nullptr, earWk) == -1, "bgeoGetPolyTriangles 16-bit refusal");
+		for (int i = 0; i < 3; ++i) {
+			check(idx[i] == (uint32_t)(c_npts - c_ntail + c_tri[i]), "triangle indices");
+		}
+		for (int i = 3; i < 9; ++i) {
+			int tid = tail_id(idx[i]);
+			check(tid == 0 || tid == 2 || tid == 3 || tid == 4, "quad triangle indices");
+		}
+	}
+
+	/* weld: the vertex records sit past 4GB, matching corners are compared through the stored lo/hi offsets */
+	check(bgeoCountPolyVertices(bgeo) == c_ncorners, "bgeoCountPolyVertices");
+	int wkSize = bgeoWeldWorkSize(bgeo);
+	int32_t* pWk = (int32_t*)::malloc((size_t)(wkSize > 0 ? wkSize : 1) * sizeof(int32_t));
+	int32_t cornerVtx[c_ncorners];
+	int32_t vtxPnts[c_ncorners];
+	int nvtx = pWk ? bgeoWeldVertices(bgeo, cornerVtx, vtxPnts, pWk) : 0;
+	::free(pWk);
+	check(nvtx == c_nvtx, "bgeoWeldVertices count");
+	if (nvtx == c_nvtx) {
+		static const int32_t expCorners[c_ncorners] = { 0, 1, 2, 0, 3, 4, 5 };
+		static const int expPnts[c_nvtx] = { 0, 1, 2, 2, 3, 4 };
+		check(::memcmp(cornerVtx, expCorners, sizeof(expCorners)) == 0, "weld corner -> vertex");
+		for (int i = 0; i < c_nvtx; ++i) {
+			check(tail_id((uint32_t)vtxPnts[i]) == expPnts[i], "weld vertex -> point");
+		}
+		uint32_t wldIdx[3 * 3];
+		check(bgeoGetWeldedTriangles(bgeo, cornerVtx, wldIdx, mtlIds, earWk) == 3, "bgeoGetWeldedTriangles");
+		for (int i = 0; i < 9; ++i) {
+			check(wldIdx[i] < (uint32_t)c_nvtx, "welded triangle indices");
+		}
+		/* pos + uv per GPU vertex */
+		float vb[c_nvtx][5];
+		static const float expUV[c_nvtx][2] = { { 0.25f, 0.75f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 2.0f, 2.0f }, { 0.0f, 1.0f }, { -1.0f, 0.5f } };
+		::memset(vb, 0, sizeof(vb));
+		bgeoMakeWeldedVertexBuffer(bgeo, cornerVtx, vb, sizeof(vb[0]), 0, -1, -1, 3 * sizeof(float), -1, -1, 0, nullptr);
+		for (int i = 0; i < c_nvtx; ++i) {
+			check(pnt_eq(vb[i], expPnts[i]), "welded vertex position");
+			check(vb[i][3] == expUV[i][0] && vb[i][4] == 1.0f - expUV[i][1], "welded vertex uv");
+		}
+	}
+}
+
+int main(int argc, char* argv[]) {
+	const char* pPath = argc > 1 ? argv[1] : "bgeo_4g.bgeo";
+	if (!write_bgeo(pPath)) {
+		::printf("FAIL: can't write %s\n", pPath);
+		return 1;
+	}
+	int fd = ::open(pPath, O_RDONLY);
+	struct stat st;
+	void* pMem = MAP_FAILED;
+	if (fd >= 0 && ::fstat(fd, &st) == 0) {
+		pMem = ::mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	if (pMem == MAP_FAILED) {
+		::printf("FAIL: can't map %s\n", pPath);
+		if (fd >= 0) {
+			::close(fd);
+		}
+		return 1;
+	}
+	size_t size = (size_t)st.st_size;
+	HBIN_BGEO bgeo = bgeoOpen(pMem, size);
+	check(bgeo != HBIN_NONE, "bgeoOpen");
+	if (bgeo != HBIN_NONE) {
+		check_bgeo(bgeo, size);
+	}
+	::munmap(pMem, size);
+	::close(fd);
+	if (s_nfail == 0) {
+		::unlink(pPath);
+		::printf("OK\n");
+	}
+	return s_nfail == 0 ? 0 : 1;
+}
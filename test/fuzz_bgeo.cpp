@@ -0,0 +1,297 @@
+/*
+	libFuzzer target for the bgeo reader: every input goes through bgeoOpen,
+	and whatever it accepts is read back through the accessors, which do no
+	bounds checks of their own.
+
+	clang++ -g -O1 -fsanitize=fuzzer,address,undefined -I src test/fuzz_bgeo.cpp src/hbin.cpp -o fuzz_bgeo
+	./fuzz_bgeo corpus/    (seed corpus: any .bgeo files)
+
+	Without libFuzzer, -DFUZZ_BGEO_REPLAY adds a main that replays files:
+	g++ -g -O1 -fsanitize=address,undefined -DFUZZ_BGEO_REPLAY -I src test/fuzz_bgeo.cpp src/hbin.cpp -o fuzz_bgeo
+	./fuzz_bgeo nmut file.bgeo...
+
+	test.sh builds whichever of the two the compiler supports and runs it.
+*/
+
+#include "hbin.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static volatile uint32_t s_sink;
+
+static void sink_str(const HBIN_STRING& str) {
+	for (size_t i = 0; str.pChars && i < str.len; ++i) {
+		s_sink += (uint8_t)str.pChars[i];
+	}
+}
+
+static void sink_vec(const float* pVec, int n) {
+	for (int i = 0; i < n; ++i) {
+		uint32_t bits;
+		::memcpy(&bits, &pVec[i], sizeof(bits));
+		s_sink += bits;
+	}
+}
+
+/* touches the first and last value the descriptor claims */
+static void sink_attr_data(const HBIN_ATTR_DATA& data) {
+	if (data.pRecs && data.count > 0 && data.size > 0) {
+		const uint8_t* pLast = data.pRecs + ((size_t)(data.count - 1) * (size_t)data.stride) + data.offs + ((data.size - 1) * 4);
+		s_sink += data.pRecs[data.offs] + pLast[3];
+	}
+}
+
+static void* alloc_ary(int64_t n, size_t elemSize) {
+	return ::calloc(n > 0 ? (size_t)n : 1, elemSize);
+}
+
+static int prim_cb(const HBIN_PRIM prim, void* pUserData) {
+	(void)pUserData;
+	HBIN_FLOAT3 vec;
+	int32_t nvtx = bgeoPrimNumVertices(prim);
+	s_sink += bgeoPrimId(prim) + bgeoPrimMaterialId(prim) + bgeoPrimIsPoly(prim) + bgeoPrimIsSphere(prim);
+	for (int32_t i = 0; i < nvtx; ++i) {
+		s_sink += bgeoPrimVertexPntId(prim, i);
+		bgeoPrimVertexVecAttr(vec, prim, "uv", i);
+		sink_vec(vec, 3);
+		bgeoPrimVertexVecAttr(vec, prim, "N", i);
+		sink_vec(vec, 3);
+	}
+	/* the record is empty without primitive attributes */
+	const uint8_t* pRec = bgeoPrimAttrRecord(prim);
+	if (pRec && bgeoNumPrimAttrs(bgeoPrimBgeo(prim)) > 0) {
+		s_sink += pRec[0];
+	}
+	return 1;
+}
+
+static void read_points(HBIN_BGEO bgeo) {
+	int32_t npts = bgeoNumPoints(bgeo);
+	int32_t nattr = bgeoNumPointAttrs(bgeo);
+	HBIN_FLOAT3 vec;
+	HBIN_FLOAT2 uv;
+	HBIN_FLOAT3* pPos = (HBIN_FLOAT3*)alloc_ary(npts, sizeof(HBIN_FLOAT3));
+	if (pPos) {
+		bgeoGetPointPositions(bgeo, pPos);
+		bgeoComputePointNormals(bgeo, pPos, HBIN_NRM_WEIGHT_ANGLE);
+		::free(pPos);
+	}
+	for (int32_t i = 0; i < npts; i += npts > 64 ? npts / 64 : 1) {
+		bgeoPointPos(vec, bgeo, i);
+		sink_vec(vec, 3);
+		bgeoPointNrm(vec, bgeo, i);
+		sink_vec(vec, 3);
+		bgeoPointRGB(vec, bgeo, i);
+		sink_vec(vec, 3);
+		bgeoPointUV(uv, bgeo, i);
+		sink_vec(uv, 2);
+		for (int32_t j = 0; j < nattr; ++j) {
+			HBIN_STRING name = bgeoPointAttrName(bgeo, j);
+			if (name.pChars && name.len > 0 && name.len < 64) {
+				char nameBuf[64];
+				::memcpy(nameBuf, name.pChars, name.len);
+				nameBuf[name.len] = 0;
+				if (bgeoPointAttrIsStr(bgeo, j)) {
+					sink_str(bgeoPointStrAttr(bgeo, nameBuf, i));
+				} else if (bgeoPointAttrIsVec(bgeo, j)) {
+					bgeoPointVecAttr(vec, bgeo, nameBuf, i);
+					sink_vec(vec, 3);
+				}
+			}
+		}
+		int32_t maxCapts = bgeoMaxCapturesPerPoint(bgeo);
+		for (int32_t j = 0; j < maxCapts; ++j) {
+			HBIN_CAPTURE capt = bgeoPointCapture(bgeo, i, j);
+			s_sink += capt.node;
+		}
+	}
+	if (npts > 0) {
+		bgeoPointPos(vec, bgeo, npts - 1);
+		sink_vec(vec, 3);
+	}
+	HBIN_ATTR_DATA data;
+	if (bgeoPointAttrData(bgeo, "P", &data)) {
+		sink_attr_data(data);
+	}
+	if (bgeoPointAttrData(bgeo, "Cd", &data)) {
+		sink_attr_data(data);
+	}
+}
+
+static void read_groups(HBIN_BGEO bgeo) {
+	int32_t npts = bgeoNumPoints(bgeo);
+	int32_t nprims = bgeoNumPrims(bgeo);
+	uint32_t* pBits = (uint32_t*)alloc_ary(((npts > nprims ? npts : nprims) + 31) / 32, sizeof(uint32_t));
+	int32_t* pOrder = (int32_t*)alloc_ary(npts > nprims ? npts : nprims, sizeof(int32_t));
+	if (pBits && pOrder) {
+		for (int32_t i = 0; i < bgeoNumPointGroups(bgeo); ++i) {
+			sink_str(bgeoPointGroupName(bgeo, i));
+			s_sink += bgeoGetPointGroupBits(bgeo, i, pBits);
+			s_sink += bgeoGetPointGroupOrder(bgeo, i, pOrder);
+		}
+		for (int32_t i = 0; i < bgeoNumPrimGroups(bgeo); ++i) {
+			sink_str(bgeoPrimGroupName(bgeo, i));
+			s_sink += bgeoGetPrimGroupBits(bgeo, i, pBits);
+			s_sink += bgeoGetPrimGroupOrder(bgeo, i, pOrder);
+			s_sink += bgeoCountPolygonsInGroup(bgeo, pBits);
+		}
+	}
+	::free(pOrder);
+	::free(pBits);
+}
+
+static void read_prims(HBIN_BGEO bgeo) {
+	int32_t nprims = bgeoNumPrims(bgeo);
+	bgeoForEachPrim(bgeo, prim_cb, nullptr);
+	for (int32_t i = 0; i < bgeoNumVertexAttrs(bgeo); ++i) {
+		sink_str(bgeoVertexAttrName(bgeo, i));
+		s_sink += bgeoVertexAttrIsVec(bgeo, i);
+	}
+	for (int32_t i = 0; i < bgeoNumMaterials(bgeo); ++i) {
+		sink_str(bgeoMaterialPath(bgeo, i));
+	}
+	for (int32_t i = 0; i < bgeoNumPrimAttrs(bgeo); ++i) {
+		int32_t size = bgeoPrimAttrSize(bgeo, i);
+		sink_str(bgeoPrimAttrName(bgeo, i));
+		s_sink += bgeoPrimAttrType(bgeo, i);
+		for (int32_t j = 0; j < bgeoPrimAttrNumStrs(bgeo, i); ++j) {
+			sink_str(bgeoPrimAttrStr(bgeo, i, j));
+		}
+		if (size > 0 && size < 0x100) {
+			float* pVals = (float*)alloc_ary((int64_t)nprims * size, sizeof(float));
+			if (pVals) {
+				s_sink += bgeoGetPrimAttrFloats(bgeo, i, pVals);
+				s_sink += bgeoGetPrimAttrInts(bgeo, i, (int32_t*)pVals);
+				::free(pVals);
+			}
+		}
+	}
+}
+
+static void read_topology(HBIN_BGEO bgeo) {
+	int32_t ntri = bgeoCountPolyTriangles(bgeo);
+	int32_t npol = bgeoCountPolygons(bgeo);
+	int32_t ncorners = bgeoCountPolyVertices(bgeo);
+	uint32_t* pIdx = (uint32_t*)alloc_ary((int64_t)ntri * 3, sizeof(uint32_t));
+	int32_t* pMtlIds = (int32_t*)alloc_ary(ntri > npol ? ntri : npol, sizeof(int32_t));
+	int32_t* pPolOrg = (int32_t*)alloc_ary((int64_t)npol + 1, sizeof(int32_t));
+	int32_t* pPolPnts = (int32_t*)alloc_ary(ncorners, sizeof(int32_t));
+	int32_t* pCornerVtx = (int32_t*)alloc_ary(ncorners, sizeof(int32_t));
+	int32_t* pVtxPnts = (int32_t*)alloc_ary(ncorners, sizeof(int32_t));
+	int32_t* pWk = (int32_t*)alloc_ary(bgeoWeldWorkSize(bgeo), sizeof(int32_t));
+	int32_t* pEarWk = (int32_t*)alloc_ary(bgeoPolyTrianglesWorkSize(bgeo), sizeof(int32_t));
+	if (pIdx && pMtlIds && pPolOrg && pPolPnts && pCornerVtx && pVtxPnts && pWk && pEarWk) {
+		s_sink += bgeoGetPolyTriangles(bgeo, nullptr, pIdx, pMtlIds, pEarWk);
+		s_sink += bgeoGetPolygonsCSR(bgeo, pPolOrg, pPolPnts, pMtlIds);
+		int32_t nvtx = bgeoWeldVertices(bgeo, pCornerVtx, pVtxPnts, pWk);
+		if (nvtx > 0) {
+			s_sink += bgeoGetWeldedTriangles(bgeo, pCornerVtx, pIdx, pMtlIds, pEarWk);
+			float* pVB = (float*)alloc_ary((int64_t)nvtx * 11, sizeof(float));
+			if (pVB) {
+				bgeoMakeWeldedVertexBuffer(bgeo, pCornerVtx, pVB, 11 * sizeof(float), 0, 3 * sizeof(float), 6 * sizeof(float), 9 * sizeof(float), -1, -1, 0, nullptr);
+				sink_vec(pVB, nvtx * 11);
+				::free(pVB);
+			}
+		}
+	}
+	::free(pEarWk);
+	::free(pWk);
+	::free(pVtxPnts);
+	::free(pCornerVtx);
+	::free(pPolPnts);
+	::free(pPolOrg);
+	::free(pMtlIds);
+	::free(pIdx);
+}
+
+static void read_detail(HBIN_BGEO bgeo) {
+	int32_t ncapt = bgeoNumCaptureNodes(bgeo);
+	for (int32_t i = 0; i < ncapt; ++i) {
+		sink_str(bgeoCaptureNodePath(bgeo, i));
+	}
+	sink_str(bgeoDetailStrAttr(bgeo, "varmap"));
+	HBIN_ATTR_DATA data;
+	if (bgeoDetailAttrData(bgeo, "pCaptData", &data)) {
+		sink_attr_data(data);
+	}
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* pData, size_t size) {
+	/* private copy: bgeoNormalize swaps attribute records in place */
+	uint8_t* pMem = (uint8_t*)::malloc(size > 0 ? size : 1);
+	if (!pMem) return 0;
+	::memcpy(pMem, pData, size);
+	HBIN_BGEO bgeo = bgeoOpen(pMem, size);
+	if (bgeo != HBIN_NONE) {
+		s_sink += bgeoVersion(bgeo) + bgeoNumDetailAttrs(bgeo);
+		read_points(bgeo);
+		read_groups(bgeo);
+		read_prims(bgeo);
+		read_topology(bgeo);
+		read_detail(bgeo);
+		if (bgeoNormalize(bgeo, size)) {
+			int32_t stride = 0;
+			const void* pRecs = bgeoPointRecords(bgeo, &stride);
+			if (pRecs && stride > 0) {
+				s_sink += ((const uint8_t*)pRecs)[((size_t)(bgeoNumPoints(bgeo) - 1) * (size_t)stride) + stride - 1];
+			}
+			read_points(bgeo);
+			read_prims(bgeo);
+			read_detail(bgeo);
+		}
+	}
+	::free(pMem);
+	return 0;
+}
+
+#ifdef FUZZ_BGEO_REPLAY
+/* each file goes in whole, cut at up to 400 lengths, and as nmut copies with 1..4 bytes overwritten;
+   the generator has a fixed seed, so a failing run repeats */
+static uint32_t s_rnd = 7;
+
+static uint32_t next_rnd() {
+	s_rnd = (s_rnd * 1664525U) + 1013904223U;
+	return s_rnd >> 8;
+}
+
+int main(int argc, char* argv[]) {
+	int nmut = argc > 1 ? ::atoi(argv[1]) : 0;
+	for (int i = 2; i < argc; ++i) {
+		FILE* pFile = ::fopen(argv[i], "rb");
+		if (!pFile) {
+			::fprintf(stderr, "can't open %s\n", argv[i]);
+			return 1;
+		}
+		::fseek(pFile, 0, SEEK_END);
+		long len = ::ftell(pFile);
+		::fseek(pFile, 0, SEEK_SET);
+		size_t size = len > 0 ? (size_t)len : 0;
+		uint8_t* pData = (uint8_t*)::malloc(size > 0 ? size : 1);
+		uint8_t* pMut = (uint8_t*)::malloc(size > 0 ? size : 1);
+		if (!pData || !pMut || ::fread(pData, 1, size, pFile) != size) {
+			::fprintf(stderr, "can't read %s\n", argv[i]);
+			return 1;
+		}
+		::fclose(pFile);
+		LLVMFuzzerTestOneInput(pData, size);
+		size_t step = size > 400 ? size / 400 : 1;
+		for (size_t cut = 0; cut < size; cut += step) {
+			LLVMFuzzerTestOneInput(pData, cut);
+		}
+		for (int j = 0; j < nmut && size > 0; ++j) {
+			::memcpy(pMut, pData, size);
+			int nbytes = 1 + (int)(next_rnd() % 4);
+			for (int k = 0; k < nbytes; ++k) {
+				pMut[next_rnd() % size] = (uint8_t)next_rnd();
+			}
+			LLVMFuzzerTestOneInput(pMut, size);
+		}
+		::free(pMut);
+		::free(pData);
+		::printf("%s: ok\n", argv[i]);
+	}
+	return 0;
+}
+#endif